@@ -0,0 +1,35 @@
+/**
+ * @file bench.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <chrono>
+
+namespace testing {
+namespace bench {
+
+/**
+ * @brief average cost of one body(i) call over i in [0, rounds), unit: ns
+ *
+ * @note inputs should be precomputed and results fed into a volatile sink so
+ *       only the measured call is timed and it's not optimized out
+ */
+template <typename F>
+double cost(int rounds, F&& body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    body(i);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         rounds;
+}
+
+}  // namespace bench
+}  // namespace testing
@@ -0,0 +1,43 @@
+/**
+ * @file bench_discrete_pid.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "bench/bench.h"
+#include "coriander/motorctl/discrete_pid.h"
+#include "coriander/motorctl/pid.h"
+
+namespace {
+using coriander::motorctl::DiscretePid;
+using coriander::motorctl::Pid;
+}  // namespace
+
+TEST(DiscretePidBench, call) {
+  constexpr int points = 1024;
+  const int rounds = 1'000'000;
+  const float Ts = 1e-4f;
+  float error[points];
+  volatile float sink = 0;
+  Pid pid{0.5f, 100.0f, 1e-4f, 200.0f, 2.0f};
+  DiscretePid discrete{0.5f, 100.0f, 1e-4f, 200.0f, 2.0f};
+
+  for (int i = 0; i < points; i++) {
+    error[i] = std::sin(i * 0.01f);
+  }
+
+  double pidCost = testing::bench::cost(
+      rounds, [&](int i) { sink = sink + pid(error[i % points], Ts); });
+  double discreteCost = testing::bench::cost(
+      rounds, [&](int i) { sink = sink + discrete(error[i % points], Ts); });
+  std::cout << "Pid: " << pidCost << " ns/call" << std::endl;
+  std::cout << "DiscretePid: " << discreteCost << " ns/call" << std::endl;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench_fixed_point.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "bench/bench.h"
+#include "coriander/base/fixed_point.h"
+#include "coriander/motorctl/foc.h"
+
+namespace {
+using coriander::base::FloatNumeric;
+using coriander::base::Q15Numeric;
+using coriander::base::Q31Numeric;
+namespace foc = coriander::motorctl::foc;
+
+constexpr float pi = 3.14159265358979f;
+
+/**
+ * @brief average cost of clarke -> park -> invPark -> svpwm, unit: ns
+ */
+template <typename N>
+static double pipeline_cost(int rounds) {
+  constexpr int points = 256;
+  using V = foc::Value<N>;
+  V ia[points], ib[points], ic[points], s[points], c[points];
+  volatile float sink = 0;
+
+  for (int i = 0; i < points; i++) {
+    float phase = i * 2 * pi / points;
+    ia[i] = V(0.8f * std::cos(phase));
+    ib[i] = V(0.8f * std::cos(phase - 2 * pi / 3));
+    ic[i] = V(0.8f * std::cos(phase + 2 * pi / 3));
+    s[i] = V(std::sin(phase * 3));
+    c[i] = V(std::cos(phase * 3));
+  }
+
+  return testing::bench::cost(rounds, [&](int i) {
+    int k = i % points;
+    V alpha, beta, d, q, u, v, w;
+    foc::clarke<N>(ia[k], ib[k], ic[k], &alpha, &beta);
+    foc::park<N>(alpha, beta, s[k], c[k], &d, &q);
+    foc::invPark<N>(d, q, s[k], c[k], &alpha, &beta);
+    foc::SpaceVectorPwm<N>(alpha, beta, &u, &v, &w);
+    sink = sink + static_cast<float>(u);
+  });
+}
+}  // namespace
+
+TEST(FixedPointBench, pipeline) {
+  const int rounds = 1'000'000;
+  double f = pipeline_cost<FloatNumeric>(rounds);
+  double q15 = pipeline_cost<Q15Numeric>(rounds);
+  double q31 = pipeline_cost<Q31Numeric>(rounds);
+  std::cout << "pipeline float: " << f << " ns/call" << std::endl;
+  std::cout << "pipeline q15: " << q15 << " ns/call" << std::endl;
+  std::cout << "pipeline q31: " << q31 << " ns/call" << std::endl;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file bench_foc.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "bench/bench.h"
+#include "coriander/motorctl/foc.h"
+
+namespace foc = coriander::motorctl::foc;
+
+namespace {
+using SvpwmFunc = void (*)(float, float, float, float, float*, float*,
+                           float*);
+
+/**
+ * @brief average cost of one svpwm call, unit: ns
+ */
+static double svpwm_cost(SvpwmFunc func, int rounds) {
+  constexpr int points = 1024;
+  float alpha[points], beta[points];
+  volatile float sink = 0;
+  float tu, tv, tw;
+
+  // precompute inputs, only measure svpwm itself
+  for (int i = 0; i < points; i++) {
+    float angle = i * 2 * 3.14159265358979f / points;
+    alpha[i] = 0.9f * std::cos(angle);
+    beta[i] = 0.9f * std::sin(angle);
+  }
+
+  return testing::bench::cost(rounds, [&](int i) {
+    func(alpha[i % points], beta[i % points], 1, 1, &tu, &tv, &tw);
+    sink = sink + tu + tv + tw;
+  });
+}
+}  // namespace
+
+TEST(FocBench, svpwm) {
+  const int rounds = 1'000'000;
+  double slow = svpwm_cost(foc::detail::svpwm_slow, rounds);
+  double fast = svpwm_cost(foc::detail::svpwm_fast, rounds);
+  std::cout << "svpwm_slow: " << slow << " ns/call" << std::endl;
+  std::cout << "svpwm_fast: " << fast << " ns/call" << std::endl;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file bench_foc_batch.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <iostream>
+
+#include "bench/bench.h"
+#include "coriander/motorctl/foc_batch.h"
+#include "tests/foc_batch_fixture.h"
+
+namespace {
+namespace batch = coriander::motorctl::foc::batch;
+using testing::foc_batch::BatchAxes;
+using testing::foc_batch::random_sample;
+using testing::foc_batch::Sample;
+using testing::foc_batch::ScalarAxes;
+}  // namespace
+
+TEST(FocBatchBench, axes) {
+  constexpr int points = 64;
+  const int rounds = 200'000;
+  const float Ts = 1e-4f;
+  static Sample samples[points];
+  volatile float sink = 0;
+
+  std::srand(3);
+  for (int i = 0; i < points; i++) {
+    random_sample(&samples[i]);
+  }
+
+  std::cout << "simd lanes: " << batch::lanes() << std::endl;
+  for (int n : {1, 2, 4, 8}) {
+    ScalarAxes scalar(n);
+    BatchAxes batched(n);
+
+    double scalarCost = testing::bench::cost(rounds, [&](int i) {
+      const Sample& s = samples[i % points];
+      scalar(s.alpha, s.beta, s.s, s.c, s.targetD, s.targetQ, Ts);
+      sink = sink + scalar.du[0];
+    });
+    double batchCost = testing::bench::cost(rounds, [&](int i) {
+      const Sample& s = samples[i % points];
+      batched(s.alpha, s.beta, s.s, s.c, s.targetD, s.targetQ, Ts);
+      sink = sink + batched.du[0];
+    });
+    std::cout << n << " axes, scalar: " << scalarCost
+              << " ns/tick, batch: " << batchCost << " ns/tick" << std::endl;
+  }
+}
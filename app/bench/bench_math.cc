@@ -0,0 +1,75 @@
+/**
+ * @file bench_math.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "bench/bench.h"
+#include "coriander/base/math.h"
+
+namespace {
+using coriander::base::math;
+
+/**
+ * @brief average cost of one func(x, y) call, unit: ns
+ */
+template <typename F>
+static double cost(F func, int rounds) {
+  constexpr int points = 1024;
+  float x[points], y[points];
+  volatile float sink = 0;
+
+  for (int i = 0; i < points; i++) {
+    x[i] = std::cos(i * 0.37f) * (1 + i % 7);
+    y[i] = std::sin(i * 0.37f) * (1 + i % 5);
+  }
+
+  return testing::bench::cost(rounds, [&](int i) {
+    sink = sink + func(x[i % points], y[i % points]);
+  });
+}
+}  // namespace
+
+TEST(MathBench, libm) {
+  const int rounds = 1'000'000;
+  struct Row {
+    const char* name;
+    double libm, fast;
+  } rows[] = {
+      {"atan2", cost([](float x, float y) { return std::atan2(y, x); }, rounds),
+       cost([](float x, float y) { return math::atan2f(y, x); }, rounds)},
+      {"1/sqrt",
+       cost([](float x, float y) { return 1.0f / std::sqrt(x * x + y); },
+            rounds),
+       cost([](float x, float y) { return math::rsqrtf(x * x + y); }, rounds)},
+      {"sincos",
+       cost(
+           [](float x, float) {
+             return std::sin(x * 0.1f) + std::cos(x * 0.1f);
+           },
+           rounds),
+       cost(
+           [](float x, float) {
+             float s, c;
+             math::sincosf(x * 0.1f, &s, &c);
+             return s + c;
+           },
+           rounds)},
+      {"wrap", cost([](float x, float) { return std::fmod(x * 100, 360.0f); },
+                    rounds),
+       cost([](float x, float) { return math::wrapd(x * 100); }, rounds)},
+  };
+
+  std::cout << "function  libm(ns)  base::math(ns)" << std::endl;
+  for (const Row& row : rows) {
+    std::cout << row.name << "  " << row.libm << "  " << row.fast << std::endl;
+  }
+}
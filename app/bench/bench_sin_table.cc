@@ -0,0 +1,62 @@
+/**
+ * @file bench_sin_table.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "bench/bench.h"
+#include "coriander/base/math.h"
+#include "coriander/base/sin_table.h"
+
+namespace {
+using coriander::base::math;
+using coriander::base::sincos_table;
+using SinCosFunc = void (*)(float, float*, float*);
+
+static void sincos_libm(float deg, float* s, float* c) {
+  float rad = deg / 180.0f * static_cast<float>(M_PI);
+  *s = sinf(rad);
+  *c = cosf(rad);
+}
+
+/**
+ * @brief average cost of one sin/cos pair, unit: ns
+ */
+static double sincos_cost(SinCosFunc func, int rounds) {
+  constexpr int points = 1024;
+  float deg[points];
+  volatile float sink = 0;
+  float s, c;
+
+  for (int i = 0; i < points; i++) {
+    deg[i] = i * 360.0f / points + 0.37f;
+  }
+
+  return testing::bench::cost(rounds, [&](int i) {
+    func(deg[i % points], &s, &c);
+    sink = sink + s + c;
+  });
+}
+}  // namespace
+
+TEST(SinTableBench, sincos) {
+  const int rounds = 1'000'000;
+  double libm = sincos_cost(sincos_libm, rounds);
+  double table = sincos_cost(sincos_table<512>, rounds);
+  double provider = sincos_cost(math::sincosd, rounds);
+  std::cout << "sincos libm: " << libm << " ns/call" << std::endl;
+  std::cout << "sincos table<512>: " << table << " ns/call" << std::endl;
+  std::cout << "sincos math::sincosd: " << provider << " ns/call" << std::endl;
+#if CONFIG_CMSIS_DSP_FASTMATH || CONFIG_CORIANDER_SINCOS_CMSIS
+  double cmsis = sincos_cost(arm_sin_cos_f32, rounds);
+  std::cout << "sincos arm_sin_cos_f32: " << cmsis << " ns/call" << std::endl;
+#endif
+}
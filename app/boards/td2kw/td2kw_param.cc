@@ -23,15 +23,42 @@ void board_parameter_default_value_setup(
       P{0.0f, ID::MotorCtl_MotorDriver_PersistRawElecAngle},
       P{0.0f, ID::MotorCtl_MotorDriver_PersistRawMechAngle},
       P{0.0f, ID::MotorCtl_Calibrate_CaliMechAngleOffset},
+      P{0.0f, ID::MotorCtl_Calibrate_CaliLoadAngleOffset},
       P{3.0f, ID::MotorCtl_Calibrate_CaliVoltage},
       P{3000, ID::MotorCtl_Calibrate_CaliDuration},
       P{24.0f, ID::MotorCtl_MotorDriver_SupplyVoltage},
+      P{0.0f, ID::MotorCtl_MotorDriver_DeadTime},
+      P{0.1f, ID::MotorCtl_MotorDriver_DeadTimeCurrentBand},
+      P{1e-3f, ID::MotorCtl_MotorDriver_BusLpf_TimeConstant},
+      P{0.0f, ID::MotorCtl_MotorDriver_Rs},
+      P{0.0f, ID::MotorCtl_MotorDriver_Ld},
+      P{0.0f, ID::MotorCtl_MotorDriver_Lq},
+      P{0.0f, ID::MotorCtl_MotorDriver_FluxLinkage},
+      P{0.0f, ID::MotorCtl_MotorDriver_TorqueConstant},
+      P{1e-4f, ID::MotorCtl_MotorDriver_Inertia},
       P{0.1f, ID::MotorCtl_PosCtl_PidP},
       P{0.0f, ID::MotorCtl_PosCtl_PidI},
       P{0.0f, ID::MotorCtl_PosCtl_PidD},
       P{100.0f, ID::MotorCtl_PosCtl_PidOutputRamp},
       P{960.0f, ID::MotorCtl_PosCtl_PidLimit},
       P{100, ID::MotorCtl_PosCtl_Freq},
+      P{960.0f, ID::MotorCtl_PosCtl_TrajVelocity},
+      P{6000.0f, ID::MotorCtl_PosCtl_TrajAcceleration},
+      P{0.0f, ID::MotorCtl_PosCtl_TrajJerk},
+      P{1.0f, ID::MotorCtl_DualPosCtl_GearRatio},
+      P{100e-3f, ID::MotorCtl_DualPosCtl_Lpf_TimeConstant},
+      P{0.3f, ID::MotorCtl_DualPosCtl_EngageCurrent},
+      P{0.999f, ID::MotorCtl_DualPosCtl_Forgetting},
+      P{0.0f, ID::MotorCtl_DualPosCtl_Backlash},
+      P{0.0f, ID::MotorCtl_DualPosCtl_Compliance},
+      P{5.0f, ID::MotorCtl_DualPosCtl_MaxDeviation},
+      P{20.0f, ID::MotorCtl_PosDirectCtl_PosP},
+      P{0.01f, ID::MotorCtl_PosDirectCtl_VelP},
+      P{0.2f, ID::MotorCtl_PosDirectCtl_VelI},
+      P{960.0f, ID::MotorCtl_PosDirectCtl_VelLimit},
+      P{10.0f, ID::MotorCtl_PosDirectCtl_CurrLimit},
+      P{4, ID::MotorCtl_PosDirectCtl_Divider},
+      P{1e-3f, ID::MotorCtl_PosDirectCtl_Lpf_TimeConstant},
       P{3600.0f, ID::MotorCtl_General_TargetPosition_RT},
       P{0.0f, ID::MotorCtl_General_TargetVelocity_RT},
       P{0.01f, ID::MotorCtl_SpeedCtl_PidP},
@@ -40,14 +67,62 @@ void board_parameter_default_value_setup(
       P{100.0f, ID::MotorCtl_SpeedCtl_PidOutputRamp},
       P{10.0f, ID::MotorCtl_SpeedCtl_PidLimit},
       P{500, ID::MotorCtl_SpeedCtl_Freq},
+      P{0.0f, ID::MotorCtl_SpeedCtl_AccelerationFeedForward},
+      P{0.0f, ID::MotorCtl_SpeedCtl_DisturbanceObserverBandwidth},
+      P{0.0f, ID::MotorCtl_SpeedCtl_Sched0_Speed},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched0_PScale},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched0_IScale},
+      P{0.0f, ID::MotorCtl_SpeedCtl_Sched1_Speed},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched1_PScale},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched1_IScale},
+      P{0.0f, ID::MotorCtl_SpeedCtl_Sched2_Speed},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched2_PScale},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched2_IScale},
+      P{0.0f, ID::MotorCtl_SpeedCtl_Sched3_Speed},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched3_PScale},
+      P{1.0f, ID::MotorCtl_SpeedCtl_Sched3_IScale},
+      P{0, ID::MotorCtl_SpeedCtl_RefFilter0_Type},
+      P{0.0f, ID::MotorCtl_SpeedCtl_RefFilter0_Frequency},
+      P{0.707f, ID::MotorCtl_SpeedCtl_RefFilter0_Q},
+      P{0.0f, ID::MotorCtl_SpeedCtl_RefFilter0_Gain},
+      P{0, ID::MotorCtl_SpeedCtl_RefFilter1_Type},
+      P{0.0f, ID::MotorCtl_SpeedCtl_RefFilter1_Frequency},
+      P{0.707f, ID::MotorCtl_SpeedCtl_RefFilter1_Q},
+      P{0.0f, ID::MotorCtl_SpeedCtl_RefFilter1_Gain},
+      P{0, ID::MotorCtl_SpeedCtl_RefFilter2_Type},
+      P{0.0f, ID::MotorCtl_SpeedCtl_RefFilter2_Frequency},
+      P{0.707f, ID::MotorCtl_SpeedCtl_RefFilter2_Q},
+      P{0.0f, ID::MotorCtl_SpeedCtl_RefFilter2_Gain},
+      P{0, ID::MotorCtl_SpeedCtl_FbFilter0_Type},
+      P{0.0f, ID::MotorCtl_SpeedCtl_FbFilter0_Frequency},
+      P{0.707f, ID::MotorCtl_SpeedCtl_FbFilter0_Q},
+      P{0.0f, ID::MotorCtl_SpeedCtl_FbFilter0_Gain},
+      P{0.95f, ID::MotorCtl_FieldWeakening_Threshold},
+      P{0.5f, ID::MotorCtl_FieldWeakening_PidP},
+      P{50.0f, ID::MotorCtl_FieldWeakening_PidI},
+      P{0.0f, ID::MotorCtl_FieldWeakening_MaxCurrent},
       P{16, ID::MotorCtl_SpeedEstimator_WindowSize},
       P{1000, ID::MotorCtl_SpeedEstimator_MinDuration},
       P{10, ID::MotorCtl_SpeedEstimator_SampleInterval},
+      P{300.0f, ID::MotorCtl_SpeedEstimator_PllBandwidth},
+      P{0.025f, ID::MotorCtl_SpeedEstimator_KalmanPositionNoise},
+      P{10.0f, ID::MotorCtl_SpeedEstimator_KalmanAccelerationNoise},
+      P{0.01f, ID::MotorCtl_SpeedEstimator_KalmanLoadNoise},
+      P{100.0f, ID::MotorCtl_Sensorless_ObserverGain},
+      P{300.0f, ID::MotorCtl_Sensorless_PllBandwidth},
+      P{200.0f, ID::MotorCtl_Sensorless_MinSpeed},
+      P{30.0f, ID::MotorCtl_Sensorless_FaultThreshold},
+      P{20, ID::MotorCtl_Sensorless_FaultCount},
+      P{2.0f, ID::MotorCtl_Hfi_Voltage},
+      P{200.0f, ID::MotorCtl_Hfi_PllBandwidth},
+      P{4.0f, ID::MotorCtl_Hfi_PulseVoltage},
+      P{500, ID::MotorCtl_Hfi_PulseDuration},
+      P{100.0f, ID::MotorCtl_Hfi_BlendSpeed},
       P{0, ID::Sensor_Mech_Position_RT},
       P{0, ID::Sensor_Mech_Velocity_RT},
       P{0, ID::Sensor_Motor_Current_RT},
-      P{0, ID::Sensor_Motor_Temp_RT},
-      P{0, ID::Sensor_Motor_Voltage_RT},
+      P{0.0f, ID::Sensor_Motor_Temp_RT},
+      P{0.0f, ID::Sensor_Motor_Voltage_RT},
       P{5e-3f, ID::MotorCtl_CurrCtl_Lpf_TimeConstant},    // LPF: 200Hz
       P{10e-3f, ID::MotorCtl_SpeedCtl_Lpf_TimeConstant},  // 100Hz
       P{100e-3f, ID::MotorCtl_PosCtl_Lpf_TimeConstant},   // 10Hz
@@ -59,9 +134,31 @@ void board_parameter_default_value_setup(
       P(0.3f, ID::MotorCtl_CurrCtl_PidOutputRamp),
       P{2.5f, ID::MotorCtl_CurrCtl_PidLimit},
       P{4000, ID::MotorCtl_CurrCtl_Freq},
+      P{0, ID::MotorCtl_CurrCtl_Modulation},
+      P{0, ID::MotorCtl_CurrCtl_PwmMode},
+      P{0.8f, ID::MotorCtl_CurrCtl_PwmModeThreshold},
+      P{0, ID::MotorCtl_CurrCtl_Strategy},
+      P{300.0f, ID::MotorCtl_CurrCtl_DeadbeatSpeedBandwidth},
+      P{0.0f, ID::MotorCtl_CurrCtl_Sched0_Current},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched0_PScale},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched0_IScale},
+      P{0.0f, ID::MotorCtl_CurrCtl_Sched1_Current},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched1_PScale},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched1_IScale},
+      P{0.0f, ID::MotorCtl_CurrCtl_Sched2_Current},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched2_PScale},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched2_IScale},
+      P{0.0f, ID::MotorCtl_CurrCtl_Sched3_Current},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched3_PScale},
+      P{1.0f, ID::MotorCtl_CurrCtl_Sched3_IScale},
+      P{0, ID::MotorCtl_CurrCtl_FbFilter0_Type},
+      P{0.0f, ID::MotorCtl_CurrCtl_FbFilter0_Frequency},
+      P{0.707f, ID::MotorCtl_CurrCtl_FbFilter0_Q},
+      P{0.0f, ID::MotorCtl_CurrCtl_FbFilter0_Gain},
       P{0.0f, ID::MotorCtl_General_TargetCurrentD_RT},
       P{0.0f, ID::MotorCtl_General_TargetCurrentQ_RT},
       P{0, ID::Sensor_Encoder_ReverseElecAngle},
+      P{0, ID::Sensor_LoadEncoder_Reverse},
   };
   for (auto& p : properties) {
     param->add(p);
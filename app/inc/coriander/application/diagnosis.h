@@ -52,6 +52,10 @@ struct Diagnosis {
   void setDiagDev(DiagDevId id, DiagDevFunc func) noexcept;
   void addDiagInspector(DiagInspectorFunc func) noexcept;
   void inspect() noexcept;
+  /**
+   * @brief inspect a single device, the others keep their last status
+   */
+  void inspect(DiagDevId id) noexcept;
 
  protected:
   struct DiagDev {
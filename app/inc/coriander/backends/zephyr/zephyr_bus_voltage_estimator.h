@@ -0,0 +1,43 @@
+/**
+ * @file zephyr_bus_voltage_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-12
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include "coriander/motorctl/ibus_voltage_estimator.h"
+
+namespace coriander {
+namespace motorctl {
+namespace zephyr {
+
+/**
+ * @brief bus voltage and temperature, ranks behind the phase current in the
+ *        injected sequence of TIM1 CH4, see zephyr_injected_adc.h
+ *
+ * @note boards without the bus_voltage node never get enabled
+ */
+struct BusVoltageEstimator : public IBusVoltageEstimator {
+  virtual ~BusVoltageEstimator() = default;
+
+  virtual void enable();
+  virtual void disable();
+  virtual bool enabled();
+  virtual void sync();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+
+  virtual float getBusVoltage();
+  virtual float getTemperature();
+
+ private:
+  float mBusVoltage = 0.0f;
+  float mTemperature = 0.0f;
+};
+}  // namespace zephyr
+}  // namespace motorctl
+}  // namespace coriander
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 
 #include "coriander/application/diagnosis.h"
@@ -27,10 +28,24 @@ struct DiagnosisRegister {
   void applyAll(coriander::application::Diagnosis* diagnosis);
   void updateStatus(uint32_t ref_2048, uint32_t ps28Voltage,
                     uint32_t ps5Voltage, uint32_t psCurrent);
+  /**
+   * @brief request an inspection after each supply measurement, called on
+   *        the diagnosis thread
+   */
+  void poll();
+  /**
+   * @brief inspect the position sensors if requested, called on the main
+   *        loop, the inspectors touch the board state and the protocols.
+   *        Their status is a flag set by the control loops, the supply
+   *        devices are only inspected at init, as their callbacks block
+   */
+  void dispatch();
   static DiagnosisRegister* getInstance();
 
  private:
   DiagnosisRegister* mInstance;
+  coriander::application::Diagnosis* mDiagnosis;
+  std::atomic<bool> mPending;
   DeviceStatus mPsVoltage, mPsCurrent;
 };
 }  // namespace zephyr
@@ -14,7 +14,20 @@ namespace coriander {
 namespace motorctl {
 namespace zephyr {
 
-struct Encoder : public motorctl::IEncoder {
+/**
+ * @brief state of one qdec sensor node, see zephyr_encoder.cc
+ */
+struct EncoderInstance;
+
+/**
+ * @brief encoder on a qdec sensor node
+ *
+ * @note a node missing in the devicetree never gets enabled
+ */
+template <typename T_encoder>
+struct EncoderBackend : public T_encoder {
+  explicit EncoderBackend(EncoderInstance* instance) : mInstance(instance) {}
+
   virtual unsigned getEncoderCount();
   virtual unsigned getEncoderCountPerRound();
   virtual int getOverflowCount();
@@ -28,7 +41,26 @@ struct Encoder : public motorctl::IEncoder {
    */
   virtual void calibrate();
   virtual bool needCalibrate();
+
+ private:
+  EncoderInstance* mInstance;
 };
+
+/**
+ * @brief encoder on the motor shaft, the usr_encoder chosen node
+ */
+struct Encoder : public EncoderBackend<motorctl::IEncoder> {
+  Encoder();
+};
+
+/**
+ * @brief encoder behind the gear, the usr_load_encoder chosen node, there is
+ *        no zero to find
+ */
+struct LoadEncoder : public EncoderBackend<motorctl::ILoadEncoder> {
+  LoadEncoder();
+};
+
 }  // namespace zephyr
 }  // namespace motorctl
 }  // namespace coriander
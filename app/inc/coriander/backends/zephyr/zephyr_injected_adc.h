@@ -0,0 +1,58 @@
+/**
+ * @file zephyr_injected_adc.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-14
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+namespace zephyr {
+
+/**
+ * @brief channels of the injected sequences triggered by TIM1 CH4
+ *
+ * The ranks are fixed by this order: the phase currents take rank 1 of their
+ * own ADC so they are sampled at the same instant, the bus voltage and the
+ * temperature follow on their ADC.
+ *
+ * @note the diagnosis thread runs blocking regular conversions through
+ *       adc_read on the same ADCs. A trigger interrupts a regular conversion
+ *       and the ADC resumes it after the injected sequence. Both groups share
+ *       the sampling time of a channel and the resolution of an ADC, zephyr
+ *       sets them from the devicetree, keep them the same for both users.
+ */
+enum class InjectedChannel {
+  PhaseU,
+  PhaseV,
+  PhaseW,
+  BusVoltage,   //!< optional, io-channel-name "motor_vbus"
+  Temperature,  //!< optional, io-channel-name "motor_temp"
+  Count,
+};
+
+/**
+ * @brief set up all injected sequences at once, later calls return the first
+ *        result
+ *
+ * @return false if the phase currents can not be sampled
+ */
+bool injectedAdcSetup();
+
+/**
+ * @return true if the channel is in its sequence
+ */
+bool injectedAdcHas(InjectedChannel channel);
+
+/**
+ * @return last conversion of the channel, unit: mV
+ */
+float injectedAdcReadMv(InjectedChannel channel);
+
+}  // namespace zephyr
+}  // namespace motorctl
+}  // namespace coriander
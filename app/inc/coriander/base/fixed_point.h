@@ -0,0 +1,187 @@
+/**
+ * @file fixed_point.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-16
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace coriander {
+namespace base {
+
+/**
+ * @brief saturating signed fixed-point number, value = raw / 2^F
+ *
+ * @note all intermediate results are computed in int64_t, so storage is
+ *       limited to 32bit. integer only, no FPU is required except the float
+ *       conversions, which are expected to be folded at compile time.
+ */
+template <typename S, int F>
+struct Fixed {
+  static_assert(std::is_signed_v<S> && sizeof(S) <= sizeof(std::int32_t),
+                "storage must be a signed integer no wider than 32bit");
+  static_assert(F > 0 && F < 32, "invalid fraction bits");
+
+  using Storage = S;
+  static constexpr int kFracBits = F;
+  static constexpr std::int64_t kOne = std::int64_t(1) << F;
+  static constexpr std::int64_t kMax = std::numeric_limits<S>::max();
+  static constexpr std::int64_t kMin = std::numeric_limits<S>::min();
+
+  constexpr Fixed() : raw(0) {}
+  constexpr explicit Fixed(float v) : raw(fromFloat(v)) {}
+
+  template <typename S2, int F2>
+  constexpr explicit Fixed(Fixed<S2, F2> v) : raw(rescale<F2>(v.raw)) {}
+
+  static constexpr Fixed fromRaw(std::int64_t v) {
+    Fixed r;
+    r.raw = saturate(v);
+    return r;
+  }
+
+  constexpr explicit operator float() const {
+    return static_cast<float>(raw) / static_cast<float>(kOne);
+  }
+
+  static constexpr Fixed max() { return fromRaw(kMax); }
+  static constexpr Fixed min() { return fromRaw(kMin); }
+
+  constexpr Fixed operator-() const { return fromRaw(-std::int64_t(raw)); }
+  constexpr Fixed operator+(Fixed v) const {
+    return fromRaw(std::int64_t(raw) + v.raw);
+  }
+  constexpr Fixed operator-(Fixed v) const {
+    return fromRaw(std::int64_t(raw) - v.raw);
+  }
+  constexpr Fixed& operator+=(Fixed v) { return *this = *this + v; }
+  constexpr Fixed& operator-=(Fixed v) { return *this = *this - v; }
+
+  /**
+   * @brief multiply by any fixed-point type, result keeps the left type
+   * @note round to nearest
+   */
+  template <typename S2, int F2>
+  constexpr Fixed operator*(Fixed<S2, F2> v) const {
+    std::int64_t p = std::int64_t(raw) * v.raw;
+    return fromRaw((p + (std::int64_t(1) << (F2 - 1))) >> F2);
+  }
+
+  /**
+   * @brief divide by any fixed-point type, result keeps the left type
+   * @note division by zero saturates to max/min
+   */
+  template <typename S2, int F2>
+  constexpr Fixed operator/(Fixed<S2, F2> v) const {
+    if (v.raw == 0) {
+      return raw >= 0 ? max() : min();
+    }
+    return fromRaw((std::int64_t(raw) << F2) / v.raw);
+  }
+
+  template <typename S2, int F2>
+  constexpr Fixed& operator*=(Fixed<S2, F2> v) {
+    return *this = *this * v;
+  }
+
+  constexpr bool operator==(const Fixed& v) const = default;
+  constexpr auto operator<=>(const Fixed& v) const = default;
+
+  S raw;
+
+ private:
+  static constexpr S saturate(std::int64_t v) {
+    return static_cast<S>(v > kMax ? kMax : (v < kMin ? kMin : v));
+  }
+
+  static constexpr S fromFloat(float v) {
+    float scaled = v * static_cast<float>(kOne);
+    if (scaled >= static_cast<float>(kMax)) return static_cast<S>(kMax);
+    if (scaled <= static_cast<float>(kMin)) return static_cast<S>(kMin);
+    return saturate(static_cast<std::int64_t>(scaled < 0 ? scaled - 0.5f
+                                                          : scaled + 0.5f));
+  }
+
+  template <int F2>
+  static constexpr S rescale(std::int64_t v) {
+    if constexpr (F2 > F) {
+      return saturate(v >> (F2 - F));
+    } else {
+      return saturate(v * (std::int64_t(1) << (F - F2)));
+    }
+  }
+};
+
+/**
+ * @brief square root, negative input gives zero
+ * @note bitwise integer sqrt, constant iteration count
+ */
+template <typename S, int F>
+constexpr Fixed<S, F> sqrt(Fixed<S, F> v) {
+  if (v.raw <= 0) {
+    return Fixed<S, F>();
+  }
+  // sqrt(raw / 2^F) * 2^F = sqrt(raw * 2^F)
+  std::uint64_t n = static_cast<std::uint64_t>(v.raw) << F;
+  std::uint64_t res = 0;
+  std::uint64_t bit = std::uint64_t(1) << 62;
+  while (bit > n) {
+    bit >>= 2;
+  }
+  while (bit) {
+    if (n >= res + bit) {
+      n -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return Fixed<S, F>::fromRaw(static_cast<std::int64_t>(res));
+}
+
+using Q15 = Fixed<std::int16_t, 15>;  //!< [-1, 1), resolution 3.1e-5
+using Q31 = Fixed<std::int32_t, 31>;  //!< [-1, 1), resolution 4.7e-10
+using Q16 = Fixed<std::int32_t, 16>;  //!< [-32768, 32768), resolution 1.5e-5
+
+/**
+ * @brief numeric policy, selects the types used by foc/pid/filters
+ *
+ * Value is the signal type: per-unit currents, voltages, duty cycles,
+ * sin/cos. Gain is the coefficient type: pid gains, time constants and
+ * sample time, which can be out of [-1, 1).
+ */
+struct FloatNumeric {
+  using Value = float;
+  using Gain = float;
+
+  static inline float sqrt(float v) { return std::sqrt(v); }
+};
+
+template <typename V, typename G>
+struct FixedNumeric {
+  using Value = V;
+  using Gain = G;
+
+  template <typename T>
+  static constexpr T sqrt(T v) {
+    return base::sqrt(v);
+  }
+};
+
+/**
+ * @note with Q16 gain, sample time has 15.3us resolution
+ */
+using Q15Numeric = FixedNumeric<Q15, Q16>;
+using Q31Numeric = FixedNumeric<Q31, Q16>;
+
+}  // namespace base
+}  // namespace coriander
@@ -9,24 +9,176 @@
  */
 #pragma once
 
-#ifndef CONFIG_CMSIS_DSP_FASTMATH
-#include <cmath>
-
-#else
+#if CONFIG_CMSIS_DSP_FASTMATH || CONFIG_CORIANDER_SINCOS_CMSIS
 #include <arm_math.h>
+#endif
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "coriander/base/sin_table.h"
 
+// not part of standard c++, strict newlib leaves them out
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
+#ifndef M_PI_2
+#define M_PI_2 1.57079632679489661923
+#endif
+#ifndef M_SQRT1_2
+#define M_SQRT1_2 0.70710678118654752440
+#endif
 
+#ifndef CONFIG_CORIANDER_SINCOS_TABLE_SIZE
+#define CONFIG_CORIANDER_SINCOS_TABLE_SIZE (512)
 #endif
 
 namespace coriander {
 namespace base {
+
+/**
+ * @brief math backend of the control loops
+ *
+ * @note CMSIS-DSP is used on target when CONFIG_CMSIS_DSP_FASTMATH is set,
+ *       the rest are portable approximations. Error bounds are measured over
+ *       the whole float input range, see tests/ut_math.cc
+ */
 struct math {
   static inline float fmodf(float x, float y) { return std::fmod(x, y); }
+
+  /**
+   * @brief square root, negative input gives zero
+   * @note exact, vsqrt on target
+   */
+  static inline float sqrtf(float x) {
+#if CONFIG_CMSIS_DSP_FASTMATH
+    float r;
+    arm_sqrt_f32(x, &r);
+    return r;
+#else
+    return x > 0.0f ? std::sqrt(x) : 0.0f;
+#endif
+  }
+
+  /**
+   * @brief 1 / sqrt(x), x must be positive
+   * @note magic constant + 2 newton steps, relative error < 5e-6, no
+   *       division and no sqrt. Only cheaper where sqrt and division are
+   *       slow (Cortex-M FPU, 14 cycles each), hosts with a pipelined sqrt
+   *       unit are faster with 1 / sqrt and use it
+   */
+  static inline float rsqrtf(float x) {
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+    return 1.0f / std::sqrt(x);
+#else
+    std::uint32_t i;
+    float y;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5f375a86u - (i >> 1);
+    std::memcpy(&y, &i, sizeof(y));
+    float half_x = 0.5f * x;
+    y = y * (1.5f - half_x * y * y);
+    y = y * (1.5f - half_x * y * y);
+    return y;
+#endif
+  }
+
+  /**
+   * @brief atan2 in radian, [-pi, pi]
+   * @note arm_atan2_f32 on target. Otherwise minimax polynomial on [0, 1]
+   *       and octant folding, error < 2e-6 rad. atan2(0, 0) is 0
+   */
+  static inline float atan2f(float y, float x) {
+#if CONFIG_CMSIS_DSP_FASTMATH
+    float r;
+    return arm_atan2_f32(y, x, &r) == ARM_MATH_SUCCESS ? r : 0.0f;
+#else
+    constexpr float pi = 3.14159265358979f;
+    float ax = std::fabs(x), ay = std::fabs(y);
+    float mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+    float z = mx > 0.0f ? mn / mx : 0.0f;
+    float z2 = z * z;
+    float r = z * (0.99997726f +
+                   z2 * (-0.33262347f +
+                         z2 * (0.19354346f +
+                               z2 * (-0.11643287f +
+                                     z2 * (0.05265332f + z2 * -0.01172120f)))));
+    r = ay > ax ? pi / 2 - r : r;
+    r = x < 0.0f ? pi - r : r;
+    return y < 0.0f ? -r : r;
+#endif
+  }
+
+  /**
+   * @brief sin and cos of an angle in radian, same provider as sincosd
+   */
+  static inline void sincosf(float rad, float* s, float* c) {
+    sincosd(rad * (180.0f / static_cast<float>(M_PI)), s, c);
+  }
+
+  /**
+   * @brief wrap an angle in degree to [0, 360), branch-free
+   * @note |deg| must be below 2^31 turns
+   */
+  static inline float wrapd(float deg) {
+    float t = deg - 360.0f * static_cast<float>(static_cast<std::int32_t>(
+                                 deg * (1.0f / 360.0f)));
+    t += 360.0f * static_cast<float>(t < 0.0f);
+    t -= 360.0f * static_cast<float>(t >= 360.0f);
+    return t;
+  }
+
+  /**
+   * @brief wrap an angle difference in degree to [-180, 180), branch-free
+   */
+  static inline float wrapd180(float deg) {
+    return wrapd(deg + 180.0f) - 180.0f;
+  }
+
+  static inline float constrain(float v, float lo, float hi) {
+    v = v < lo ? lo : v;
+    return v > hi ? hi : v;
+  }
+
+  /**
+   * @brief saturating int32 arithmetic, qadd/qsub on target
+   */
+  static inline std::int32_t sat_add(std::int32_t a, std::int32_t b) {
+#if CONFIG_CMSIS_DSP_FASTMATH
+    return __QADD(a, b);
+#else
+    std::int64_t r = std::int64_t(a) + b;
+    return static_cast<std::int32_t>(
+        r > INT32_MAX ? INT32_MAX : (r < INT32_MIN ? INT32_MIN : r));
+#endif
+  }
+
+  static inline std::int32_t sat_sub(std::int32_t a, std::int32_t b) {
+#if CONFIG_CMSIS_DSP_FASTMATH
+    return __QSUB(a, b);
+#else
+    std::int64_t r = std::int64_t(a) - b;
+    return static_cast<std::int32_t>(
+        r > INT32_MAX ? INT32_MAX : (r < INT32_MIN ? INT32_MIN : r));
+#endif
+  }
+
+  /**
+   * @brief sin and cos of an angle in degree
+   * @note lookup table by default, see CONFIG_CORIANDER_SINCOS_TABLE_SIZE
+   */
+  static inline void sincosd(float deg, float* s, float* c) {
+#if CONFIG_CORIANDER_SINCOS_CMSIS
+    arm_sin_cos_f32(deg, s, c);
+#elif CONFIG_CORIANDER_SINCOS_LIBM
+    float rad = deg / 180.0f * static_cast<float>(M_PI);
+    *s = std::sin(rad);
+    *c = std::cos(rad);
+#else
+    sincos_table<CONFIG_CORIANDER_SINCOS_TABLE_SIZE>(deg, s, c);
+#endif
+  }
 };
 }  // namespace base
 }  // namespace coriander
@@ -0,0 +1,107 @@
+/**
+ * @file matrix.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-29
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace base {
+
+/**
+ * @brief fixed size row-major float matrix
+ *
+ * @note dimensions are template parameters, a matrix lives on the stack or
+ *       inside its owner, nothing is allocated. Sized for the small state
+ *       space models of the control loops, everything is unrolled by the
+ *       compiler.
+ */
+template <int R, int C>
+struct Matrix {
+  static_assert(R > 0 && C > 0, "invalid matrix dimension");
+
+  static constexpr int kRows = R;
+  static constexpr int kCols = C;
+
+  float m[R][C];
+
+  static constexpr Matrix zeros() {
+    Matrix r{};
+    return r;
+  }
+
+  static constexpr Matrix identity() {
+    static_assert(R == C, "identity of a non-square matrix");
+    Matrix r{};
+    for (int i = 0; i < R; i++) {
+      r.m[i][i] = 1.0f;
+    }
+    return r;
+  }
+
+  constexpr float& operator()(int i, int j) { return m[i][j]; }
+  constexpr float operator()(int i, int j) const { return m[i][j]; }
+
+  constexpr Matrix operator+(const Matrix& v) const {
+    Matrix r;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        r.m[i][j] = m[i][j] + v.m[i][j];
+      }
+    }
+    return r;
+  }
+
+  constexpr Matrix operator-(const Matrix& v) const {
+    Matrix r;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        r.m[i][j] = m[i][j] - v.m[i][j];
+      }
+    }
+    return r;
+  }
+
+  constexpr Matrix operator*(float s) const {
+    Matrix r;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        r.m[i][j] = m[i][j] * s;
+      }
+    }
+    return r;
+  }
+
+  template <int K>
+  constexpr Matrix<R, K> operator*(const Matrix<C, K>& v) const {
+    Matrix<R, K> r{};
+    for (int i = 0; i < R; i++) {
+      for (int k = 0; k < C; k++) {
+        for (int j = 0; j < K; j++) {
+          r.m[i][j] += m[i][k] * v.m[k][j];
+        }
+      }
+    }
+    return r;
+  }
+
+  constexpr Matrix<C, R> transpose() const {
+    Matrix<C, R> r;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        r.m[j][i] = m[i][j];
+      }
+    }
+    return r;
+  }
+};
+
+template <int N>
+using Vector = Matrix<N, 1>;
+
+}  // namespace base
+}  // namespace coriander
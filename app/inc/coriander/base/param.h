@@ -11,6 +11,8 @@
 
 #include <array>
 
+// better-enums stops at 64 constants, ParamId is past that
+#define BETTER_ENUMS_MACRO_FILE "coriander/base/enum_macros.h"
 #include "enum.h"  // NOLINT
 
 namespace coriander {
@@ -35,8 +37,11 @@ namespace base {
  *
  *  for persistent parameters(sync to flash):
  *   <module>_<submodule>_<param_name>
- * @note the order of enum and description array are relaxed, and also can be
- * changed
+ * @note persisted parameters are stored by the index of their id, new ids go
+ * right before Unknow and existing ones are never moved or removed, the
+ * description array follows the order of the enum
+ * @note the stored index is one byte, see PropertyBinaryStreamHeader, ParamId
+ * holds at most 256 ids
  * @warning we don't specific the type of parameter here, be careful when using
  * a parameter which is not a float(the default type of parameter)
  */
@@ -88,6 +93,103 @@ BETTER_ENUM(ParamId, int,
   MotorCtl_SpeedEstimator_WindowSize,
   MotorCtl_SpeedEstimator_MinDuration,
   MotorCtl_SpeedEstimator_SampleInterval,
+  Sensor_LoadEncoder_Reverse,
+  MotorCtl_MotorDriver_DeadTime,
+  MotorCtl_MotorDriver_DeadTimeCurrentBand,
+  MotorCtl_MotorDriver_BusLpf_TimeConstant,
+  MotorCtl_MotorDriver_Rs,
+  MotorCtl_MotorDriver_Ld,
+  MotorCtl_MotorDriver_Lq,
+  MotorCtl_MotorDriver_FluxLinkage,
+  MotorCtl_MotorDriver_TorqueConstant,
+  MotorCtl_MotorDriver_Inertia,
+  MotorCtl_Calibrate_CaliLoadAngleOffset,
+  MotorCtl_PosCtl_TrajVelocity,
+  MotorCtl_PosCtl_TrajAcceleration,
+  MotorCtl_PosCtl_TrajJerk,
+  MotorCtl_DualPosCtl_GearRatio,
+  MotorCtl_DualPosCtl_Lpf_TimeConstant,
+  MotorCtl_DualPosCtl_EngageCurrent,
+  MotorCtl_DualPosCtl_Forgetting,
+  MotorCtl_DualPosCtl_Backlash,
+  MotorCtl_DualPosCtl_Compliance,
+  MotorCtl_DualPosCtl_MaxDeviation,
+  MotorCtl_PosDirectCtl_PosP,
+  MotorCtl_PosDirectCtl_VelP,
+  MotorCtl_PosDirectCtl_VelI,
+  MotorCtl_PosDirectCtl_VelLimit,
+  MotorCtl_PosDirectCtl_CurrLimit,
+  MotorCtl_PosDirectCtl_Divider,
+  MotorCtl_PosDirectCtl_Lpf_TimeConstant,
+  MotorCtl_SpeedCtl_AccelerationFeedForward,
+  MotorCtl_SpeedCtl_DisturbanceObserverBandwidth,
+  MotorCtl_SpeedCtl_Sched0_Speed,
+  MotorCtl_SpeedCtl_Sched0_PScale,
+  MotorCtl_SpeedCtl_Sched0_IScale,
+  MotorCtl_SpeedCtl_Sched1_Speed,
+  MotorCtl_SpeedCtl_Sched1_PScale,
+  MotorCtl_SpeedCtl_Sched1_IScale,
+  MotorCtl_SpeedCtl_Sched2_Speed,
+  MotorCtl_SpeedCtl_Sched2_PScale,
+  MotorCtl_SpeedCtl_Sched2_IScale,
+  MotorCtl_SpeedCtl_Sched3_Speed,
+  MotorCtl_SpeedCtl_Sched3_PScale,
+  MotorCtl_SpeedCtl_Sched3_IScale,
+  MotorCtl_SpeedCtl_RefFilter0_Type,
+  MotorCtl_SpeedCtl_RefFilter0_Frequency,
+  MotorCtl_SpeedCtl_RefFilter0_Q,
+  MotorCtl_SpeedCtl_RefFilter0_Gain,
+  MotorCtl_SpeedCtl_RefFilter1_Type,
+  MotorCtl_SpeedCtl_RefFilter1_Frequency,
+  MotorCtl_SpeedCtl_RefFilter1_Q,
+  MotorCtl_SpeedCtl_RefFilter1_Gain,
+  MotorCtl_SpeedCtl_RefFilter2_Type,
+  MotorCtl_SpeedCtl_RefFilter2_Frequency,
+  MotorCtl_SpeedCtl_RefFilter2_Q,
+  MotorCtl_SpeedCtl_RefFilter2_Gain,
+  MotorCtl_SpeedCtl_FbFilter0_Type,
+  MotorCtl_SpeedCtl_FbFilter0_Frequency,
+  MotorCtl_SpeedCtl_FbFilter0_Q,
+  MotorCtl_SpeedCtl_FbFilter0_Gain,
+  MotorCtl_FieldWeakening_Threshold,
+  MotorCtl_FieldWeakening_PidP,
+  MotorCtl_FieldWeakening_PidI,
+  MotorCtl_FieldWeakening_MaxCurrent,
+  MotorCtl_CurrCtl_Modulation,
+  MotorCtl_CurrCtl_PwmMode,
+  MotorCtl_CurrCtl_PwmModeThreshold,
+  MotorCtl_CurrCtl_Strategy,
+  MotorCtl_CurrCtl_Sched0_Current,
+  MotorCtl_CurrCtl_Sched0_PScale,
+  MotorCtl_CurrCtl_Sched0_IScale,
+  MotorCtl_CurrCtl_Sched1_Current,
+  MotorCtl_CurrCtl_Sched1_PScale,
+  MotorCtl_CurrCtl_Sched1_IScale,
+  MotorCtl_CurrCtl_Sched2_Current,
+  MotorCtl_CurrCtl_Sched2_PScale,
+  MotorCtl_CurrCtl_Sched2_IScale,
+  MotorCtl_CurrCtl_Sched3_Current,
+  MotorCtl_CurrCtl_Sched3_PScale,
+  MotorCtl_CurrCtl_Sched3_IScale,
+  MotorCtl_CurrCtl_FbFilter0_Type,
+  MotorCtl_CurrCtl_FbFilter0_Frequency,
+  MotorCtl_CurrCtl_FbFilter0_Q,
+  MotorCtl_CurrCtl_FbFilter0_Gain,
+  MotorCtl_SpeedEstimator_PllBandwidth,
+  MotorCtl_SpeedEstimator_KalmanPositionNoise,
+  MotorCtl_SpeedEstimator_KalmanAccelerationNoise,
+  MotorCtl_SpeedEstimator_KalmanLoadNoise,
+  MotorCtl_Sensorless_ObserverGain,
+  MotorCtl_Sensorless_PllBandwidth,
+  MotorCtl_Sensorless_MinSpeed,
+  MotorCtl_Sensorless_FaultThreshold,
+  MotorCtl_Sensorless_FaultCount,
+  MotorCtl_Hfi_Voltage,
+  MotorCtl_Hfi_PllBandwidth,
+  MotorCtl_Hfi_PulseVoltage,
+  MotorCtl_Hfi_PulseDuration,
+  MotorCtl_Hfi_BlendSpeed,
+  MotorCtl_CurrCtl_DeadbeatSpeedBandwidth,
   Unknow, MAX_PARAM_ID);
 // clang-format on
 
@@ -107,9 +209,10 @@ struct ParamDescriber {
         [ParamId::Sensor_Encoder_ReverseElecAngle] =
             "reverse electrical angle, used by encoder_elec_angle",
         [ParamId::MotorCtl_General_Mode_RT] =
-            "0:dummy, 1: torque, 2:velocity, 3:position, 4: OpenLoop",
+            "0:dummy, 1: torque, 2:velocity, 3:position, 4: OpenLoop, "
+            "5: position direct to current, 6: position on the load encoder",
         [ParamId::MotorCtl_General_TargetPosition_RT] =
-            "target position, works in mode:3, unit: degree",
+            "target position, works in mode:3 and 5, unit: degree",
         [ParamId::MotorCtl_General_TargetVelocity_RT] =
             "target velocity, works in mode:2 unit: RPM",
         [ParamId::MotorCtl_General_TargetCurrentD_RT] =
@@ -172,6 +275,225 @@ struct ParamDescriber {
             "max window time of velocity estimator, default: 1000ms",
         [ParamId::MotorCtl_SpeedEstimator_SampleInterval] =
             "minimal duration of velocity estimator, default: 10ms",
+        [ParamId::Sensor_LoadEncoder_Reverse] =
+            "reverse the load side encoder, used by load_mech_angle",
+        [ParamId::MotorCtl_MotorDriver_DeadTime] =
+            "dead time over pwm period, 0: no compensation",
+        [ParamId::MotorCtl_MotorDriver_DeadTimeCurrentBand] =
+            "phase current where dead time is fully compensated, unit: A",
+        [ParamId::MotorCtl_MotorDriver_BusLpf_TimeConstant] =
+            "low pass of the measured bus voltage and temperature, "
+            "unit: second",
+        [ParamId::MotorCtl_MotorDriver_Rs] = "phase resistance, unit: Ohm",
+        [ParamId::MotorCtl_MotorDriver_Ld] = "d axis inductance, unit: H",
+        [ParamId::MotorCtl_MotorDriver_Lq] =
+            "q axis inductance, unit: H, mtpa is used when Lq > Ld",
+        [ParamId::MotorCtl_MotorDriver_FluxLinkage] =
+            "permanent magnet flux linkage, unit: Wb",
+        [ParamId::MotorCtl_MotorDriver_TorqueConstant] =
+            "torque per q current, 0 if unknown, unit: Nm/A",
+        [ParamId::MotorCtl_MotorDriver_Inertia] =
+            "rotor and load inertia, unit: kg*m^2",
+        [ParamId::MotorCtl_Calibrate_CaliLoadAngleOffset] =
+            "calibrated load side angle offset, unit: degree",
+        [ParamId::MotorCtl_PosCtl_TrajVelocity] =
+            "maximum velocity of the motion profile, unit: RPM, "
+            "0: no profile, the target is a step",
+        [ParamId::MotorCtl_PosCtl_TrajAcceleration] =
+            "maximum acceleration of the motion profile, unit: RPM/s",
+        [ParamId::MotorCtl_PosCtl_TrajJerk] =
+            "maximum jerk of the motion profile, unit: RPM/s^2, "
+            "0: trapezoidal profile",
+        [ParamId::MotorCtl_DualPosCtl_GearRatio] =
+            "motor turns per load turn",
+        [ParamId::MotorCtl_DualPosCtl_Lpf_TimeConstant] =
+            "time constant of the load encoder correction, the motor encoder "
+            "is fed back above it, unit: s",
+        [ParamId::MotorCtl_DualPosCtl_EngageCurrent] =
+            "q current that closes the gear backlash, unit: A",
+        [ParamId::MotorCtl_DualPosCtl_Forgetting] =
+            "forgetting factor of the backlash estimation, (0, 1]",
+        [ParamId::MotorCtl_DualPosCtl_Backlash] =
+            "gear backlash, estimated while running, unit: load degree",
+        [ParamId::MotorCtl_DualPosCtl_Compliance] =
+            "gear twist per q current, estimated while running, "
+            "unit: load degree/A",
+        [ParamId::MotorCtl_DualPosCtl_MaxDeviation] =
+            "load encoder correction that reports the outer position sensor "
+            "as error, unit: load degree",
+        [ParamId::MotorCtl_PosDirectCtl_PosP] =
+            "position gain of direct position control, unit: RPM/degree",
+        [ParamId::MotorCtl_PosDirectCtl_VelP] =
+            "velocity proportional gain of direct position control, "
+            "unit: A/RPM",
+        [ParamId::MotorCtl_PosDirectCtl_VelI] =
+            "velocity integral gain of direct position control, "
+            "unit: A/(RPM*s)",
+        [ParamId::MotorCtl_PosDirectCtl_VelLimit] =
+            "maximum velocity of direct position control, unit: RPM",
+        [ParamId::MotorCtl_PosDirectCtl_CurrLimit] =
+            "maximum q current of direct position control, unit: A",
+        [ParamId::MotorCtl_PosDirectCtl_Divider] =
+            "direct position control runs once every n current loop periods",
+        [ParamId::MotorCtl_PosDirectCtl_Lpf_TimeConstant] =
+            "time constant of the differentiated velocity, unit: s",
+        [ParamId::MotorCtl_SpeedCtl_AccelerationFeedForward] =
+            "q current per planned acceleration, inertia over torque "
+            "constant, unit: A/(RPM/s)",
+        [ParamId::MotorCtl_SpeedCtl_DisturbanceObserverBandwidth] =
+            "load torque observer, needs torque constant and inertia, "
+            "0: disabled, unit: rad/s",
+        [ParamId::MotorCtl_SpeedCtl_Sched0_Speed] =
+            "gain schedule point 0, unit: RPM",
+        [ParamId::MotorCtl_SpeedCtl_Sched0_PScale] =
+            "gain schedule point 0, P scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched0_IScale] =
+            "gain schedule point 0, I scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched1_Speed] =
+            "gain schedule point 1, unit: RPM",
+        [ParamId::MotorCtl_SpeedCtl_Sched1_PScale] =
+            "gain schedule point 1, P scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched1_IScale] =
+            "gain schedule point 1, I scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched2_Speed] =
+            "gain schedule point 2, unit: RPM",
+        [ParamId::MotorCtl_SpeedCtl_Sched2_PScale] =
+            "gain schedule point 2, P scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched2_IScale] =
+            "gain schedule point 2, I scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched3_Speed] =
+            "gain schedule point 3, unit: RPM",
+        [ParamId::MotorCtl_SpeedCtl_Sched3_PScale] =
+            "gain schedule point 3, P scale",
+        [ParamId::MotorCtl_SpeedCtl_Sched3_IScale] =
+            "gain schedule point 3, I scale",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter0_Type] =
+            "current reference filter 0, "
+            "0: bypass, 1: low pass, 2: notch, 3: lead/lag",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter0_Frequency] =
+            "current reference filter 0, cutoff/center frequency, unit: Hz",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter0_Q] =
+            "current reference filter 0, quality factor, low pass and notch",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter0_Gain] =
+            "current reference filter 0, "
+            "notch depth, lead/lag high frequency gain",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter1_Type] =
+            "current reference filter 1, "
+            "0: bypass, 1: low pass, 2: notch, 3: lead/lag",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter1_Frequency] =
+            "current reference filter 1, cutoff/center frequency, unit: Hz",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter1_Q] =
+            "current reference filter 1, quality factor, low pass and notch",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter1_Gain] =
+            "current reference filter 1, "
+            "notch depth, lead/lag high frequency gain",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter2_Type] =
+            "current reference filter 2, "
+            "0: bypass, 1: low pass, 2: notch, 3: lead/lag",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter2_Frequency] =
+            "current reference filter 2, cutoff/center frequency, unit: Hz",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter2_Q] =
+            "current reference filter 2, quality factor, low pass and notch",
+        [ParamId::MotorCtl_SpeedCtl_RefFilter2_Gain] =
+            "current reference filter 2, "
+            "notch depth, lead/lag high frequency gain",
+        [ParamId::MotorCtl_SpeedCtl_FbFilter0_Type] =
+            "feedback filter 0, "
+            "0: bypass, 1: low pass, 2: notch, 3: lead/lag",
+        [ParamId::MotorCtl_SpeedCtl_FbFilter0_Frequency] =
+            "feedback filter 0, cutoff/center frequency, unit: Hz",
+        [ParamId::MotorCtl_SpeedCtl_FbFilter0_Q] =
+            "feedback filter 0, quality factor, low pass and notch",
+        [ParamId::MotorCtl_SpeedCtl_FbFilter0_Gain] =
+            "feedback filter 0, "
+            "notch depth, lead/lag high frequency gain",
+        [ParamId::MotorCtl_FieldWeakening_Threshold] =
+            "modulation index where field weakening starts, "
+            "|Udq| over the voltage limit",
+        [ParamId::MotorCtl_FieldWeakening_PidP] = "",
+        [ParamId::MotorCtl_FieldWeakening_PidI] = "",
+        [ParamId::MotorCtl_FieldWeakening_MaxCurrent] =
+            "maximum negative d current of field weakening, unit: A, "
+            "0: disabled",
+        [ParamId::MotorCtl_CurrCtl_Modulation] =
+            "0: linear, 1: overmodulation I, 2: overmodulation II/six-step",
+        [ParamId::MotorCtl_CurrCtl_PwmMode] =
+            "0: continuous, 1: dpwm min, 2: dpwm max, 3: dpwm60, 4: dpwm30",
+        [ParamId::MotorCtl_CurrCtl_PwmModeThreshold] =
+            "voltage vector magnitude where discontinuous pwm takes over, "
+            "2/sqrt(3) is the linear limit",
+        [ParamId::MotorCtl_CurrCtl_Strategy] =
+            "0: pi, 1: deadbeat predictive on MotorDriver Rs, Ld, Lq and "
+            "FluxLinkage, pi when Ld or Lq is 0",
+        [ParamId::MotorCtl_CurrCtl_Sched0_Current] =
+            "gain schedule point 0, unit: A",
+        [ParamId::MotorCtl_CurrCtl_Sched0_PScale] =
+            "gain schedule point 0, P scale",
+        [ParamId::MotorCtl_CurrCtl_Sched0_IScale] =
+            "gain schedule point 0, I scale",
+        [ParamId::MotorCtl_CurrCtl_Sched1_Current] =
+            "gain schedule point 1, unit: A",
+        [ParamId::MotorCtl_CurrCtl_Sched1_PScale] =
+            "gain schedule point 1, P scale",
+        [ParamId::MotorCtl_CurrCtl_Sched1_IScale] =
+            "gain schedule point 1, I scale",
+        [ParamId::MotorCtl_CurrCtl_Sched2_Current] =
+            "gain schedule point 2, unit: A",
+        [ParamId::MotorCtl_CurrCtl_Sched2_PScale] =
+            "gain schedule point 2, P scale",
+        [ParamId::MotorCtl_CurrCtl_Sched2_IScale] =
+            "gain schedule point 2, I scale",
+        [ParamId::MotorCtl_CurrCtl_Sched3_Current] =
+            "gain schedule point 3, unit: A",
+        [ParamId::MotorCtl_CurrCtl_Sched3_PScale] =
+            "gain schedule point 3, P scale",
+        [ParamId::MotorCtl_CurrCtl_Sched3_IScale] =
+            "gain schedule point 3, I scale",
+        [ParamId::MotorCtl_CurrCtl_FbFilter0_Type] =
+            "feedback filter 0, "
+            "0: bypass, 1: low pass, 2: notch, 3: lead/lag",
+        [ParamId::MotorCtl_CurrCtl_FbFilter0_Frequency] =
+            "feedback filter 0, cutoff/center frequency, unit: Hz",
+        [ParamId::MotorCtl_CurrCtl_FbFilter0_Q] =
+            "feedback filter 0, quality factor, low pass and notch",
+        [ParamId::MotorCtl_CurrCtl_FbFilter0_Gain] =
+            "feedback filter 0, "
+            "notch depth, lead/lag high frequency gain",
+        [ParamId::MotorCtl_SpeedEstimator_PllBandwidth] =
+            "bandwidth of pll velocity estimator, unit: rad/s",
+        [ParamId::MotorCtl_SpeedEstimator_KalmanPositionNoise] =
+            "encoder angle noise of kalman velocity estimator, unit: degree",
+        [ParamId::MotorCtl_SpeedEstimator_KalmanAccelerationNoise] =
+            "unmodeled acceleration of kalman velocity estimator, "
+            "unit: rad/s^2/sqrt(Hz)",
+        [ParamId::MotorCtl_SpeedEstimator_KalmanLoadNoise] =
+            "load torque drift of kalman velocity estimator, "
+            "unit: Nm/sqrt(s)",
+        [ParamId::MotorCtl_Sensorless_ObserverGain] =
+            "flux observer gain, about the lowest electrical speed, "
+            "unit: rad/s",
+        [ParamId::MotorCtl_Sensorless_PllBandwidth] =
+            "bandwidth of flux observer speed loop, unit: rad/s",
+        [ParamId::MotorCtl_Sensorless_MinSpeed] =
+            "speed above which flux observer is trusted, unit: RPM",
+        [ParamId::MotorCtl_Sensorless_FaultThreshold] =
+            "encoder and flux observer disagreement, unit: degree",
+        [ParamId::MotorCtl_Sensorless_FaultCount] =
+            "current loop cycles of disagreement before encoder is dropped",
+        [ParamId::MotorCtl_Hfi_Voltage] =
+            "d axis square wave injected at standstill, unit: volt",
+        [ParamId::MotorCtl_Hfi_PllBandwidth] =
+            "bandwidth of injection angle tracking, unit: rad/s",
+        [ParamId::MotorCtl_Hfi_PulseVoltage] =
+            "d axis pulse to find magnet polarity, unit: volt",
+        [ParamId::MotorCtl_Hfi_PulseDuration] =
+            "d axis pulse to find magnet polarity, unit: us",
+        [ParamId::MotorCtl_Hfi_BlendSpeed] =
+            "injection hands over to back-emf from this speed to twice of "
+            "it, unit: RPM",
+        [ParamId::MotorCtl_CurrCtl_DeadbeatSpeedBandwidth] =
+            "speed tracking bandwidth of the deadbeat delay compensation, "
+            "unit: rad/s, 0: raw angle step",
     };
 
     return desc[id];
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -93,6 +94,10 @@ struct PropertyBinaryStreamHeader {
   std::uint8_t value_size;
 };
 #pragma pack(pop)
+
+// id is stored by its index in one byte
+static_assert(ParamId::MAX_PARAM_ID <= UINT8_MAX + 1,
+              "ParamId does not fit PropertyBinaryStreamHeader::id");
 }  // namespace detail
 
 struct PropertyBinaryStream : public Property {
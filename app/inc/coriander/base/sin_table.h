@@ -0,0 +1,82 @@
+/**
+ * @file sin_table.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-17
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace coriander {
+namespace base {
+
+namespace detail {
+constexpr double sin_taylor(double x) {
+  double term = x, sum = x;
+  for (int k = 1; k < 32; k++) {
+    term *= -x * x / ((2 * k) * (2 * k + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+/**
+ * @brief one electrical turn of sin, N + 1 entries so interpolation never
+ *        wraps inside the table
+ */
+template <std::size_t N>
+struct SinTable {
+  static_assert(N >= 16 && (N & (N - 1)) == 0,
+                "table size must be a power of 2");
+
+  constexpr SinTable() : v() {
+    constexpr double pi = 3.14159265358979323846;
+    for (std::size_t i = 0; i <= N; i++) {
+      double x = 2 * pi * i / N;
+      if (x > pi) {
+        x -= 2 * pi;
+      }
+      v[i] = static_cast<float>(sin_taylor(x));
+    }
+  }
+
+  float v[N + 1];
+};
+
+template <std::size_t N>
+inline constexpr SinTable<N> kSinTable{};
+}  // namespace detail
+
+/**
+ * @brief sin and cos of an angle in degree, by linear interpolated table
+ *
+ * @tparam N table size per turn, power of 2. max error is 4.93 / N^2,
+ *           e.g. 7.5e-5 for 256, 1.9e-5 for 512, 4.7e-6 for 1024
+ * @param deg angle in degree, any range
+ */
+template <std::size_t N>
+inline void sincos_table(float deg, float* s, float* c) {
+  constexpr float scale = static_cast<float>(N) / 360.0f;
+  const float* t = detail::kSinTable<N>.v;
+
+  float f = deg * scale;
+  std::int32_t i = static_cast<std::int32_t>(f);
+  // floor for negative angles
+  if (f < i) {
+    i--;
+  }
+  float frac = f - i;
+
+  std::uint32_t is = static_cast<std::uint32_t>(i) & (N - 1);
+  std::uint32_t ic = (is + N / 4) & (N - 1);
+  *s = t[is] + (t[is + 1] - t[is]) * frac;
+  *c = t[ic] + (t[ic + 1] - t[ic]) * frac;
+}
+
+}  // namespace base
+}  // namespace coriander
@@ -0,0 +1,81 @@
+/**
+ * @file backlash_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include "coriander/base/matrix.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief backlash and compliance of a gear from the twist between the motor
+ *        and the load side
+ *
+ * The twist is the motor angle over the gear ratio minus the load angle. With
+ * the gear loaded on one flank it follows
+ *
+ *   twist = center + side * backlash / 2 + compliance * Iq
+ *
+ * where side is the sign of the torque. The three terms are fitted by
+ * recursive least squares, only while |Iq| is above the engage current, the
+ * twist inside the gap tells nothing.
+ */
+struct BacklashEstimator {
+  using State = base::Vector<3>;
+  using Covariance = base::Matrix<3, 3>;
+
+  BacklashEstimator();
+
+  /**
+   * @param engageCurrent - |Iq| that closes the gap, unit: A
+   * @param forgetting - forgetting factor per update, (0, 1]
+   * @param backlash - initial estimate, unit: load degree
+   * @param compliance - initial estimate, unit: load degree/A
+   */
+  void setup(float engageCurrent, float forgetting, float backlash,
+             float compliance);
+
+  /**
+   * @brief restart at a twist, the gear is taken as centered in the gap
+   */
+  void reset(float twist);
+
+  /**
+   * @param twist - motor angle over gear ratio minus load angle, load degree
+   * @param Iq - torque current, unit: A
+   */
+  void operator()(float twist, float Iq);
+
+  /**
+   * @brief twist expected at a torque, on the last loaded flank inside the
+   *        engage band
+   */
+  float predict(float Iq) const;
+
+  /**
+   * @brief flank in contact, follows the torque with the engage current as
+   *        hysteresis, 1 or -1
+   */
+  int side() const { return mSide; }
+
+  float getCenter() const { return mTheta(0, 0); }
+  float getBacklash() const;
+  float getCompliance() const;
+
+ private:
+  State mTheta;  //!< center, half backlash, compliance
+  Covariance mP;
+  float mEngageCurrent;
+  float mForgetting;
+  int mSide;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,96 @@
+/**
+ * @file biquad_filter.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-08
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief second order section, transposed direct form II
+ *
+ * Coefficients are computed once in setup() for a fixed sample frequency,
+ * the filter itself is five multiplies and no division.
+ */
+struct BiquadFilter {
+  enum class Type {
+    Bypass = 0,
+    LowPass = 1,  //!< second order, Q 0.707 for butterworth
+    Notch = 2,    //!< gain at the center frequency, 0: full notch
+    LeadLag = 3,  //!< first order, gain at high frequency over dc gain
+  };
+
+  BiquadFilter();
+
+  /**
+   * @param type - response
+   * @param frequency - cutoff/center frequency, unit: Hz
+   * @param Q - quality factor, low pass and notch
+   * @param gain - notch depth, lead/lag high frequency gain
+   * @param sampleFrequency - rate of operator() calls, unit: Hz
+   * @return false if the section can not be realised and passes through,
+   *         frequency must stay below the nyquist frequency
+   */
+  bool setup(Type type, float frequency, float Q, float gain,
+             float sampleFrequency);
+
+  float operator()(float x) {
+    float y = mB0 * x + mS1;
+    mS1 = mB1 * x - mA1 * y + mS2;
+    mS2 = mB2 * x - mA2 * y;
+    return y;
+  }
+
+  void reset();
+
+ private:
+  float mB0, mB1, mB2;
+  float mA1, mA2;  //!< normalised, a0 is 1
+  float mS1, mS2;
+};
+
+/**
+ * @brief cascade of second order sections, notches for load resonances
+ *        usually followed by a low pass
+ */
+struct BiquadChain {
+  static constexpr int kMaxStages = 4;
+
+  struct Stage {
+    BiquadFilter::Type type;
+    float frequency;  //!< unit: Hz
+    float Q;
+    float gain;
+  };
+
+  BiquadChain();
+
+  /**
+   * @brief keep the stages that can be realised at sampleFrequency
+   */
+  void setup(const Stage* stages, int n, float sampleFrequency);
+
+  float operator()(float x) {
+    for (int i = 0; i < mSize; i++) {
+      x = mStages[i](x);
+    }
+    return x;
+  }
+
+  void reset();
+
+  int size() const { return mSize; }
+
+ private:
+  BiquadFilter mStages[kMaxStages];
+  int mSize;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -13,10 +13,16 @@
 #include "coriander/base/const_hash.h"
 #include "coriander/motorctl/encoder_elec_angle_estimator.h"
 #include "coriander/motorctl/encoder_mech_angle_estimator.h"
+#include "coriander/motorctl/fallback_elec_angle_estimator.h"
+#include "coriander/motorctl/fallback_mech_angle_estimator.h"
+#include "coriander/motorctl/hfi_elec_angle_estimator.h"
 #include "coriander/motorctl/imotorctl.h"
 #include "coriander/motorctl/ivelocity_estimator.h"
+#include "coriander/motorctl/kalman_velocity_estimator.h"
+#include "coriander/motorctl/load_mech_angle_estimator.h"
 #include "coriander/motorctl/motor_ctl_calibrate.h"
 #include "coriander/motorctl/motor_ctl_wrapper.h"
+#include "coriander/motorctl/pll_velocity_estimator.h"
 #include "coriander/motorctl/velocity_estimator.h"
 #include "coriander/parameters.h"
 
@@ -28,9 +34,27 @@ static inline auto createInjector() {
   using boost::di::make_injector;
   using coriander::base::operator""_hash;
   return make_injector(
+#if CONFIG_CORIANDER_SENSORLESS_FALLBACK
+      bind<IElecAngleEstimator, FallbackElecAngleEstimator>()
+          .to<FallbackElecAngleEstimator>(),
+#elif CONFIG_CORIANDER_ELEC_ANGLE_HFI
+      bind<IElecAngleEstimator>().to<HfiElecAngleEstimator>(),
+#else
       bind<IElecAngleEstimator>().to<EncoderElecAngleEstimator>(),
+#endif
+#if CONFIG_CORIANDER_SENSORLESS_FALLBACK
+      bind<IMechAngleEstimator>().to<FallbackMechAngleEstimator>(),
+#else
       bind<IMechAngleEstimator>().to<EncoderMechAngleEstimator>(),
+#endif
+      bind<ILoadMechAngleEstimator>().to<LoadMechAngleEstimator>(),
+#if CONFIG_CORIANDER_VELOCITY_PLL
+      bind<IVelocityEstimator>().to<PllVelocityEstimator>(),
+#elif CONFIG_CORIANDER_VELOCITY_KALMAN
+      bind<IVelocityEstimator>().to<KalmanVelocityEstimator>(),
+#else
       bind<IVelocityEstimator>().to<VelocityEstimator>(),
+#endif
       bind<MotorCtlCalibrate>().to<MotorCtlCalibrate>(),
       bind<IMotorCtl>().to<DynamicMotorCtl>());
 }
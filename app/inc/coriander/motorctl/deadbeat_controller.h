@@ -0,0 +1,99 @@
+/**
+ * @file deadbeat_controller.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-14
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief deadbeat predictive dq current controller
+ *
+ * The voltage computed at sample k reaches the motor at k + 1. The current at
+ * k + 1 is predicted from the voltage still applied, then the voltage is
+ * chosen to land on the target at k + 2, by the forward euler model
+ *
+ *   Ld * did/dt = ud - R * id + w * Lq * iq
+ *   Lq * diq/dt = uq - R * iq - w * (Ld * id + flux)
+ *
+ * The output is in the rotor frame one period ahead. advance() turns it to
+ * the sampled angle, by w * Ts for the delay and another half period for the
+ * pwm holding the vector still while the rotor turns under it. The speed w
+ * comes from a type-II tracking loop on the sampled angle, seeded from the
+ * first angle step, the raw step of an encoder angle is mostly quantization
+ * noise at the current loop rate.
+ *
+ * @note no integral action, a parameter error is a steady state error
+ */
+struct DeadbeatController {
+  DeadbeatController();
+
+  /**
+   * @param Rs phase resistance, Ohm
+   * @param Ld d axis inductance, H, 0: disabled
+   * @param Lq q axis inductance, H, 0: disabled
+   * @param flux permanent magnet flux linkage, Wb
+   * @param bandwidth speed tracking loop bandwidth, rad/s, 0: the raw angle
+   *        step
+   */
+  void setup(float Rs, float Ld, float Lq, float flux, float bandwidth);
+  void reset();
+
+  bool enabled() const { return mLd > 0.0f && mLq > 0.0f; }
+
+  /**
+   * @param targetId target d current, A
+   * @param targetIq target q current, A
+   * @param id measured d current, unfiltered, A
+   * @param iq measured q current, unfiltered, A
+   * @param angle electrical angle at the sample, degree
+   * @param Ts period, s
+   * @param ud d voltage for the next period, V
+   * @param uq q voltage for the next period, V
+   */
+  void operator()(float targetId, float targetIq, float id, float iq,
+                  float angle, float Ts, float *ud, float *uq);
+
+  /**
+   * @brief feed back the voltage actually applied after an outer limiter,
+   *        the next prediction starts from it
+   */
+  void backCalculate(float ud, float uq);
+
+  /**
+   * @brief rotate the output by 1.5 * w * Ts, from the rotor frame over the
+   *        next period to the frame at the sample
+   */
+  void advance(float *ud, float *uq) const;
+
+  /**
+   * @return float electrical speed, degree per second
+   */
+  float getVelocity() const;
+
+ private:
+  void trackAngle(float angle, float Ts);
+
+  float mRs;
+  float mLd;
+  float mLq;
+  float mFlux;
+  float mKp;
+  float mKi;
+  float mUd;      //!< voltage applied over the current period, V
+  float mUq;      //!< voltage applied over the current period, V
+  float mOmega;   //!< electrical speed, rad/s
+  float mAngle;   //!< tracked angle, degree
+  float mTs;
+  bool mStarted;
+  bool mSeeded;   //!< speed taken from a first angle step
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,113 @@
+/**
+ * @file discrete_pid.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-22
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief pid with cached discrete coefficients
+ *
+ * u = P * e + I * sum(e * Ts) + D * filtered(de/dt) + feedForward
+ *
+ * @note the derivative filter and the tracking gain are only recomputed
+ *       when gains change or Ts moves by more than 5%, so the jitter of a
+ *       measured Ts costs no division. Same constructor and limits as Pid,
+ *       so it replaces Pid in the control loops
+ */
+struct DiscretePid {
+  enum class AntiWindup : int32_t {
+    Clamp = 0,        //!< integral clamped to limit, same as Pid
+    BackCalculation,  //!< saturation excess is fed back into the integral
+    Conditional,      //!< integration stops while pushing into saturation
+  };
+
+  /**
+   *
+   * @param P - Proportional gain
+   * @param I - Integral gain
+   * @param D - Derivative gain
+   * @param ramp - Maximum speed of change of the output value
+   * @param limit - Maximum output value
+   */
+  DiscretePid(float P, float I, float D, float ramp, float limit);
+
+  float operator()(float error, float Ts, float feedForward = 0.0f);
+  void reset();
+
+  void setGains(float P, float I, float D);
+  void setRamp(float ramp);
+  void setLimit(float limit);
+
+  /**
+   * @brief scale P and I, for gain scheduling
+   *
+   * @note only rescales the cached coefficients, cheap enough for every call
+   */
+  void setGainScale(float P, float I);
+
+  /**
+   * @brief Set the derivative filter
+   *
+   * @param Tf time constant of the first-order filter, 0: no filter
+   */
+  void setDerivativeFilter(float Tf);
+
+  /**
+   * @brief Set the anti-windup strategy
+   *
+   * @param Tt tracking time constant of back-calculation, 0 removes the whole
+   *           excess in one step
+   */
+  void setAntiWindup(AntiWindup mode, float Tt = 0.0f);
+
+  /**
+   * @brief feed back the output actually applied after an outer limiter
+   */
+  void backCalculate(float output);
+
+  float getLimit() const { return mLimit; }
+
+ private:
+  void discretize(float Ts);
+
+  // gains
+  float mP;
+  float mI;
+  float mD;
+  float mTf;
+  float mTt;
+  float mRamp;
+  float mLimit;
+  float mPScale;
+  float mIScale;
+  AntiWindup mAntiWindup;
+
+  // cached coefficients, of mTs where they depend on it
+  bool mDirty;
+  float mTs;
+  float mKp;          //!< P * scale
+  float mKi;          //!< I * scale / 2, tustin, times Ts per call
+  float mKdFilter;    //!< Tf / (Tf + Ts)
+  float mKd;          //!< D / (Tf + Ts)
+  float mKt;          //!< Ts / Tt, capped to 1
+
+  // states
+  float mIntegral;
+  float mDerivative;
+  float mErrorPrev;
+  float mOutputPrev;
+  float mExcess;  //!< clipped part of the last output, sign only
+};
+
+}  // namespace motorctl
+}  // namespace coriander
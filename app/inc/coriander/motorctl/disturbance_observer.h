@@ -0,0 +1,59 @@
+/**
+ * @file disturbance_observer.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-03
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief load torque observer for the velocity loop
+ *
+ * J * dw/dt = Kt * Iq - load, the load is Kt * Iq - J * dw/dt through a
+ * first-order filter of the bandwidth. Arranged as
+ * load = lpf(Kt * Iq + g * J * w) - g * J * w, the velocity is never
+ * differentiated.
+ */
+struct DisturbanceObserver {
+  DisturbanceObserver();
+
+  /**
+   * @param inertia rotor and load inertia, kg*m^2
+   * @param torqueConstant Nm/A, 0: disabled
+   * @param bandwidth filter bandwidth g, rad/s, 0: disabled
+   */
+  void setup(float inertia, float torqueConstant, float bandwidth);
+
+  /**
+   * @param velocity unfiltered, RPM, a filter lag shows up as load
+   * @param Iq q current commanded over the last period, A
+   * @param Ts unit: s
+   * @return float q current compensating the load, A
+   */
+  float operator()(float velocity, float Iq, float Ts);
+  void reset();
+
+  bool enabled() const { return mBandwidth > 0.0f && mTorqueConstant > 0.0f; }
+
+  /**
+   * @return float estimated load torque, Nm
+   */
+  float getLoadTorque() const { return mLoad; }
+
+ private:
+  float mInertia;
+  float mTorqueConstant;
+  float mBandwidth;
+  float mFiltered;  //!< lpf(Kt * Iq + g * J * w), Nm
+  float mLoad;
+  bool mStarted;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,91 @@
+/**
+ * @file fallback_elec_angle_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/application/diagnosis.h"
+#include "coriander/motorctl/encoder_elec_angle_estimator.h"
+#include "coriander/motorctl/ielec_angle_estimator.h"
+#include "coriander/motorctl/sensorless_elec_angle_estimator.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Elecangle estimator on the encoder, supervised by the sensorless
+ *        observer
+ *
+ * Both run on every sync. Once the observer has converged, an encoder angle
+ * away from it by more than MotorCtl_Sensorless_FaultThreshold is replaced by
+ * the observer angle, so a glitch never reaches the current loop. After
+ * MotorCtl_Sensorless_FaultCount such syncs in a row the encoder is dropped
+ * until the next enable(), and MotorInnerPosSensor is reported as Error
+ * through Diagnosis.
+ *
+ * @note the mechanical angle fails over in FallbackMechAngleEstimator
+ */
+struct FallbackElecAngleEstimator : public IElecAngleEstimator,
+                                    public IParamReq {
+  using Diagnosis = application::Diagnosis;
+
+  FallbackElecAngleEstimator(
+      std::shared_ptr<EncoderElecAngleEstimator> encoder,
+      std::shared_ptr<SensorlessElecAngleEstimator> sensorless,
+      std::shared_ptr<Diagnosis> diagnosis, std::shared_ptr<Parameter> param,
+      std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept;
+
+  virtual void enable();
+  virtual void disable();
+  virtual void sync();
+  virtual bool enabled();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getElectricalAngle() noexcept;
+  virtual void setVoltage(float alpha, float beta) noexcept;
+
+  /**
+   * @brief encoder dropped, the observer drives the current loop
+   */
+  bool failed() const { return mFailed; }
+
+  /**
+   * @return float electrical speed of the observer, degree per second
+   */
+  float getObserverVelocity() const {
+    return mSensorless->getElectricalVelocity();
+  }
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    constexpr static const ParameterRequireItem items[] = {
+        {"MotorCtl_Sensorless_FaultThreshold", TypeId::Float},
+        {"MotorCtl_Sensorless_FaultCount", TypeId::Int32},
+        PARAMETER_REQ_EOF};
+
+    return &items[0];
+  }
+
+ private:
+  std::shared_ptr<EncoderElecAngleEstimator> mEncoder;
+  std::shared_ptr<SensorlessElecAngleEstimator> mSensorless;
+  std::shared_ptr<Diagnosis> mDiagnosis;
+  std::shared_ptr<Parameter> mParam;
+  float mFaultThreshold;  //!< electrical degree
+  int32_t mFaultCount;
+  int32_t mBadCount;
+  bool mUseSensorless;
+  bool mFailed;
+  bool mEnabled;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,70 @@
+/**
+ * @file fallback_mech_angle_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-16
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/motorctl/encoder_mech_angle_estimator.h"
+#include "coriander/motorctl/fallback_elec_angle_estimator.h"
+#include "coriander/motorctl/imech_angle_estimator.h"
+#include "coriander/os/isystick.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Mechanical angle on the encoder, dead reckoned on the sensorless
+ *        observer once FallbackElecAngleEstimator has dropped the encoder
+ *
+ * The velocity estimators differentiate this angle, so after the failover
+ * they follow the observer speed and velocity control keeps running. The
+ * angle drifts from the rotor from then on, lost() stops position control.
+ */
+struct FallbackMechAngleEstimator : public IMechAngleEstimator,
+                                    public IParamReq {
+  using ISystick = coriander::os::ISystick;
+
+  FallbackMechAngleEstimator(
+      std::shared_ptr<EncoderMechAngleEstimator> encoder,
+      std::shared_ptr<FallbackElecAngleEstimator> fallback,
+      std::shared_ptr<ISystick> systick, std::shared_ptr<Parameter> param,
+      std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept;
+
+  virtual void enable();
+  virtual void disable();
+  virtual bool enabled();
+  virtual void sync();
+  virtual void reset();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getMechanicalAngle() noexcept;
+  virtual bool lost() noexcept { return mFallback->failed(); }
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    constexpr static const ParameterRequireItem items[] = {
+        {"MotorCtl_MotorDriver_PolePair", TypeId::Int32}, PARAMETER_REQ_EOF};
+
+    return &items[0];
+  }
+
+ private:
+  std::shared_ptr<EncoderMechAngleEstimator> mEncoder;
+  std::shared_ptr<FallbackElecAngleEstimator> mFallback;
+  std::shared_ptr<ISystick> mSystick;
+  std::shared_ptr<Parameter> mParam;
+  float mElecToMech;  //!< electrical to mechanical degree
+  float mMechAngle;   //!< last encoder angle, then dead reckoned
+  uint32_t mTimestamp;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
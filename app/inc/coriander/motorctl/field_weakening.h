@@ -0,0 +1,51 @@
+/**
+ * @file field_weakening.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-25
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief voltage feedback field weakening
+ *
+ * A PI on (threshold - modulation index) whose output is clamped to
+ * [-maxCurrent, 0]. Below the threshold the integral winds back to zero and
+ * so does Id, above it Id goes negative until the voltage vector fits again.
+ */
+struct FieldWeakening {
+  FieldWeakening();
+
+  /**
+   * @param threshold - modulation index(|Udq| / voltage limit) to hold
+   * @param maxCurrent - maximum |Id|, 0: disabled
+   */
+  void setLimits(float threshold, float maxCurrent);
+  void setGains(float P, float I);
+
+  /**
+   * @param modulationIndex - |Udq| / voltage limit, of the current loop
+   * @param Ts - unit: s
+   * @return Id reference, <= 0
+   */
+  float operator()(float modulationIndex, float Ts);
+  void reset();
+
+  bool enabled() const { return mMaxCurrent > 0.0f; }
+
+ private:
+  float mP;
+  float mI;
+  float mThreshold;
+  float mMaxCurrent;
+  float mIntegral;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,92 @@
+/**
+ * @file flux_observer.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief nonlinear flux observer for a surface PMSM, rotor angle from the
+ *        stator voltage and current
+ *
+ * The stator flux is integrated from v - R * i, the rotor flux is that minus
+ * L * i, and the integrator is pulled back to the circle |rotor flux| = flux
+ * linkage, which removes the drift of a plain back-EMF integrator. A type-II
+ * tracking loop on the angle gives the speed.
+ *
+ * @note back-EMF vanishes at standstill, the angle is only usable above a
+ *       few percent of the rated speed, see converged()
+ */
+struct FluxObserver {
+  FluxObserver();
+
+  /**
+   * @param Rs phase resistance, Ohm
+   * @param Ls phase inductance, H, (Ld + Lq) / 2 for a salient motor
+   * @param flux permanent magnet flux linkage, Wb
+   * @param gain convergence rate of the flux circle, rad/s, keep it near
+   *             the lowest electrical speed, high gains limit-cycle on a
+   *             resistance error
+   * @param bandwidth speed tracking loop bandwidth, rad/s
+   */
+  void setup(float Rs, float Ls, float flux, float gain, float bandwidth);
+
+  /**
+   * @brief restart from a rotor angle at standstill
+   *
+   * @param angle electrical angle, degree
+   */
+  void reset(float angle = 0.0f);
+
+  /**
+   * @param valpha applied stator voltage, V
+   * @param vbeta applied stator voltage, V
+   * @param ialpha measured stator current, A
+   * @param ibeta measured stator current, A
+   * @param Ts time since the last update, s
+   */
+  void operator()(float valpha, float vbeta, float ialpha, float ibeta,
+                  float Ts);
+
+  /**
+   * @return float electrical angle, degree in [0, 360)
+   */
+  float getAngle() const { return mAngle; }
+
+  /**
+   * @return float electrical speed, degree per second
+   */
+  float getVelocity() const { return mVelocity; }
+
+  /**
+   * @brief speed is high enough for the back-EMF to carry the angle
+   *
+   * @param minVelocity electrical speed, degree per second
+   */
+  bool converged(float minVelocity) const {
+    return mVelocity > minVelocity || mVelocity < -minVelocity;
+  }
+
+ private:
+  float mRs;
+  float mLs;
+  float mFluxSquare;
+  float mGain;  //!< gain over flux^2
+  float mKp;
+  float mKi;
+  float mFluxAlpha;  //!< stator flux, Wb
+  float mFluxBeta;
+  float mAngle;
+  float mPllAngle;
+  float mVelocity;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
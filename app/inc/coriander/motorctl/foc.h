@@ -11,28 +11,47 @@
 
 #include <cstdint>
 
+#include "coriander/base/fixed_point.h"
+
 namespace coriander {
 namespace motorctl {
 namespace foc {
-static inline void clarke(float a, float b, float c, float *alpha,
-                          float *beta) {
+
+/**
+ * @note all transforms are templates over a numeric policy, see
+ *       base::FloatNumeric/Q15Numeric/Q31Numeric. float is the default
+ */
+template <typename N = base::FloatNumeric>
+using Value = typename N::Value;
+
+template <typename N = base::FloatNumeric>
+static inline void clarke(Value<N> a, Value<N> b, Value<N> c, Value<N> *alpha,
+                          Value<N> *beta) {
+  // 1/sqrt(3) * (a + 2b), 2/sqrt(3) is out of Q15/Q31 range
+  const Value<N> k = Value<N>(0.57735026919f);
+  Value<N> t = b * k;
   *alpha = a;
-  *beta = (0.57735026919f * a + 1.15470053838f * b);
+  *beta = a * k + t + t;
 }
 
-static inline void invClarke(float alpha, float beta, float *a, float *b) {
+template <typename N = base::FloatNumeric>
+static inline void invClarke(Value<N> alpha, Value<N> beta, Value<N> *a,
+                             Value<N> *b) {
   *a = alpha;
-  *b = -0.5f * alpha + 0.86602540378f * beta;
+  *b = beta * Value<N>(0.86602540378f) - alpha * Value<N>(0.5f);
 }
 
-static inline void park(float alpha, float beta, float sinTheta, float cosTheta,
-                        float *d, float *q) {
+template <typename N = base::FloatNumeric>
+static inline void park(Value<N> alpha, Value<N> beta, Value<N> sinTheta,
+                        Value<N> cosTheta, Value<N> *d, Value<N> *q) {
   *d = alpha * cosTheta + beta * sinTheta;
-  *q = -alpha * sinTheta + beta * cosTheta;
+  *q = beta * cosTheta - alpha * sinTheta;
 }
 
-static inline void invPark(float d, float q, float sinTheta, float cosTheta,
-                           float *alpha, float *beta) {
+template <typename N = base::FloatNumeric>
+static inline void invPark(Value<N> d, Value<N> q, Value<N> sinTheta,
+                           Value<N> cosTheta, Value<N> *alpha,
+                           Value<N> *beta) {
   *alpha = d * cosTheta - q * sinTheta;
   *beta = d * sinTheta + q * cosTheta;
 }
@@ -45,8 +64,119 @@ static inline void invPark(float d, float q, float sinTheta, float cosTheta,
  * @param du    duty cycle of phase u
  * @param dv    duty cycle of phase v
  * @param dw    duty cycle of phase w
+ * @note fixed-point policies always use min/max injection, float follows
+ *       CONFIG_CORIANDER_SVPWM
+ */
+template <typename N = base::FloatNumeric>
+void SpaceVectorPwm(Value<N> alpha, Value<N> beta, Value<N> *du, Value<N> *dv,
+                    Value<N> *dw);
+
+template <>
+void SpaceVectorPwm<base::FloatNumeric>(float alpha, float beta, float *du,
+                                        float *dv, float *dw);
+
+/**
+ * @brief modulation strategy
+ *
+ * @note magnitudes are in SpaceVectorPwm units, duty = 0.5 + v / 2, so the
+ *       full bus is 2: inscribed circle 2/sqrt(3), six-step fundamental 4/pi,
+ *       hexagon vertex 4/3
+ */
+enum class Modulation : int32_t {
+  Linear = 0,        //!< circle limit at 2/sqrt(3), sinusoidal output
+  OverModulationI,   //!< clip to the hexagon, angle is kept
+  OverModulationII,  //!< hexagon + angle holding, six-step at 4/pi
+};
+
+/**
+ * @brief zero-sequence of the phase voltages
+ *
+ * @note discontinuous modes clamp one phase to a rail in every sector, that
+ *       phase does not switch, about 1/3 less switching loss
+ */
+enum class PwmMode : int32_t {
+  Continuous = 0,  //!< min/max injection, centered svpwm
+  DpwmMin,         //!< lowest phase clamped to the negative rail
+  DpwmMax,         //!< highest phase clamped to the positive rail
+  Dpwm60,          //!< phase of the largest magnitude clamped, DPWM1
+  Dpwm30,          //!< phase of the smaller magnitude clamped, DPWM3
+};
+
+/**
+ * @brief largest voltage vector magnitude worth to request in a mode
+ */
+float maxVoltage(Modulation mode);
+
+/**
+ * @brief Space Vector Pulse Width Modulation with a modulation strategy
+ *
+ * @note duty cycles are always inside [0, 1], reference out of the
+ *       strategy's range is limited
+ */
+void SpaceVectorPwm(Modulation mode, float alpha, float beta, float *du,
+                    float *dv, float *dw);
+
+/**
+ * @brief Space Vector Pulse Width Modulation with a modulation strategy and
+ *        zero-sequence
+ *
+ * @note same fundamental as the Continuous mode, only the common mode of
+ *       the duty cycles differs. Continuous follows CONFIG_CORIANDER_SVPWM
+ *       like the float SpaceVectorPwm, discontinuous modes are min/max
+ */
+void SpaceVectorPwm(Modulation mode, PwmMode pwm, float alpha, float beta,
+                    float *du, float *dv, float *dw);
+
+/**
+ * @brief limit voltage vector to a circle, d-axis takes priority
+ *
+ * @param d   d-axis voltage, limited to [-max, max]
+ * @param q   q-axis voltage, gets what is left of the circle
+ * @return true if saturated, (d, q) is changed
+ */
+bool limitVoltage(float *d, float *q, float max);
+
+/**
+ * @brief pre-distort duty cycles against the dead-time voltage error
+ *
+ * @param alpha    phase current of axis x
+ * @param beta     phase current of axis y
+ * @param deadTime dead time over pwm period
+ * @param band     phase current where deadTime is fully added, the
+ *                 correction is linear inside (-band, band)
+ * @note positive current flows out of the bridge, duty cycles are kept
+ *       inside [0, 1], a phase clamped to 0 or 1 is left alone
+ */
+void compensateDeadTime(float alpha, float beta, float deadTime, float band,
+                        float *du, float *dv, float *dw);
+
+namespace detail {
+/**
+ * @brief reference svpwm, solve sector and dwell times by atan2/sin
+ *
+ * @param Ts  switch period
+ * @param Udc bus voltage, |(alpha, beta)| is clamped to it
+ */
+void svpwm_slow(float alpha, float beta, float Ts, float Udc, float *tu,
+                float *tv, float *tw);
+
+/**
+ * @brief sector and dwell times of svpwm_slow, without the circle limit
+ *
+ * @param Ts switch period
+ * @note (alpha, beta) in units of Udc, valid up to the hexagon
+ */
+void svpwm_sector(float alpha, float beta, float Ts, float *tu, float *tv,
+                  float *tw);
+
+/**
+ * @brief trig-free svpwm based on min/max zero-sequence injection
+ *
+ * @note same output as svpwm_slow, selected by CONFIG_CORIANDER_SVPWM_MINMAX
  */
-void SpaceVectorPwm(float alpha, float beta, float *du, float *dv, float *dw);
+void svpwm_fast(float alpha, float beta, float Ts, float Udc, float *tu,
+                float *tv, float *tw);
+}  // namespace detail
 
 };  // namespace foc
 }  // namespace motorctl
@@ -0,0 +1,73 @@
+/**
+ * @file foc_batch.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-20
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+namespace foc {
+
+/**
+ * @brief foc transforms over n axes at once
+ *
+ * @note structure-of-arrays layout, every argument is an array of n values,
+ *       one per axis. 4 axes are processed per step with SSE/NEON/Helium,
+ *       the rest (and targets without float simd) fall back to scalar code.
+ *       Same results as the scalar transforms in foc.h
+ *
+ * @note only pays off from lanes() axes up. Below that every axis takes the
+ *       scalar tail plus the array bookkeeping, a single axis is slower than
+ *       the transforms in foc.h (see bench_foc_batch.cc), keep using those
+ *       for one axis
+ */
+namespace batch {
+
+/**
+ * @brief simd lanes of float, 1 if no simd available
+ */
+int lanes();
+
+void clarke(const float *a, const float *b, float *alpha, float *beta, int n);
+
+void park(const float *alpha, const float *beta, const float *sinTheta,
+          const float *cosTheta, float *d, float *q, int n);
+
+void invPark(const float *d, const float *q, const float *sinTheta,
+             const float *cosTheta, float *alpha, float *beta, int n);
+
+/**
+ * @brief Space Vector Pulse Width Modulation, min/max injection
+ *
+ * @note same as SpaceVectorPwm<base::FloatNumeric> with
+ *       CONFIG_CORIANDER_SVPWM_MINMAX, |(alpha, beta)| is limited to 1
+ */
+void SpaceVectorPwm(const float *alpha, const float *beta, float *du,
+                    float *dv, float *dw, int n);
+
+/**
+ * @brief PI controllers of n channels
+ *
+ * @note same as Pid with D = 0 and no output ramp, d and q of an axis are
+ *       two channels
+ */
+struct PiArrays {
+  const float *P;      //!< Proportional gain
+  const float *I;      //!< Integral gain
+  const float *limit;  //!< Maximum output value
+  float *integral;     //!< integral of the last call
+  float *errorPrev;    //!< error of the last call
+};
+
+void pi(const PiArrays &pi, const float *error, float Ts, float *output,
+        int n);
+
+}  // namespace batch
+}  // namespace foc
+}  // namespace motorctl
+}  // namespace coriander
@@ -11,8 +11,10 @@
 
 #include <memory>
 
+#include "coriander/motorctl/foc.h"
 #include "coriander/motorctl/ibldc_driver.h"
 #include "coriander/motorctl/ielec_angle_estimator.h"
+#include "coriander/motorctl/iphase_current_estimator.h"
 
 namespace coriander {
 namespace motorctl {
@@ -26,6 +28,119 @@ struct FocMotorDriverBase : public IBldcDriver {
    * @param angle electrical angle of the rotor
    */
   void setVoltageNoSensor(float d, float q, float angle);
+
+  /**
+   * @brief Set the Voltage object, at an angle given by its sin/cos
+   *
+   * @param d duty cycle of d-axis, pointing to the north pole of the magnet
+   * @param q duty cycle of q-axis, ahead of d-axis by 90 degree
+   * @param sinTheta sin of the electrical angle of the rotor
+   * @param cosTheta cos of the electrical angle of the rotor
+   */
+  void setVoltageNoSensor(float d, float q, float sinTheta, float cosTheta);
+
+  void setModulation(foc::Modulation mode) { mModulation = mode; }
+  foc::Modulation getModulation() const { return mModulation; }
+
+  /**
+   * @brief Set the zero-sequence of the svpwm
+   *
+   * @param mode discontinuous mode used above threshold
+   * @param threshold |(d, q)| where mode takes over from Continuous, lower
+   *                  modulation index keeps the centered svpwm for less
+   *                  current ripple
+   */
+  void setPwmMode(foc::PwmMode mode, float threshold) {
+    mPwmMode = mode;
+    mPwmThreshold = threshold;
+  }
+  foc::PwmMode getPwmMode() const { return mPwmMode; }
+
+  /**
+   * @brief Set the dead-time compensation, applied only to the voltage
+   *        following a setPhaseCurrent
+   *
+   * @param deadTime dead time over pwm period, 0 disables compensation
+   * @param currentBand phase current where deadTime is fully compensated
+   */
+  void setDeadTime(float deadTime, float currentBand);
+
+  /**
+   * @brief Set the latest phase current, its polarity drives the dead-time
+   *        compensation
+   *
+   * @param alpha phase current of axis x, from IPhaseCurrentEstimator
+   * @param beta  phase current of axis y, from IPhaseCurrentEstimator
+   */
+  void setPhaseCurrent(float alpha, float beta) {
+    // the band is in amperes of one phase
+    mCurrentAlpha = alpha * IPhaseCurrentEstimator::kAmplitudeScale;
+    mCurrentBeta = beta * IPhaseCurrentEstimator::kAmplitudeScale;
+    mCurrentFresh = true;
+  }
+
+  /**
+   * @brief Drop the phase current of the previous control mode, called on
+   *        mode changes
+   */
+  void resetPhaseCurrent() {
+    mCurrentAlpha = 0.0f;
+    mCurrentBeta = 0.0f;
+    mCurrentFresh = false;
+  }
+
+  /**
+   * @brief Set the supply voltage the duty cycles are given for, see
+   *        MotorCtl_MotorDriver_SupplyVoltage
+   *
+   * @param voltage unit: volt
+   */
+  void setSupplyVoltage(float voltage) {
+    mSupplyVoltage = voltage;
+    setBusVoltage(mBusVoltage);
+  }
+
+  /**
+   * @brief Set the measured dc bus, duty cycles are rescaled from the supply
+   *        voltage to it, keeps the loop gain under bus sag
+   *
+   * @param voltage unit: volt, 0 applies the duty cycles as they are
+   */
+  void setBusVoltage(float voltage);
+
+  /**
+   * @return supply voltage over the measured bus, the duty cycles are
+   *         multiplied by it, 1 without a measurement
+   */
+  float getBusScale() const { return mBusScale; }
+
+  /**
+   * @brief Get the last voltage vector before svpwm, in SpaceVectorPwm units
+   *        of the supply voltage, before the bus rescaling
+   *
+   * @param alpha duty cycle of axis x
+   * @param beta  duty cycle of axis y
+   */
+  void getVoltage(float* alpha, float* beta) const {
+    *alpha = mVoltageAlpha;
+    *beta = mVoltageBeta;
+  }
+
+ private:
+  foc::Modulation mModulation = foc::Modulation::Linear;
+  foc::PwmMode mPwmMode = foc::PwmMode::Continuous;
+  float mPwmThreshold = 0.0f;
+  bool mDiscontinuous = false;
+  float mDeadTime = 0.0f;
+  float mDeadTimeCurrentBand = 0.0f;
+  float mCurrentAlpha = 0.0f;
+  float mCurrentBeta = 0.0f;
+  bool mCurrentFresh = false;
+  float mVoltageAlpha = 0.0f;
+  float mVoltageBeta = 0.0f;
+  float mSupplyVoltage = 0.0f;
+  float mBusVoltage = 0.0f;
+  float mBusScale = 1.0f;
 };
 
 struct FocMotorDriver : public FocMotorDriverBase {
@@ -34,13 +149,25 @@ struct FocMotorDriver : public FocMotorDriverBase {
       : mElecAngleEstimator(elecAngleEstimator) {}
 
   /**
-   * @brief Set the Voltage object
+   * @brief Set the Voltage object, at the estimated angle, d plus the
+   *        injection of the estimator, see IElecAngleEstimator::nextInjection
    *
    * @param d duty cycle of d-axis, pointing to the north pole of the magnet
    * @param q duty cycle of q-axis, ahead of d-axis by 90 degree
    */
   virtual void setVoltage(float d, float q);
 
+  /**
+   * @brief Set the Voltage object, at the angle the phase current was parked
+   *        with, saves reading the angle and its sin/cos a second time
+   *
+   * @param d duty cycle of d-axis, pointing to the north pole of the magnet
+   * @param q duty cycle of q-axis, ahead of d-axis by 90 degree
+   * @param sinTheta sin of the electrical angle of the rotor
+   * @param cosTheta cos of the electrical angle of the rotor
+   */
+  virtual void setVoltage(float d, float q, float sinTheta, float cosTheta);
+
  private:
   std::shared_ptr<IElecAngleEstimator> mElecAngleEstimator;
 };
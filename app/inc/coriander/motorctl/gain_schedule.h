@@ -0,0 +1,49 @@
+/**
+ * @file gain_schedule.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-27
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief piecewise linear gain scale over an operating point(speed, current)
+ *
+ * The scales multiply the fixed pid gains, outside the table the first/last
+ * point holds. An empty table scales by 1.
+ */
+struct GainSchedule {
+  static constexpr int kMaxPoints = 4;
+
+  struct Point {
+    float x;  //!< operating point, compared with |x|
+    float P;  //!< proportional gain scale
+    float I;  //!< integral gain scale
+  };
+
+  GainSchedule();
+
+  /**
+   * @brief copy the table, it ends at the first point whose x does not
+   *        increase
+   */
+  void setup(const Point* points, int n);
+
+  void operator()(float x, float* P, float* I);
+
+  int size() const { return mSize; }
+
+ private:
+  Point mPoints[kMaxPoints];
+  int mSize;
+  int mSegment;  //!< last segment, operating points move slowly
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,95 @@
+/**
+ * @file hfi_elec_angle_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-02
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/motorctl/hfi_observer.h"
+#include "coriander/motorctl/ielec_angle_estimator.h"
+#include "coriander/motorctl/iphase_current_estimator.h"
+#include "coriander/motorctl/sensorless_elec_angle_estimator.h"
+#include "coriander/os/isystick.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Elecangle estimator from standstill without position sensor,
+ *        high frequency injection handing over to the back-EMF observer
+ *
+ * After enable() the angle is found by HfiObserver, polarity included, see
+ * ready(). From MotorCtl_Hfi_BlendSpeed up to twice that speed the angle
+ * blends into the one of SensorlessElecAngleEstimator, above it the
+ * injection stops.
+ */
+struct HfiElecAngleEstimator : public IElecAngleEstimator, public IParamReq {
+  using ISystick = coriander::os::ISystick;
+
+  HfiElecAngleEstimator(
+      std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+      std::shared_ptr<SensorlessElecAngleEstimator> sensorless,
+      std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+      std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept;
+
+  virtual void enable();
+  virtual void disable();
+  virtual void sync();
+  virtual bool enabled();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getElectricalAngle() noexcept;
+  virtual void setVoltage(float alpha, float beta) noexcept;
+  virtual float nextInjection() noexcept;
+  virtual float getInjectionAmplitude() noexcept;
+
+  /**
+   * @brief angle found, polarity included
+   */
+  bool ready() const { return mHfi.ready(); }
+
+  /**
+   * @brief below twice MotorCtl_Hfi_BlendSpeed, the injection is on
+   */
+  bool injecting() const { return !mHfi.tracking(); }
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    constexpr static const ParameterRequireItem items[] = {
+        {"MotorCtl_MotorDriver_PolePair", TypeId::Int32},
+        {"MotorCtl_MotorDriver_SupplyVoltage", TypeId::Float},
+        {"MotorCtl_MotorDriver_Ld", TypeId::Float},
+        {"MotorCtl_MotorDriver_Lq", TypeId::Float},
+        {"MotorCtl_Hfi_Voltage", TypeId::Float},
+        {"MotorCtl_Hfi_PllBandwidth", TypeId::Float},
+        {"MotorCtl_Hfi_PulseVoltage", TypeId::Float},
+        {"MotorCtl_Hfi_PulseDuration", TypeId::Int32},
+        {"MotorCtl_Hfi_BlendSpeed", TypeId::Float},
+        PARAMETER_REQ_EOF};
+
+    return &items[0];
+  }
+
+ private:
+  std::shared_ptr<IPhaseCurrentEstimator> mPhaseCurrentEstimator;
+  std::shared_ptr<SensorlessElecAngleEstimator> mSensorless;
+  std::shared_ptr<Parameter> mParam;
+  std::shared_ptr<ISystick> mSystick;
+  HfiObserver mHfi;
+  float mVoltageScale;  //!< SpaceVectorPwm units to volt
+  float mBlendSpeed;    //!< electrical, degree per second
+  float mWeight;        //!< share of the back-EMF angle
+  uint32_t mTimestamp;
+  bool mSeeded;
+  bool mEnabled;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
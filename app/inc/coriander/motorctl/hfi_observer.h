@@ -0,0 +1,139 @@
+/**
+ * @file hfi_observer.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-02
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief rotor angle of a salient PMSM at standstill and low speed, from the
+ *        current response to a high frequency voltage
+ *
+ * A square wave voltage, toggling on every update, is injected on the
+ * estimated d-axis. Unless Ld == Lq, an angle error turns part of the
+ * current response into the estimated q-axis, which drives a type-II
+ * tracking loop. The difference of two consecutive current steps cancels
+ * the slow fundamental current.
+ *
+ * Saliency repeats every 180 degree, so the magnet polarity is resolved
+ * once after locking: a positive and a negative d-axis pulse, the one
+ * saturating the iron, along the magnet, gives the larger current.
+ *
+ * @note needs Lq > Ld, which holds for interior magnet motors
+ */
+struct HfiObserver {
+  HfiObserver();
+
+  /**
+   * @param Ld d axis inductance, H
+   * @param Lq q axis inductance, H
+   * @param voltage injected square wave amplitude, V
+   * @param bandwidth tracking loop bandwidth, rad/s
+   * @param pulseVoltage polarity pulse amplitude, V
+   * @param pulseDuration polarity pulse length, s
+   */
+  void setup(float Ld, float Lq, float voltage, float bandwidth,
+             float pulseVoltage, float pulseDuration);
+
+  /**
+   * @brief restart from an unknown angle at standstill, polarity included
+   *
+   * @param angle electrical angle to start tracking from, degree
+   */
+  void reset(float angle = 0.0f);
+
+  /**
+   * @brief stop injecting and follow an angle from elsewhere, e.g. a
+   *        back-EMF observer at speed
+   *
+   * @param angle electrical angle, degree
+   * @param velocity electrical speed, degree per second
+   */
+  void track(float angle, float velocity);
+
+  /**
+   * @brief inject again from the tracked angle, its polarity is known
+   */
+  void resume();
+
+  /**
+   * @return float d-axis voltage to apply until the next update, V
+   */
+  float getInjection() const;
+
+  /**
+   * @return float bound of |getInjection()| until the next track(), V
+   */
+  float getInjectionAmplitude() const;
+
+  /**
+   * @brief update from the current after getInjection() was applied
+   *
+   * @param ialpha measured stator current, A
+   * @param ibeta measured stator current, A
+   * @param Ts time since the last update, s
+   */
+  void operator()(float ialpha, float ibeta, float Ts);
+
+  /**
+   * @return float electrical angle, degree in [0, 360)
+   */
+  float getAngle() const { return mAngle; }
+
+  /**
+   * @return float electrical speed, degree per second
+   */
+  float getVelocity() const { return mVelocity; }
+
+  /**
+   * @brief locked and polarity resolved, the angle is usable
+   */
+  bool ready() const { return mState == State::Run || tracking(); }
+
+  bool tracking() const { return mState == State::Track; }
+
+ private:
+  enum class State : uint8_t {
+    Lock,
+    PulsePositive,
+    PulseBack,
+    PulseNegative,
+    PulseReturn,
+    Run,
+    Track,
+  };
+
+  void demodulate(float ialpha, float ibeta, float Ts);
+
+  State mState;
+  float mVoltage;
+  float mDemodGain;  //!< q current step to angle error, rad per A
+  float mKp;
+  float mKi;
+  float mLockTime;
+  float mPulseVoltage;
+  float mPulseDuration;
+  float mTimer;
+  float mPulseCurrent;  //!< d current step of the positive pulse
+  float mPulseStart;    //!< d current before the negative pulse
+  float mSign;          //!< polarity of the injection being applied
+  int mHistory;         //!< current samples since the injection started
+  float mLastAlpha;
+  float mLastBeta;
+  float mLastDeltaAlpha;
+  float mLastDeltaBeta;
+  float mAngle;
+  float mVelocity;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
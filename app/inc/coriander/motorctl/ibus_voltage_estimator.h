@@ -0,0 +1,39 @@
+/**
+ * @file ibus_voltage_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-12
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include "coriander/motorctl/isensor.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief dc bus voltage and power stage temperature, sampled together with
+ *        the phase current
+ *
+ * @note enabled() stays false on boards without the channels, users fall back
+ *       to MotorCtl_MotorDriver_SupplyVoltage
+ */
+struct IBusVoltageEstimator : public ISensor {
+  virtual ~IBusVoltageEstimator() = default;
+
+  /**
+   * @return unit: volt, 0 or below until the first conversion
+   */
+  virtual float getBusVoltage() = 0;
+
+  /**
+   * @return unit: degree
+   */
+  virtual float getTemperature() = 0;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -23,6 +23,33 @@ struct IElecAngleEstimator : public ISensor {
    * @return degree
    */
   virtual float getElectricalAngle() noexcept = 0;
+
+  /**
+   * @brief voltage applied until the next sync, for estimators observing the
+   *        motor model, ignored by sensors
+   *
+   * @param alpha duty cycle of axis x, see FocMotorDriverBase::getVoltage
+   * @param beta  duty cycle of axis y
+   */
+  virtual void setVoltage(float /*alpha*/, float /*beta*/) noexcept {}
+
+  /**
+   * @brief d-axis voltage added on top of the current loop output, for
+   *        estimators injecting a signal, 0 for sensors
+   *
+   * @note called once per current loop update, right before the voltage is
+   *       applied, estimators advance their injection here
+   * @return float duty cycle, see FocMotorDriver::setVoltage
+   */
+  virtual float nextInjection() noexcept { return 0.0f; }
+
+  /**
+   * @brief bound of |nextInjection()| until the next sync, the current loop
+   *        keeps it free in its voltage limit
+   *
+   * @return float duty cycle, 0 for sensors
+   */
+  virtual float getInjectionAmplitude() noexcept { return 0.0f; }
 };
 
 }  // namespace motorctl
@@ -18,5 +18,11 @@ struct IEncoder : public ISensor {
   virtual unsigned getEncoderCountPerRound() = 0;
   virtual int getOverflowCount() = 0;
 };
+
+/**
+ * @brief encoder on the load side of a gear, a type of its own so that both
+ *        encoders can be bound
+ */
+struct ILoadEncoder : public IEncoder {};
 }  // namespace motorctl
 }  // namespace coriander
@@ -23,7 +23,17 @@ struct IMechAngleEstimator : public ISensor {
    * @return degree
    */
   virtual float getMechanicalAngle() noexcept = 0;
+
+  /**
+   * @brief the angle no longer follows the rotor, position control stops
+   */
+  virtual bool lost() noexcept { return false; }
 };
 
+/**
+ * @brief mechanical angle of the load, behind the gear
+ */
+struct ILoadMechAngleEstimator : public IMechAngleEstimator {};
+
 }  // namespace motorctl
 }  // namespace coriander
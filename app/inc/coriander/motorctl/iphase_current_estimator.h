@@ -15,10 +15,18 @@ namespace coriander {
 namespace motorctl {
 
 struct IPhaseCurrentEstimator : public ISensor {
+  /**
+   * @brief getPhaseCurrent() times this is the amplitude of one phase, for
+   *        models in amperes of one phase, the current loop keeps the
+   *        unscaled values
+   */
+  static constexpr float kAmplitudeScale = 2.0f / 3.0f;
+
   virtual ~IPhaseCurrentEstimator() = default;
 
   /**
-   * @brief Get the Phase Current object
+   * @brief Get the Phase Current object, clarke without the 2/3 factor,
+   *        |(alpha, beta)| is 3/2 of the amplitude of one phase
    *
    * @param alpha
    * @param beta
@@ -23,6 +23,14 @@ struct IVelocityEstimator : public ISensor {
    * @return float RPM(Revolutions Per Minute)
    */
   virtual float getVelocity() = 0;
+
+  /**
+   * @brief torque producing q current commanded until the next sync, for
+   *        estimators on the mechanical model, ignored by the others
+   *
+   * @param iq unit: A
+   */
+  virtual void setTorqueCurrent(float /*iq*/) {}
 };
 
 }  // namespace motorctl
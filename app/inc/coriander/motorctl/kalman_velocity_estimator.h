@@ -0,0 +1,104 @@
+/**
+ * @file kalman_velocity_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-29
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/base/matrix.h"
+#include "coriander/motorctl/imech_angle_estimator.h"
+#include "coriander/motorctl/ivelocity_estimator.h"
+#include "coriander/os/isystick.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Velocity Estimator based on a Kalman filter over the mechanical
+ *        model J * dw/dt = Kt * Iq - load
+ *
+ * State is (angle, velocity, load torque), the torque current of the
+ * velocity loop drives the model and the encoder angle corrects it. The
+ * acceleration follows from the model, so velocity does not lag when the
+ * current steps, and the load torque is left for feed-forward. Updated on every sync with the microsecond systick.
+ *
+ * @note a zero torque constant drops the current input, the load torque then
+ *       carries the whole acceleration like a constant acceleration filter.
+ */
+struct KalmanVelocityEstimator : public IVelocityEstimator, public IParamReq {
+  using ISystick = coriander::os::ISystick;
+  using State = base::Vector<3>;
+  using Covariance = base::Matrix<3, 3>;
+
+  explicit KalmanVelocityEstimator(
+      std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+      std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+      std::shared_ptr<IParamReqValidator> paramReqValidator);
+  virtual void enable();
+  virtual void disable();
+  virtual bool enabled();
+  virtual void sync();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getVelocity();
+  virtual void setTorqueCurrent(float iq) { mIq = iq; }
+
+  /**
+   * @brief filtered mechanical angle
+   *
+   * @return float degree, multi-turn like IMechAngleEstimator
+   */
+  float getPosition() const;
+
+  /**
+   * @return float RPM per second
+   */
+  float getAcceleration() const;
+
+  /**
+   * @return float Nm, positive against the positive direction
+   */
+  float getLoadTorque() const { return mState(2, 0); }
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    using coriander::base::operator""_hash;
+    using Type = coriander::base::TypeId;
+    static const ParameterRequireItem requiredParam[] = {
+        {"MotorCtl_MotorDriver_TorqueConstant", Type::Float},
+        {"MotorCtl_MotorDriver_Inertia", Type::Float},
+        {"MotorCtl_SpeedEstimator_KalmanPositionNoise", Type::Float},
+        {"MotorCtl_SpeedEstimator_KalmanAccelerationNoise", Type::Float},
+        {"MotorCtl_SpeedEstimator_KalmanLoadNoise", Type::Float},
+        PARAMETER_REQ_EOF};
+    return requiredParam;
+  }
+
+ private:
+  void predict(float dt, float iq);
+  void correct(float angle);
+
+  std::shared_ptr<IMechAngleEstimator> mMechAngleEstimator;
+  std::shared_ptr<Parameter> mParam;
+  std::shared_ptr<ISystick> mSystick;
+  float mTorqueGain;         //!< Kt / J
+  float mLoadGain;           //!< 1 / J
+  float mAccelerationNoise;  //!< spectral density, (rad/s^2)^2 / Hz
+  float mLoadNoise;          //!< spectral density, Nm^2 / Hz
+  float mPositionNoise;      //!< variance, rad^2
+  float mIq;
+  State mState;  //!< rad, rad/s, Nm
+  Covariance mCovariance;
+  uint32_t mTimestamp;
+  bool mEnabled;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
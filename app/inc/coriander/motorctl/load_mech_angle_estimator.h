@@ -0,0 +1,60 @@
+/**
+ * @file load_mech_angle_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/motorctl/iencoder.h"
+#include "coriander/motorctl/imech_angle_estimator.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Mechanical angle of the load, based on the load side encoder
+ *
+ * Multi-turn, in load degrees. The zero is calibrated on its own, the gear
+ * decides the relation to the motor angle.
+ */
+struct LoadMechAngleEstimator : public ILoadMechAngleEstimator,
+                                public IParamReq {
+  LoadMechAngleEstimator(
+      std::shared_ptr<ILoadEncoder> encoder, std::shared_ptr<Parameter> param,
+      std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept;
+
+  virtual void enable();
+  virtual void disable();
+  virtual bool enabled();
+  virtual void sync();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getMechanicalAngle() noexcept;
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    using Type = coriander::base::TypeId;
+    static const ParameterRequireItem requiredParam[] = {
+        {"MotorCtl_Calibrate_CaliLoadAngleOffset", Type::Float},
+        {"Sensor_LoadEncoder_Reverse", Type::Int32},
+        PARAMETER_REQ_EOF};
+    return requiredParam;
+  }
+
+ private:
+  std::shared_ptr<ILoadEncoder> mEncoder;
+  std::shared_ptr<Parameter> mParam;
+  float mRawMechAngle;
+  float mMechAngleOffset;
+  float mDirection;
+  bool mNeedCalibrate;
+};
+}  // namespace motorctl
+}  // namespace coriander
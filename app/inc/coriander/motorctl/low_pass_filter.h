@@ -9,26 +9,46 @@
  */
 #pragma once
 
+#include "coriander/base/fixed_point.h"
+
 namespace coriander {
 namespace motorctl {
 
+namespace detail {
+/**
+ * @tparam N numeric policy, see base::FloatNumeric
+ */
+template <typename N>
 struct LowPassFilter {
  public:
+  using Value = typename N::Value;
+  using Gain = typename N::Gain;
+
   /**
    * @param Tf - Low pass filter time constant
    */
-  explicit LowPassFilter(float Tf);
+  explicit LowPassFilter(Gain Tf);
   ~LowPassFilter() = default;
 
-  float operator() (float x, float Ts);
+  Value operator()(Value x, Gain Ts);
 
   void clear();
 
-  float Tf;  //!< Low pass filter time constant
+  /**
+   * @brief restart at y instead of ramping up from zero
+   */
+  void reset(Value y);
+
+  Gain Tf;  //!< Low pass filter time constant
 
  protected:
-  float y_prev;  //!< filtered value in previous execution step
+  Value y_prev;  //!< filtered value in previous execution step
 };
+}  // namespace detail
+
+using LowPassFilter = detail::LowPassFilter<base::FloatNumeric>;
+using LowPassFilterQ15 = detail::LowPassFilter<base::Q15Numeric>;
+using LowPassFilterQ31 = detail::LowPassFilter<base::Q31Numeric>;
 
 }  // namespace motorctl
 }  // namespace coriander
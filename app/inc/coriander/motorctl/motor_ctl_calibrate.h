@@ -14,11 +14,13 @@
 #include "coriander/base/ilogger.h"
 #include "coriander/iboard_event.h"
 #include "coriander/motorctl/ibldc_driver.h"
+#include "coriander/motorctl/ibus_voltage_estimator.h"
 #include "coriander/motorctl/ielec_angle_estimator.h"
 #include "coriander/motorctl/imech_angle_estimator.h"
 #include "coriander/motorctl/imotorctl.h"
 #include "coriander/motorctl/iphase_current_estimator.h"
 #include "coriander/motorctl/ivelocity_estimator.h"
+#include "coriander/motorctl/low_pass_filter.h"
 #include "coriander/motorctl/sensor_handler.h"
 #include "coriander/os/isystick.h"
 #include "coriander/parameter_requirements.h"
@@ -44,6 +46,7 @@ struct MotorCtlCalibrate : public IMotorCtl, public IParamReq {
   MotorCtlCalibrate(
       std::shared_ptr<IBldcDriver> motor,
       std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+      std::shared_ptr<IBusVoltageEstimator> busVoltageEstimator,
       std::shared_ptr<IElecAngleEstimator> elecAngleEstimator,
       std::shared_ptr<Parameter> param, std::shared_ptr<IBoardEvent> boardEvent,
       std::shared_ptr<ISystick> systick, std::shared_ptr<ILogger> logger,
@@ -69,10 +72,18 @@ struct MotorCtlCalibrate : public IMotorCtl, public IParamReq {
   void seekCalibrateItem();
   void enterState(State state);
   void exitState();
+  /**
+   * @brief follow the measured bus with the calibration duty cycle
+   *
+   * @param timestamp unit: ms
+   */
+  void updateBusVoltage(uint32_t timestamp);
+  uint16_t calibrateDutyCycle(float busVoltage) const;
 
  private:
   std::shared_ptr<IBldcDriver> mMotor;
   std::shared_ptr<IPhaseCurrentEstimator> mPhaseCurrentEstimator;
+  std::shared_ptr<IBusVoltageEstimator> mBusVoltageEstimator;
   std::shared_ptr<IElecAngleEstimator> mElecAngleEstimator;
   std::shared_ptr<Parameter> mParam;
   std::shared_ptr<IBoardEvent> mBoardEvent;
@@ -86,6 +97,9 @@ struct MotorCtlCalibrate : public IMotorCtl, public IParamReq {
 
   // runtime variables
   SensorHandler mSensorHandler;
+  LowPassFilter mBusVoltageLpf;
+  uint32_t mBusTimestamp;
+  uint16_t mDutyCycle;
   uint32_t startTimestamp;
   State mState = State::Calibrate_Idle;
 };
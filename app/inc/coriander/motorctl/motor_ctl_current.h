@@ -12,13 +12,17 @@
 #include <memory>
 #include <utility>
 
+#include "coriander/motorctl/biquad_filter.h"
+#include "coriander/motorctl/deadbeat_controller.h"
+#include "coriander/motorctl/discrete_pid.h"
 #include "coriander/motorctl/duration_estimator.h"
 #include "coriander/motorctl/foc_motor_driver.h"
+#include "coriander/motorctl/gain_schedule.h"
+#include "coriander/motorctl/ibus_voltage_estimator.h"
 #include "coriander/motorctl/ielec_angle_estimator.h"
 #include "coriander/motorctl/imotorctl.h"
 #include "coriander/motorctl/iphase_current_estimator.h"
 #include "coriander/motorctl/low_pass_filter.h"
-#include "coriander/motorctl/pid.h"
 #include "coriander/motorctl/sensor_handler.h"
 #include "coriander/parameter_requirements.h"
 
@@ -31,8 +35,17 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
   using DurationTimeout =
       detail::DurationExpired<detail::DurationEstimatorUnit::US>;
 
+  /**
+   * @brief current controller, see MotorCtl_CurrCtl_Strategy
+   */
+  enum class Strategy {
+    Pi = 0,        //!< filtered feedback, pid pair
+    Deadbeat = 1,  //!< unfiltered feedback, DeadbeatController
+  };
+
   explicit MotorCtlCurrent(
       std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+      std::shared_ptr<IBusVoltageEstimator> busVoltageEstimator,
       std::shared_ptr<Parameter> parameters,
       std::shared_ptr<FocMotorDriver> focMotorDriver,
       std::shared_ptr<IElecAngleEstimator> elecAngleEstimator,
@@ -40,6 +53,7 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
       std::unique_ptr<DurationTimeout> durationTimeout,
       std::shared_ptr<IParamReqValidator> paramReqValidator)
       : mPhaseCurrentEstimator{phaseCurrentEstimator},
+        mBusVoltageEstimator{busVoltageEstimator},
         mParams{parameters},
         mFocMotorDriver{focMotorDriver},
         mElecAngleEstimator(elecAngleEstimator),
@@ -51,7 +65,18 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
         mPidQ{0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
         mIdLpf(0.0f),
         mIqLpf(0.0f),
-        mSensorHandler{mPhaseCurrentEstimator, elecAngleEstimator} {
+        mBusVoltageLpf(0.0f),
+        mTemperatureLpf(0.0f),
+        mVoltageLimit(0.0f),
+        mModulationIndex(0.0f),
+        mSupplyVoltage(0.0f),
+        mStrategy(Strategy::Pi),
+        mPublishPeriods(0),
+        mPublishCounter(0),
+        mBusSampled(false),
+        mInvalidConfig(false),
+        mSensorHandler{mPhaseCurrentEstimator, mBusVoltageEstimator,
+                       elecAngleEstimator} {
     paramReqValidator->addParamReq(this);
   }
   virtual void start();
@@ -61,7 +86,12 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
   virtual void emergencyStop();
   virtual bool fatalError();
 
-  virtual void setTargetCurrent(float Iq, float Id);
+  virtual void setTargetCurrent(float id, float iq);
+
+  /**
+   * @brief |Udq| of the last output over the voltage limit, 1: saturated
+   */
+  float getModulationIndex() const { return mModulationIndex; }
 
   virtual const ParameterRequireItem* requiredParameters() const {
     using Type = coriander::base::TypeId;
@@ -73,6 +103,35 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
         {"MotorCtl_CurrCtl_PidLimit", Type::Float},
         {"MotorCtl_CurrCtl_Freq", Type::Int32},
         {"MotorCtl_CurrCtl_Lpf_TimeConstant", Type::Float},
+        {"MotorCtl_CurrCtl_Modulation", Type::Int32},
+        {"MotorCtl_CurrCtl_PwmMode", Type::Int32},
+        {"MotorCtl_CurrCtl_PwmModeThreshold", Type::Float},
+        {"MotorCtl_CurrCtl_Strategy", Type::Int32},
+        {"MotorCtl_CurrCtl_DeadbeatSpeedBandwidth", Type::Float},
+        {"MotorCtl_CurrCtl_Sched0_Current", Type::Float},
+        {"MotorCtl_CurrCtl_Sched0_PScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched0_IScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched1_Current", Type::Float},
+        {"MotorCtl_CurrCtl_Sched1_PScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched1_IScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched2_Current", Type::Float},
+        {"MotorCtl_CurrCtl_Sched2_PScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched2_IScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched3_Current", Type::Float},
+        {"MotorCtl_CurrCtl_Sched3_PScale", Type::Float},
+        {"MotorCtl_CurrCtl_Sched3_IScale", Type::Float},
+        {"MotorCtl_CurrCtl_FbFilter0_Type", Type::Int32},
+        {"MotorCtl_CurrCtl_FbFilter0_Frequency", Type::Float},
+        {"MotorCtl_CurrCtl_FbFilter0_Q", Type::Float},
+        {"MotorCtl_CurrCtl_FbFilter0_Gain", Type::Float},
+        {"MotorCtl_MotorDriver_DeadTime", Type::Float},
+        {"MotorCtl_MotorDriver_DeadTimeCurrentBand", Type::Float},
+        {"MotorCtl_MotorDriver_SupplyVoltage", Type::Float},
+        {"MotorCtl_MotorDriver_Rs", Type::Float},
+        {"MotorCtl_MotorDriver_Ld", Type::Float},
+        {"MotorCtl_MotorDriver_Lq", Type::Float},
+        {"MotorCtl_MotorDriver_FluxLinkage", Type::Float},
+        {"MotorCtl_MotorDriver_BusLpf_TimeConstant", Type::Float},
         {"MotorCtl_General_TargetCurrentD_RT", Type::Float},
         {"MotorCtl_General_TargetCurrentQ_RT", Type::Float},
         PARAMETER_REQ_EOF,
@@ -81,7 +140,27 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
   }
 
  private:
+  /**
+   * @brief deadbeat output in duty cycles, limited and advanced to the angle
+   *        of the sample
+   */
+  void deadbeat(float currId, float currIq, float angle, float Ts,
+                float limit, float* outputUd, float* outputUq);
+
+  /**
+   * @brief limit of |Udq| this period, duty cycle, holds after the bus
+   *        rescaling of the driver, what the estimator injects on top is
+   *        kept free
+   */
+  float voltageLimit();
+
+  /**
+   * @brief filter the bus sample of this period, hand it to the driver
+   */
+  void updateBusVoltage(float Ts);
+
   std::shared_ptr<IPhaseCurrentEstimator> mPhaseCurrentEstimator;
+  std::shared_ptr<IBusVoltageEstimator> mBusVoltageEstimator;
   std::shared_ptr<Parameter> mParams;
   std::shared_ptr<FocMotorDriver> mFocMotorDriver;
   std::shared_ptr<IElecAngleEstimator> mElecAngleEstimator;
@@ -93,10 +172,24 @@ struct MotorCtlCurrent : public IMotorCtl, public IParamReq {
   float mTargetIq;
 
   // runtime vars
-  Pid mPidD;
-  Pid mPidQ;
+  DiscretePid mPidD;
+  DiscretePid mPidQ;
   LowPassFilter mIdLpf;
   LowPassFilter mIqLpf;
+  BiquadChain mIdFilter;
+  BiquadChain mIqFilter;
+  LowPassFilter mBusVoltageLpf;
+  LowPassFilter mTemperatureLpf;
+  GainSchedule mGainSchedule;
+  float mVoltageLimit;
+  float mModulationIndex;
+  float mSupplyVoltage;
+  Strategy mStrategy;
+  DeadbeatController mDeadbeat;
+  uint32_t mPublishPeriods;  //!< control periods between Sensor_Motor_*_RT
+  uint32_t mPublishCounter;
+  bool mBusSampled;
+  bool mInvalidConfig;  //!< a parameter out of range, see fatalError()
   SensorHandler mSensorHandler;
 };  // namespace motorctl
 }  // namespace motorctl
@@ -0,0 +1,125 @@
+/**
+ * @file motor_ctl_dual_position.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "coriander/application/diagnosis.h"
+#include "coriander/motorctl/backlash_estimator.h"
+#include "coriander/motorctl/discrete_pid.h"
+#include "coriander/motorctl/duration_estimator.h"
+#include "coriander/motorctl/imech_angle_estimator.h"
+#include "coriander/motorctl/low_pass_filter.h"
+#include "coriander/motorctl/motor_ctl_velocity.h"
+#include "coriander/motorctl/sensor_handler.h"
+#include "coriander/motorctl/trajectory.h"
+#include "coriander/parameter_requirements.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief position control of the load behind a gear, with encoders on both
+ *        sides
+ *
+ * The target is in load degrees. The position loop closes on the motor
+ * angle minus the gear twist predicted by BacklashEstimator, the remaining
+ * difference to the load encoder is added through a low pass of
+ * MotorCtl_DualPosCtl_Lpf_TimeConstant. The velocity and current loops stay
+ * on the motor, so the gap does not enter the fast loops, and the load
+ * encoder still decides where the load ends up. The predicted twist jumps by
+ * the backlash when the torque reverses, which drives the motor across the
+ * gap at once instead of through the slow correction.
+ *
+ * Loop gains and profile limits are the MotorCtl_PosCtl ones, in motor
+ * units. A correction beyond MotorCtl_DualPosCtl_MaxDeviation is a slipping
+ * coupling or a broken load encoder, MotorOuterPosSensor is reported as
+ * Error and the mode stops with a fatal error.
+ */
+struct MotorCtlDualPosition : public IMotorCtl, public IParamReq {
+  using DurationTimeout = DurationExpired<DurationEstimatorUnit::US>;
+  using Duration = DurationEstimator<DurationEstimatorType::OneShot,
+                                     DurationEstimatorUnit::US>;
+  using Diagnosis = application::Diagnosis;
+
+  MotorCtlDualPosition(
+      std::shared_ptr<MotorCtlVelocity> motorCtlVelocity,
+      std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+      std::shared_ptr<ILoadMechAngleEstimator> loadAngleEstimator,
+      std::shared_ptr<Diagnosis> diagnosis,
+      std::unique_ptr<Duration> durationEstimator,
+      std::unique_ptr<DurationTimeout> durationTimeout,
+      std::shared_ptr<Parameter> parameters,
+      std::shared_ptr<IParamReqValidator> paramReqValidator);
+
+  virtual void start();
+  virtual void stop();
+  virtual void loop();
+
+  virtual void emergencyStop();
+  virtual bool fatalError();
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    using Type = coriander::base::TypeId;
+    static const ParameterRequireItem items[] = {
+        {"MotorCtl_PosCtl_PidP", Type::Float},
+        {"MotorCtl_PosCtl_PidI", Type::Float},
+        {"MotorCtl_PosCtl_PidD", Type::Float},
+        {"MotorCtl_PosCtl_PidOutputRamp", Type::Float},
+        {"MotorCtl_PosCtl_PidLimit", Type::Float},
+        {"MotorCtl_PosCtl_Freq", Type::Int32},
+        {"MotorCtl_General_TargetPosition_RT", Type::Float},
+        {"MotorCtl_PosCtl_TrajVelocity", Type::Float},
+        {"MotorCtl_PosCtl_TrajAcceleration", Type::Float},
+        {"MotorCtl_PosCtl_TrajJerk", Type::Float},
+        {"MotorCtl_DualPosCtl_GearRatio", Type::Float},
+        {"MotorCtl_DualPosCtl_Lpf_TimeConstant", Type::Float},
+        {"MotorCtl_DualPosCtl_EngageCurrent", Type::Float},
+        {"MotorCtl_DualPosCtl_Forgetting", Type::Float},
+        {"MotorCtl_DualPosCtl_Backlash", Type::Float},
+        {"MotorCtl_DualPosCtl_Compliance", Type::Float},
+        {"MotorCtl_DualPosCtl_MaxDeviation", Type::Float},
+        PARAMETER_REQ_EOF};
+    return items;
+  }
+
+ protected:
+  /**
+   * @return load angle seen by the position loop, load degree
+   */
+  float feedback(float Ts);
+
+  std::shared_ptr<MotorCtlVelocity> mMotorCtlVelocity;
+  std::shared_ptr<IMechAngleEstimator> mMechAngleEstimator;
+  std::shared_ptr<ILoadMechAngleEstimator> mLoadAngleEstimator;
+  std::shared_ptr<Diagnosis> mDiagnosis;
+  std::shared_ptr<Parameter> mParameters;
+  std::unique_ptr<Duration> mDurationEstimator;
+  std::unique_ptr<DurationTimeout> mDurationTimeout;
+
+  // parameters
+  float mTargetPosition;  //!< load degree
+  float mGearRatio;       //!< motor turns per load turn
+  float mMaxDeviation;    //!< load degree
+
+  // runtime vars
+  SensorHandler mSensorHandler;
+  DiscretePid mMechAnglePid;
+  LowPassFilter mResidualLpf;
+  BacklashEstimator mBacklashEstimator;
+  Trajectory mTrajectory;
+  Diagnosis::DeviceStatus mStatus;
+  bool mUseTrajectory;
+  bool mTrajectoryStarted;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -13,11 +13,13 @@
 #include <memory>
 #include <utility>
 
+#include "coriander/motorctl/discrete_pid.h"
 #include "coriander/motorctl/duration_estimator.h"
 #include "coriander/motorctl/imech_angle_estimator.h"
 #include "coriander/motorctl/low_pass_filter.h"
 #include "coriander/motorctl/motor_ctl_velocity.h"
 #include "coriander/motorctl/sensor_handler.h"
+#include "coriander/motorctl/trajectory.h"
 #include "coriander/parameter_requirements.h"
 
 namespace coriander {
@@ -40,7 +42,9 @@ struct MotorCtlPosition : public IMotorCtl, public IParamReq {
         mDurationTimeout{std::move(durationTimeout)},
         mSensorHandler{mMechAngleEstimator},
         mMechAnglePid(0.0f, 0.0f, 0.0f, 0.0f, 0.0f),
-        mMechLpf(0.0f) {
+        mMechLpf(0.0f),
+        mUseTrajectory(false),
+        mTrajectoryStarted(false) {
     paramReqValidator->addParamReq(this);
   }
 
@@ -62,6 +66,9 @@ struct MotorCtlPosition : public IMotorCtl, public IParamReq {
         {"MotorCtl_PosCtl_Freq", Type::Int32},
         {"MotorCtl_General_TargetPosition_RT", Type::Float},
         {"MotorCtl_PosCtl_Lpf_TimeConstant", Type::Float},
+        {"MotorCtl_PosCtl_TrajVelocity", Type::Float},
+        {"MotorCtl_PosCtl_TrajAcceleration", Type::Float},
+        {"MotorCtl_PosCtl_TrajJerk", Type::Float},
         PARAMETER_REQ_EOF};
     return items;
   }
@@ -78,8 +85,11 @@ struct MotorCtlPosition : public IMotorCtl, public IParamReq {
 
   // runtime vars
   SensorHandler mSensorHandler;
-  Pid mMechAnglePid;
+  DiscretePid mMechAnglePid;
   LowPassFilter mMechLpf;
+  Trajectory mTrajectory;
+  bool mUseTrajectory;
+  bool mTrajectoryStarted;
 };
 
 }  // namespace motorctl
@@ -0,0 +1,120 @@
+/**
+ * @file motor_ctl_position_direct.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-24
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "coriander/motorctl/discrete_pid.h"
+#include "coriander/motorctl/duration_estimator.h"
+#include "coriander/motorctl/imech_angle_estimator.h"
+#include "coriander/motorctl/imotorctl.h"
+#include "coriander/motorctl/low_pass_filter.h"
+#include "coriander/motorctl/motor_ctl_current.h"
+#include "coriander/motorctl/sensor_handler.h"
+#include "coriander/motorctl/trajectory.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief position control straight to q current(P-PI)
+ *
+ * One loop runs every MotorCtl_PosDirectCtl_Divider current loop periods:
+ * position error -> P -> velocity target, velocity error -> PI -> Iq. The
+ * velocity is differentiated from the mechanical angle at the same rate,
+ * there is no velocity loop with its own timer and filter in between.
+ */
+struct MotorCtlPositionDirect : public IMotorCtl, public IParamReq {
+  using DurationEstimator =
+      detail::DurationEstimator<detail::DurationEstimatorType::OneShot,
+                                detail::DurationEstimatorUnit::US>;
+  using DurationTimeout =
+      detail::DurationExpired<detail::DurationEstimatorUnit::US>;
+
+  MotorCtlPositionDirect(
+      std::shared_ptr<MotorCtlCurrent> motorCtlCurrent,
+      std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+      std::unique_ptr<DurationEstimator> durationEstimator,
+      std::unique_ptr<DurationTimeout> durationTimeout,
+      std::shared_ptr<Parameter> parameters,
+      std::shared_ptr<IParamReqValidator> paramReqValidator)
+      : mMotorCtlCurrent{motorCtlCurrent},
+        mMechAngleEstimator{mechAngleEstimator},
+        mParameters{parameters},
+        mDurationEstimator{std::move(durationEstimator)},
+        mDurationTimeout{std::move(durationTimeout)},
+        mTargetPosition(0.0f),
+        mPositionP(0.0f),
+        mVelocityLimit(0.0f),
+        mAccelerationFeedForward(0.0f),
+        mSensorHandler{mMechAngleEstimator},
+        mVelocityPid{0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+        mVelocityLpf(0.0f),
+        mUseTrajectory(false),
+        mStarted(false),
+        mMechAnglePrev(0.0f) {
+    paramReqValidator->addParamReq(this);
+  }
+
+  virtual void start();
+  virtual void stop();
+  virtual void loop();
+
+  virtual void emergencyStop();
+  virtual bool fatalError();
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    using Type = coriander::base::TypeId;
+    static const ParameterRequireItem items[] = {
+        {"MotorCtl_PosDirectCtl_PosP", Type::Float},
+        {"MotorCtl_PosDirectCtl_VelP", Type::Float},
+        {"MotorCtl_PosDirectCtl_VelI", Type::Float},
+        {"MotorCtl_PosDirectCtl_VelLimit", Type::Float},
+        {"MotorCtl_PosDirectCtl_CurrLimit", Type::Float},
+        {"MotorCtl_PosDirectCtl_Divider", Type::Int32},
+        {"MotorCtl_PosDirectCtl_Lpf_TimeConstant", Type::Float},
+        {"MotorCtl_CurrCtl_Freq", Type::Int32},
+        {"MotorCtl_General_TargetPosition_RT", Type::Float},
+        {"MotorCtl_PosCtl_TrajVelocity", Type::Float},
+        {"MotorCtl_PosCtl_TrajAcceleration", Type::Float},
+        {"MotorCtl_PosCtl_TrajJerk", Type::Float},
+        {"MotorCtl_SpeedCtl_AccelerationFeedForward", Type::Float},
+        PARAMETER_REQ_EOF};
+    return items;
+  }
+
+ protected:
+  std::shared_ptr<MotorCtlCurrent> mMotorCtlCurrent;
+  std::shared_ptr<IMechAngleEstimator> mMechAngleEstimator;
+  std::shared_ptr<Parameter> mParameters;
+  std::unique_ptr<DurationEstimator> mDurationEstimator;
+  std::unique_ptr<DurationTimeout> mDurationTimeout;
+
+  // parameters
+  float mTargetPosition;
+  float mPositionP;
+  float mVelocityLimit;
+  float mAccelerationFeedForward;
+
+  // runtime vars
+  SensorHandler mSensorHandler;
+  DiscretePid mVelocityPid;
+  LowPassFilter mVelocityLpf;
+  Trajectory mTrajectory;
+  bool mUseTrajectory;
+  bool mStarted;
+  float mMechAnglePrev;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -12,12 +12,17 @@
 #include <memory>
 #include <utility>
 
+#include "coriander/motorctl/biquad_filter.h"
+#include "coriander/motorctl/discrete_pid.h"
+#include "coriander/motorctl/disturbance_observer.h"
 #include "coriander/motorctl/duration_estimator.h"
+#include "coriander/motorctl/field_weakening.h"
+#include "coriander/motorctl/gain_schedule.h"
 #include "coriander/motorctl/imotorctl.h"
 #include "coriander/motorctl/ivelocity_estimator.h"
 #include "coriander/motorctl/low_pass_filter.h"
 #include "coriander/motorctl/motor_ctl_current.h"
-#include "coriander/motorctl/pid.h"
+#include "coriander/motorctl/mtpa.h"
 #include "coriander/motorctl/sensor_handler.h"
 #include "coriander/parameter_requirements.h"
 #include "coriander/parameters.h"
@@ -46,6 +51,10 @@ struct MotorCtlVelocity : public IMotorCtl, public IParamReq {
         mDurationEstimator{std::move(durationEstimator)},
         mDurationTimeout{std::move(durationTimeout)},
         mMotorCtlCurrent{motorCtlCurrent},
+        mTargetAcceleration{0.0f},
+        mAccelerationFeedForward{0.0f},
+        mCurrentLimit{0.0f},
+        mLastTargetIq{0.0f},
         mSensorHandler{mVelocityEstimator},
         mVelocityPid{0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
         mVelocityLpf(0.0f) {
@@ -59,13 +68,31 @@ struct MotorCtlVelocity : public IMotorCtl, public IParamReq {
   virtual void emergencyStop();
   virtual bool fatalError();
 
-  void setTargetVelocity(float velocityInRpm);
+  /**
+   * @brief Set the Target Velocity object
+   *
+   * @param velocityInRpm
+   * @param accelerationInRpmPerSecond - planned acceleration, turned into q
+   *        current by MotorCtl_SpeedCtl_AccelerationFeedForward
+   */
+  void setTargetVelocity(float velocityInRpm,
+                         float accelerationInRpmPerSecond = 0.0f);
 
+  /**
+   * @brief torque demand of the last period, q current before mtpa
+   */
+  float getTorqueCurrent() const { return mLastTargetIq; }
+
+  /**
+   * @note MotorCtl_FieldWeakening_*, the Ld, Lq, FluxLinkage of mtpa and
+   *       the Inertia, TorqueConstant, DisturbanceObserverBandwidth of the
+   *       load torque observer are optional, those features are off without
+   *       them
+   */
   virtual const ParameterRequireItem* requiredParameters() const {
     using Type = coriander::base::TypeId;
     static const ParameterRequireItem items[] = {
         {"MotorCtl_General_TargetVelocity_RT", Type::Float},
-        {"MotorCtl_MotorDriver_SupplyVoltage", Type::Float},
         {"MotorCtl_SpeedCtl_PidP", Type::Float},
         {"MotorCtl_SpeedCtl_PidI", Type::Float},
         {"MotorCtl_SpeedCtl_PidD", Type::Float},
@@ -73,6 +100,35 @@ struct MotorCtlVelocity : public IMotorCtl, public IParamReq {
         {"MotorCtl_SpeedCtl_PidLimit", Type::Float},
         {"MotorCtl_SpeedCtl_Freq", Type::Int32},
         {"MotorCtl_SpeedCtl_Lpf_TimeConstant", Type::Float},
+        {"MotorCtl_SpeedCtl_AccelerationFeedForward", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched0_Speed", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched0_PScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched0_IScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched1_Speed", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched1_PScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched1_IScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched2_Speed", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched2_PScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched2_IScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched3_Speed", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched3_PScale", Type::Float},
+        {"MotorCtl_SpeedCtl_Sched3_IScale", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter0_Type", Type::Int32},
+        {"MotorCtl_SpeedCtl_RefFilter0_Frequency", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter0_Q", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter0_Gain", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter1_Type", Type::Int32},
+        {"MotorCtl_SpeedCtl_RefFilter1_Frequency", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter1_Q", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter1_Gain", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter2_Type", Type::Int32},
+        {"MotorCtl_SpeedCtl_RefFilter2_Frequency", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter2_Q", Type::Float},
+        {"MotorCtl_SpeedCtl_RefFilter2_Gain", Type::Float},
+        {"MotorCtl_SpeedCtl_FbFilter0_Type", Type::Int32},
+        {"MotorCtl_SpeedCtl_FbFilter0_Frequency", Type::Float},
+        {"MotorCtl_SpeedCtl_FbFilter0_Q", Type::Float},
+        {"MotorCtl_SpeedCtl_FbFilter0_Gain", Type::Float},
         PARAMETER_REQ_EOF};
     return items;
   }
@@ -87,12 +143,21 @@ struct MotorCtlVelocity : public IMotorCtl, public IParamReq {
 
   // parameter
   float mTargetVelocity;
-  float mMotorSupplyVoltage;
+  float mTargetAcceleration;
+  float mAccelerationFeedForward;
+  float mCurrentLimit;
+  float mLastTargetIq;  //!< torque demand of the last period, before mtpa
 
   // runtime vars
   SensorHandler mSensorHandler;
-  Pid mVelocityPid;
+  DiscretePid mVelocityPid;
   LowPassFilter mVelocityLpf;
+  GainSchedule mGainSchedule;
+  FieldWeakening mFieldWeakening;
+  Mtpa mMtpa;
+  DisturbanceObserver mDisturbanceObserver;
+  BiquadChain mRefFilter;
+  BiquadChain mFbFilter;
 };
 
 }  // namespace motorctl
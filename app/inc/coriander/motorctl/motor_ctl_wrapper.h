@@ -12,9 +12,11 @@
 #include <memory>
 
 #include "coriander/motorctl/imotorctl.h"
+#include "coriander/motorctl/motor_ctl_dual_position.h"
 #include "coriander/motorctl/motor_ctl_dummy.h"
 #include "coriander/motorctl/motor_ctl_openloop.h"
 #include "coriander/motorctl/motor_ctl_position.h"
+#include "coriander/motorctl/motor_ctl_position_direct.h"
 #include "coriander/motorctl/motor_ctl_velocity.h"
 #include "coriander/parameter_requirements.h"
 #include "coriander/parameters.h"
@@ -28,6 +30,8 @@ struct DynamicMotorCtl : public IMotorCtl, public IParamReq {
     Velocity,
     Position,
     OpenLoop,
+    PositionDirect,
+    DualPosition,
     MODE_MAX
   };
 
@@ -37,9 +41,12 @@ struct DynamicMotorCtl : public IMotorCtl, public IParamReq {
                   std::shared_ptr<MotorCtlVelocity> velocityMc,
                   std::shared_ptr<MotorCtlPosition> positionMc,
                   std::shared_ptr<MotorCtlOpenLoop> openLoopMc,
+                  std::shared_ptr<MotorCtlPositionDirect> positionDirectMc,
+                  std::shared_ptr<MotorCtlDualPosition> dualPositionMc,
                   std::shared_ptr<IParamReqValidator> paramReqValidator)
       : mParam(param),
-        mMotorCtl{dummyMc, currentMc, velocityMc, positionMc, openLoopMc},
+        mMotorCtl{dummyMc,    currentMc,        velocityMc,     positionMc,
+                  openLoopMc, positionDirectMc, dualPositionMc},
         mCurrentMc(dummyMc) {
     paramReqValidator->addParamReq(this);
   }
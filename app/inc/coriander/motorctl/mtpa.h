@@ -0,0 +1,57 @@
+/**
+ * @file mtpa.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-26
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief maximum torque per ampere split of a torque demand
+ *
+ * T = 1.5 * p * (flux * Iq + (Ld - Lq) * Id * Iq)
+ *
+ * The demand is given as the q current an Id = 0 drive would need, so the
+ * velocity pid output can be passed in unchanged. The table is built once in
+ * setup(), one call interpolates it.
+ */
+struct Mtpa {
+  static constexpr int kTableSize = 33;
+
+  Mtpa();
+
+  /**
+   * @brief build the lookup table
+   *
+   * @param Ld - d inductance, unit: H
+   * @param Lq - q inductance, unit: H
+   * @param flux - permanent magnet flux linkage, unit: Wb
+   * @param maxCurrent - largest |Is| in the table, unit: A
+   */
+  void setup(float Ld, float Lq, float flux, float maxCurrent);
+
+  /**
+   * @param current - torque demand as q current with Id = 0, unit: A
+   */
+  void operator()(float current, float* id, float* iq) const;
+
+  /**
+   * @brief false without saliency(Lq <= Ld), Id is always 0 then
+   */
+  bool enabled() const { return mEnabled; }
+
+ private:
+  bool mEnabled;
+  float mScale;  //!< demand to table index
+  float mId[kTableSize];
+  float mIq[kTableSize];
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,75 @@
+/**
+ * @file param_tables.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include "coriander/motorctl/biquad_filter.h"
+#include "coriander/motorctl/gain_schedule.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief parameters of a gain schedule point: operating point, P scale,
+ *        I scale
+ */
+using GainScheduleParams = ParamId[3];
+
+/**
+ * @brief parameters of a biquad stage: type, frequency, Q, gain
+ */
+using BiquadStageParams = ParamId[4];
+
+/**
+ * @brief points end at the first missing parameter
+ */
+template <int N>
+void setupGainSchedule(Parameter* params, const GainScheduleParams (&ids)[N],
+                       GainSchedule* schedule) {
+  static_assert(N <= GainSchedule::kMaxPoints, "too many points");
+  GainSchedule::Point points[N];
+  int n = 0;
+
+  for (auto& point : ids) {
+    if (!params->has(point[0])) {
+      break;
+    }
+    points[n++] = {params->getValue<float>(point[0]),
+                   params->getValue<float>(point[1]),
+                   params->getValue<float>(point[2])};
+  }
+  schedule->setup(points, n);
+}
+
+/**
+ * @brief stages end at the first missing parameter, bypass stages are
+ *        dropped by the chain
+ */
+template <int N>
+void setupBiquadChain(Parameter* params, const BiquadStageParams (&ids)[N],
+                      float sampleFrequency, BiquadChain* chain) {
+  static_assert(N <= BiquadChain::kMaxStages, "too many stages");
+  BiquadChain::Stage stages[N];
+  int n = 0;
+
+  for (auto& stage : ids) {
+    if (!params->has(stage[0])) {
+      break;
+    }
+    stages[n++] = {
+        static_cast<BiquadFilter::Type>(params->getValue<int32_t>(stage[0])),
+        params->getValue<float>(stage[1]), params->getValue<float>(stage[2]),
+        params->getValue<float>(stage[3])};
+  }
+  chain->setup(stages, n, sampleFrequency);
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -11,11 +11,21 @@
 
 #include <cstdint>
 
+#include "coriander/base/fixed_point.h"
+
 namespace coriander {
 namespace motorctl {
 
+namespace detail {
+/**
+ * @tparam N numeric policy, see base::FloatNumeric
+ */
+template <typename N>
 struct Pid {
  public:
+  using Value = typename N::Value;
+  using Gain = typename N::Gain;
+
   /**
    *
    * @param P - Proportional gain
@@ -24,23 +34,34 @@ struct Pid {
    * @param ramp - Maximum speed of change of the output value
    * @param limit - Maximum output value
    */
-  Pid(float P, float I, float D, float ramp, float limit);
+  Pid(Gain P, Gain I, Gain D, Gain ramp, Value limit);
   ~Pid() = default;
 
-  float operator()(float error, float diffTime);
+  Value operator()(Value error, Gain diffTime);
   void reset();
 
-  float P;            //!< Proportional gain
-  float I;            //!< Integral gain
-  float D;            //!< Derivative gain
-  float output_ramp;  //!< Maximum speed of change of the output value
-  float limit;        //!< Maximum output value
+  /**
+   * @brief feed back the output actually applied after an outer limiter,
+   *        the clipped part is removed from the integral (anti-windup)
+   */
+  void backCalculate(Value output);
+
+  Gain P;            //!< Proportional gain
+  Gain I;            //!< Integral gain
+  Gain D;            //!< Derivative gain
+  Gain output_ramp;  //!< Maximum speed of change of the output value
+  Value limit;       //!< Maximum output value
 
  protected:
-  float error_prev;     //!< last tracking error value
-  float output_prev;    //!< last pid output value
-  float integral_prev;  //!< last integral component value
+  Value error_prev;     //!< last tracking error value
+  Value output_prev;    //!< last pid output value
+  Value integral_prev;  //!< last integral component value
 };
+}  // namespace detail
+
+using Pid = detail::Pid<base::FloatNumeric>;
+using PidQ15 = detail::Pid<base::Q15Numeric>;
+using PidQ31 = detail::Pid<base::Q31Numeric>;
 
 }  // namespace motorctl
 }  // namespace coriander
@@ -0,0 +1,76 @@
+/**
+ * @file pll_velocity_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-28
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/motorctl/imech_angle_estimator.h"
+#include "coriander/motorctl/ivelocity_estimator.h"
+#include "coriander/os/isystick.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Velocity Estimator based on a type-II tracking loop on the
+ *        mechanical angle
+ *
+ * Updated on every sync with the microsecond systick, so the velocity loop
+ * gets a fresh estimate instead of a window average. The loop is critically
+ * damped, Kp = 2 * bandwidth and Ki = bandwidth^2, it tracks a constant
+ * velocity without error and lags 2 * acceleration / bandwidth on a ramp.
+ */
+struct PllVelocityEstimator : public IVelocityEstimator, public IParamReq {
+  using ISystick = coriander::os::ISystick;
+
+  explicit PllVelocityEstimator(
+      std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+      std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+      std::shared_ptr<IParamReqValidator> paramReqValidator);
+  virtual void enable();
+  virtual void disable();
+  virtual bool enabled();
+  virtual void sync();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getVelocity();
+
+  /**
+   * @brief filtered mechanical angle
+   *
+   * @return float degree, multi-turn like IMechAngleEstimator
+   */
+  float getPosition() const { return mAngle; }
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    using coriander::base::operator""_hash;
+    using Type = coriander::base::TypeId;
+    static const ParameterRequireItem requiredParam[] = {
+        {"MotorCtl_SpeedEstimator_PllBandwidth", Type::Float},
+        PARAMETER_REQ_EOF};
+    return requiredParam;
+  }
+
+ private:
+  std::shared_ptr<IMechAngleEstimator> mMechAngleEstimator;
+  std::shared_ptr<Parameter> mParam;
+  std::shared_ptr<ISystick> mSystick;
+  float mKp;
+  float mKi;
+  float mAngle;     //!< degree
+  float mVelocity;  //!< degree per second
+  uint32_t mTimestamp;
+  bool mEnabled;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,101 @@
+/**
+ * @file sensorless_elec_angle_estimator.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <memory>
+
+#include "coriander/motorctl/flux_observer.h"
+#include "coriander/motorctl/ielec_angle_estimator.h"
+#include "coriander/motorctl/iphase_current_estimator.h"
+#include "coriander/os/isystick.h"
+#include "coriander/parameter_requirements.h"
+#include "coriander/parameters.h"
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief Elecangle estimator based on a flux observer, no position sensor
+ *
+ * Fed by the phase current and the voltage the current loop applied, see
+ * IElecAngleEstimator::setVoltage.
+ */
+struct SensorlessElecAngleEstimator : public IElecAngleEstimator,
+                                      public IParamReq {
+  using ISystick = coriander::os::ISystick;
+
+  SensorlessElecAngleEstimator(
+      std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+      std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+      std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept;
+
+  virtual void enable();
+  virtual void disable();
+  virtual void sync();
+  virtual bool enabled();
+  virtual void calibrate();
+  virtual bool needCalibrate();
+  virtual float getElectricalAngle() noexcept;
+  virtual void setVoltage(float alpha, float beta) noexcept;
+
+  /**
+   * @brief restart the observer from a known angle, e.g. from a calibrated
+   *        encoder, the flux observer can not find it at standstill
+   *
+   * @param angle electrical angle, degree
+   */
+  void setElectricalAngle(float angle) { mObserver.reset(angle); }
+
+  /**
+   * @return float electrical speed, degree per second
+   */
+  float getElectricalVelocity() const { return mObserver.getVelocity(); }
+
+  /**
+   * @brief back-EMF is large enough, above MotorCtl_Sensorless_MinSpeed
+   *
+   * @note never when the flux linkage is unknown
+   */
+  bool converged() const {
+    return mFluxKnown && mObserver.converged(mMinVelocity);
+  }
+
+  virtual const ParameterRequireItem* requiredParameters() const {
+    constexpr static const ParameterRequireItem items[] = {
+        {"MotorCtl_MotorDriver_PolePair", TypeId::Int32},
+        {"MotorCtl_MotorDriver_SupplyVoltage", TypeId::Float},
+        {"MotorCtl_MotorDriver_Rs", TypeId::Float},
+        {"MotorCtl_MotorDriver_Ld", TypeId::Float},
+        {"MotorCtl_MotorDriver_Lq", TypeId::Float},
+        {"MotorCtl_MotorDriver_FluxLinkage", TypeId::Float},
+        {"MotorCtl_Sensorless_ObserverGain", TypeId::Float},
+        {"MotorCtl_Sensorless_PllBandwidth", TypeId::Float},
+        {"MotorCtl_Sensorless_MinSpeed", TypeId::Float},
+        PARAMETER_REQ_EOF};
+
+    return &items[0];
+  }
+
+ private:
+  std::shared_ptr<IPhaseCurrentEstimator> mPhaseCurrentEstimator;
+  std::shared_ptr<Parameter> mParam;
+  std::shared_ptr<ISystick> mSystick;
+  FluxObserver mObserver;
+  float mVoltageScale;  //!< SpaceVectorPwm units to volt
+  float mVoltageAlpha;
+  float mVoltageBeta;
+  float mMinVelocity;  //!< electrical, degree per second
+  uint32_t mTimestamp;
+  bool mFluxKnown;
+  bool mEnabled;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
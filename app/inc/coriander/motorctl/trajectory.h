@@ -0,0 +1,73 @@
+/**
+ * @file trajectory.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-23
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+namespace coriander {
+namespace motorctl {
+
+/**
+ * @brief online motion profile planner
+ *
+ * Runs once per position loop tick and moves the planned position towards the
+ * target within the velocity/acceleration(/jerk) limits. Jerk 0 gives a
+ * trapezoidal profile, otherwise an S-curve. The target may change at any
+ * tick, the planned velocity and acceleration stay continuous.
+ *
+ * @note units are free, velocity is per second of position, acceleration per
+ *       second of velocity and so on
+ */
+struct Trajectory {
+  Trajectory();
+
+  /**
+   * @brief Set the limits of the profile
+   *
+   * @param velocity - maximum velocity, > 0
+   * @param acceleration - maximum acceleration, > 0
+   * @param jerk - maximum jerk, 0: trapezoidal profile
+   */
+  void setLimits(float velocity, float acceleration, float jerk);
+
+  /**
+   * @brief restart the profile from a measured state
+   */
+  void reset(float position, float velocity = 0.0f);
+
+  /**
+   * @brief advance the profile by one step
+   *
+   * @param target - final position
+   * @param Ts - step, unit: s
+   */
+  void operator()(float target, float Ts);
+
+  float getPosition() const { return mPosition; }
+  float getVelocity() const { return mVelocity; }
+  float getAcceleration() const { return mAcceleration; }
+
+  /**
+   * @brief target reached and the profile is at rest
+   */
+  bool done() const { return mDone; }
+
+ private:
+  float mMaxVelocity;
+  float mMaxAcceleration;
+  float mMaxJerk;
+
+  // states
+  float mPosition;
+  float mVelocity;
+  float mAcceleration;
+  bool mDone;
+};
+
+}  // namespace motorctl
+}  // namespace coriander
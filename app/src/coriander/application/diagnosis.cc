@@ -31,19 +31,28 @@ void Diagnosis::addDiagInspector(DiagInspectorFunc func) noexcept {
 }
 
 void Diagnosis::inspect() noexcept {
-  for (auto &dev : mDiagDevs) {
-    if (!dev.func) {
-      continue;
-    }
-    auto status = dev.func();
-    if (dev.status == status) {
-      continue;
-    }
-    dev.status = status;
-    auto id = static_cast<DiagDevId>(&dev - &mDiagDevs[0]);
-    for (auto &inspector : mDiagInspectorFuncs) {
-      inspector(id, status);
-    }
+  for (std::uint8_t i = 0; i < static_cast<std::uint8_t>(DiagDevId::MAX_ID);
+       i++) {
+    inspect(static_cast<DiagDevId>(i));
+  }
+}
+
+void Diagnosis::inspect(DiagDevId id) noexcept {
+  if (static_cast<std::uint8_t>(id) >=
+      static_cast<std::uint8_t>(DiagDevId::MAX_ID)) {
+    return;
+  }
+  auto &dev = mDiagDevs[static_cast<std::uint8_t>(id)];
+  if (!dev.func) {
+    return;
+  }
+  auto status = dev.func();
+  if (dev.status == status) {
+    return;
+  }
+  dev.status = status;
+  for (auto &inspector : mDiagInspectorFuncs) {
+    inspector(id, status);
   }
 }
 
@@ -0,0 +1,73 @@
+/**
+ * @file zephyr_bus_voltage_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-12
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "zephyr/zephyr_bus_voltage_estimator.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "coriander/base/jscope.h"
+#include "zephyr/zephyr_injected_adc.h"
+
+LOG_MODULE_REGISTER(bus_voltage_estimator);
+
+#if CONFIG_JSCOPE_ENABLE
+ATTR_JSCOPE static float _dBusVoltage = 0.0f;
+ATTR_JSCOPE static float _dBusTemperature = 0.0f;
+#endif
+
+#define BUS_VOLTAGE_NODE DT_NODELABEL(bus_voltage)
+
+#if DT_NODE_HAS_STATUS(BUS_VOLTAGE_NODE, okay)
+#define BUS_VOLTAGE_OFFSET DT_PROP(BUS_VOLTAGE_NODE, voltage_offset)
+#define BUS_VOLTAGE_SCALE DT_PROP(BUS_VOLTAGE_NODE, voltage_scale)
+#define BUS_TEMP_OFFSET DT_PROP(BUS_VOLTAGE_NODE, temp_offset)
+#define BUS_TEMP_SCALE DT_PROP(BUS_VOLTAGE_NODE, temp_scale)
+#endif
+
+static bool bus_enabled = false;
+
+namespace coriander {
+namespace motorctl {
+namespace zephyr {
+void BusVoltageEstimator::enable() {
+  // ranks are owned by the injected sequence setup, whoever enables first
+  bus_enabled = injectedAdcSetup() &&
+                injectedAdcHas(InjectedChannel::BusVoltage);
+}
+void BusVoltageEstimator::disable() { bus_enabled = false; }
+bool BusVoltageEstimator::enabled() { return bus_enabled; }
+void BusVoltageEstimator::sync() {
+  if (!bus_enabled) {
+    return;
+  }
+#ifdef BUS_VOLTAGE_SCALE
+  mBusVoltage =
+      (injectedAdcReadMv(InjectedChannel::BusVoltage) - BUS_VOLTAGE_OFFSET) /
+      BUS_VOLTAGE_SCALE;
+  if (injectedAdcHas(InjectedChannel::Temperature)) {
+    mTemperature =
+        (injectedAdcReadMv(InjectedChannel::Temperature) - BUS_TEMP_OFFSET) /
+        BUS_TEMP_SCALE;
+  }
+#endif
+#if CONFIG_JSCOPE_ENABLE
+  _dBusVoltage = mBusVoltage;
+  _dBusTemperature = mTemperature;
+#endif
+}
+void BusVoltageEstimator::calibrate() {}
+bool BusVoltageEstimator::needCalibrate() { return false; }
+
+float BusVoltageEstimator::getBusVoltage() { return mBusVoltage; }
+float BusVoltageEstimator::getTemperature() { return mTemperature; }
+
+}  // namespace zephyr
+}  // namespace motorctl
+}  // namespace coriander
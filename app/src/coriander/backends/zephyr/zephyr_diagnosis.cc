@@ -32,6 +32,8 @@ void DiagnosisRegister::applyAll(coriander::application::Diagnosis* diagnosis) {
 }
 void DiagnosisRegister::updateStatus(uint32_t ref_2048, uint32_t ps28Voltage,
                                      uint32_t ps5Voltage, uint32_t psCurrent) {}
+void DiagnosisRegister::poll() {}
+void DiagnosisRegister::dispatch() {}
 }  // namespace zephyr
 }  // namespace application
 }  // namespace coriander
@@ -103,6 +105,7 @@ static void diagnosis_thread(void) {
 
     coriander::application::zephyr::DiagnosisRegister::getInstance()
         ->updateStatus(adc_raw[0], adc_raw[1], adc_raw[2], adc_raw[3]);
+    coriander::application::zephyr::DiagnosisRegister::getInstance()->poll();
 
     // update diagnosis status
     k_sleep(K_MSEC(1000));
@@ -118,6 +121,8 @@ namespace zephyr {
 
 DiagnosisRegister::DiagnosisRegister()
     : mInstance(nullptr),
+      mDiagnosis(nullptr),
+      mPending(false),
       mPsVoltage(DeviceStatus::Unknown),
       mPsCurrent(DeviceStatus::Unknown) {
   k_thread_start(diagnosis);
@@ -135,6 +140,7 @@ void DiagnosisRegister::applyAll(coriander::application::Diagnosis* diagnosis) {
   using DeviceStatus = coriander::application::Diagnosis::DeviceStatus;
   using DiagDevId = coriander::application::Diagnosis::DiagDevId;
 
+  mDiagnosis = diagnosis;
   diagnosis->setDiagDev(DiagDevId::CtlrBoardPsVoltage, [this]() {
     while (mPsVoltage == DeviceStatus::Unknown) {
       k_sleep(K_MSEC(1));
@@ -176,6 +182,15 @@ void DiagnosisRegister::updateStatus(uint32_t ref_2048, uint32_t ps28Voltage,
   }
 }
 
+void DiagnosisRegister::poll() { mPending = true; }
+
+void DiagnosisRegister::dispatch() {
+  if (mDiagnosis != nullptr && mPending.exchange(false)) {
+    mDiagnosis->inspect(DiagDevId::MotorInnerPosSensor);
+    mDiagnosis->inspect(DiagDevId::MotorOuterPosSensor);
+  }
+}
+
 }  // namespace zephyr
 }  // namespace application
 }  // namespace coriander
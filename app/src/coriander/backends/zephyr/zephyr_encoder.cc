@@ -20,11 +20,15 @@ LOG_MODULE_REGISTER(encoder, CONFIG_APP_LOG_LEVEL);
 #warning "No encoder chosen"
 #endif
 
-#define ENCODER_QDEC DEVICE_DT_GET_OR_NULL(DT_CHOSEN(usr_encoder))
-#define ENCODER_PPR \
-  DT_PROP_OR(DT_CHOSEN(usr_encoder), st_counts_per_revolution, 0)
+#define ENCODER_QDEC(chosen) DEVICE_DT_GET_OR_NULL(DT_CHOSEN(chosen))
+#define ENCODER_PPR(chosen) \
+  DT_PROP_OR(DT_CHOSEN(chosen), st_counts_per_revolution, 0)
 
-struct _instance {
+namespace coriander {
+namespace motorctl {
+namespace zephyr {
+
+struct EncoderInstance {
   const struct device* encoder;
   const uint32_t ppr;
   bool found_zero;
@@ -33,33 +37,51 @@ struct _instance {
   bool enabled;
 };
 
-static struct _instance _encoder_instance = {
-    .encoder = ENCODER_QDEC,
-    .ppr = ENCODER_PPR,
+namespace {
+EncoderInstance _encoder_instance = {
+    .encoder = ENCODER_QDEC(usr_encoder),
+    .ppr = ENCODER_PPR(usr_encoder),
     .found_zero = false,
     .enabled = false,
 };
 
-namespace coriander {
-namespace motorctl {
-namespace zephyr {
-void Encoder::enable() {
-  auto inst = &_encoder_instance;
-  inst->enabled = true;
+EncoderInstance _load_encoder_instance = {
+    .encoder = ENCODER_QDEC(usr_load_encoder),
+    .ppr = ENCODER_PPR(usr_load_encoder),
+    .found_zero = true,
+    .enabled = false,
+};
+}  // namespace
+
+Encoder::Encoder() : EncoderBackend(&_encoder_instance) {}
+
+LoadEncoder::LoadEncoder() : EncoderBackend(&_load_encoder_instance) {}
+
+template <typename T_encoder>
+void EncoderBackend<T_encoder>::enable() {
+  auto inst = mInstance;
+  inst->enabled = inst->encoder != NULL && inst->ppr > 0;
 }
-void Encoder::disable() {
-  auto inst = &_encoder_instance;
+template <typename T_encoder>
+void EncoderBackend<T_encoder>::disable() {
+  auto inst = mInstance;
   inst->enabled = false;
 }
-bool Encoder::enabled() {
-  auto inst = &_encoder_instance;
+template <typename T_encoder>
+bool EncoderBackend<T_encoder>::enabled() {
+  auto inst = mInstance;
   return inst->enabled;
 }
-void Encoder::sync() {
-  auto inst = &_encoder_instance;
+template <typename T_encoder>
+void EncoderBackend<T_encoder>::sync() {
+  auto inst = mInstance;
   int32_t diff, t = inst->angle_cached.val1;
   int ret;
 
+  if (inst->encoder == NULL) {
+    return;
+  }
+
   ret = sensor_sample_fetch(inst->encoder);
   if (ret) {
     LOG_WRN("Failed to fetch sample from %s: %d", inst->encoder->name, ret);
@@ -85,27 +107,36 @@ void Encoder::sync() {
 
   inst->full_angle.val1 += diff;
 }
-void Encoder::calibrate() {
-  struct _instance* inst = &_encoder_instance;
+template <typename T_encoder>
+void EncoderBackend<T_encoder>::calibrate() {
+  auto inst = mInstance;
   inst->found_zero = true;
 }
-bool Encoder::needCalibrate() {
-  struct _instance* inst = &_encoder_instance;
+template <typename T_encoder>
+bool EncoderBackend<T_encoder>::needCalibrate() {
+  auto inst = mInstance;
   return !inst->found_zero;
 }
-unsigned Encoder::getEncoderCount() {
-  struct _instance* inst = &_encoder_instance;
+template <typename T_encoder>
+unsigned EncoderBackend<T_encoder>::getEncoderCount() {
+  auto inst = mInstance;
   float angle = sensor_value_to_float(&inst->angle_cached);
   return (unsigned)(angle / 360.0 * inst->ppr);
 }
-unsigned Encoder::getEncoderCountPerRound() {
-  struct _instance* inst = &_encoder_instance;
-  return inst->ppr;
+template <typename T_encoder>
+unsigned EncoderBackend<T_encoder>::getEncoderCountPerRound() {
+  auto inst = mInstance;
+  return inst->ppr > 0 ? inst->ppr : 1;
 }
-int Encoder::getOverflowCount() {
-  struct _instance* inst = &_encoder_instance;
+template <typename T_encoder>
+int EncoderBackend<T_encoder>::getOverflowCount() {
+  auto inst = mInstance;
   return inst->full_angle.val1 / 360;
 }
+
+template struct EncoderBackend<motorctl::IEncoder>;
+template struct EncoderBackend<motorctl::ILoadEncoder>;
+
 }  // namespace zephyr
 }  // namespace motorctl
 }  // namespace coriander
@@ -0,0 +1,254 @@
+/**
+ * @file zephyr_injected_adc.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-14
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "zephyr/zephyr_injected_adc.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stm32f4xx_ll_adc.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(injected_adc);
+
+#ifndef ADC_DT_SPEC_GET_BY_NAME
+#define ADC_DT_SPEC_GET_BY_NAME(node_id, name)                   \
+  ADC_DT_SPEC_STRUCT(DT_IO_CHANNELS_CTLR_BY_NAME(node_id, name), \
+                     DT_IO_CHANNELS_INPUT_BY_NAME(node_id, name))
+#endif
+
+#define INJECTED_ADC_USER DT_PATH(zephyr_user)
+#define BUS_VOLTAGE_NODE DT_NODELABEL(bus_voltage)
+
+#if DT_NODE_HAS_STATUS(BUS_VOLTAGE_NODE, okay)
+#define INJECTED_ADC_HAS_VBUS 1
+#define INJECTED_ADC_HAS_TEMP \
+  DT_PROP_HAS_NAME(INJECTED_ADC_USER, io_channels, motor_temp)
+#else
+#define INJECTED_ADC_HAS_VBUS 0
+#define INJECTED_ADC_HAS_TEMP 0
+#endif
+
+using InjectedChannel = coriander::motorctl::zephyr::InjectedChannel;
+
+struct injected_channel {
+  const struct adc_dt_spec *spec;
+  ADC_TypeDef *adc;
+  uint32_t rank;
+  bool enabled;
+};
+
+static const struct adc_dt_spec phase_u =
+    ADC_DT_SPEC_GET_BY_NAME(INJECTED_ADC_USER, motor_iu);
+static const struct adc_dt_spec phase_v =
+    ADC_DT_SPEC_GET_BY_NAME(INJECTED_ADC_USER, motor_iv);
+static const struct adc_dt_spec phase_w =
+    ADC_DT_SPEC_GET_BY_NAME(INJECTED_ADC_USER, motor_iw);
+#if INJECTED_ADC_HAS_VBUS
+static const struct adc_dt_spec bus_voltage =
+    ADC_DT_SPEC_GET_BY_NAME(INJECTED_ADC_USER, motor_vbus);
+#endif
+#if INJECTED_ADC_HAS_TEMP
+static const struct adc_dt_spec temperature =
+    ADC_DT_SPEC_GET_BY_NAME(INJECTED_ADC_USER, motor_temp);
+#endif
+
+// in rank order, see InjectedChannel
+static struct injected_channel channels[] = {
+    {.spec = &phase_u, .adc = NULL, .rank = 0, .enabled = false},
+    {.spec = &phase_v, .adc = NULL, .rank = 0, .enabled = false},
+    {.spec = &phase_w, .adc = NULL, .rank = 0, .enabled = false},
+#if INJECTED_ADC_HAS_VBUS
+    {.spec = &bus_voltage, .adc = NULL, .rank = 0, .enabled = false},
+#else
+    {.spec = NULL, .adc = NULL, .rank = 0, .enabled = false},
+#endif
+#if INJECTED_ADC_HAS_TEMP
+    {.spec = &temperature, .adc = NULL, .rank = 0, .enabled = false},
+#else
+    {.spec = NULL, .adc = NULL, .rank = 0, .enabled = false},
+#endif
+};
+static_assert(ARRAY_SIZE(channels) ==
+                  static_cast<size_t>(InjectedChannel::Count),
+              "one entry per InjectedChannel");
+
+static constexpr const uint32_t inj_ranks[] = {
+    LL_ADC_INJ_RANK_1,
+    LL_ADC_INJ_RANK_2,
+    LL_ADC_INJ_RANK_3,
+    LL_ADC_INJ_RANK_4,
+};
+static constexpr const uint32_t inj_lengths[] = {
+    LL_ADC_INJ_SEQ_SCAN_DISABLE,
+    LL_ADC_INJ_SEQ_SCAN_ENABLE_2RANKS,
+    LL_ADC_INJ_SEQ_SCAN_ENABLE_3RANKS,
+    LL_ADC_INJ_SEQ_SCAN_ENABLE_4RANKS,
+};
+
+static inline ADC_TypeDef *adc_from_spec(const adc_dt_spec *spec) {
+  // NOTE(savent): based on adc_stm32.c the first four bytes of dev->config is
+  // device base addr
+  uint32_t base_addr = *reinterpret_cast<const uint32_t *>(spec->dev->config);
+  switch (base_addr) {
+    case ADC1_BASE:
+      return ADC1;
+    case ADC2_BASE:
+      return ADC2;
+    case ADC3_BASE:
+      return ADC3;
+    default:
+      break;
+  }
+  return NULL;
+}
+
+static inline uint32_t channel_from_idx(unsigned idx) {
+  constexpr const uint32_t adc_channels[] = {
+      LL_ADC_CHANNEL_0,  LL_ADC_CHANNEL_1,  LL_ADC_CHANNEL_2,
+      LL_ADC_CHANNEL_3,  LL_ADC_CHANNEL_4,  LL_ADC_CHANNEL_5,
+      LL_ADC_CHANNEL_6,  LL_ADC_CHANNEL_7,  LL_ADC_CHANNEL_8,
+      LL_ADC_CHANNEL_9,  LL_ADC_CHANNEL_10, LL_ADC_CHANNEL_11,
+      LL_ADC_CHANNEL_12, LL_ADC_CHANNEL_13, LL_ADC_CHANNEL_14,
+      LL_ADC_CHANNEL_15, LL_ADC_CHANNEL_16, LL_ADC_CHANNEL_17,
+      LL_ADC_CHANNEL_18,
+  };
+  if (idx >= ARRAY_SIZE(adc_channels)) {
+    return 0;
+  }
+  return adc_channels[idx];
+}
+
+static bool channel_setup(struct injected_channel *ch) {
+  int err;
+
+  if (ch->spec == NULL) {
+    return false;
+  }
+  ch->adc = adc_from_spec(ch->spec);
+  if (ch->adc == NULL || !adc_is_ready_dt(ch->spec)) {
+    LOG_ERR("ADC controller device %s not ready\n", ch->spec->dev->name);
+    return false;
+  }
+  err = adc_channel_setup_dt(ch->spec);
+  if (err < 0) {
+    LOG_ERR("Could not setup channel %d (%d)\n", ch->spec->channel_id, err);
+    return false;
+  }
+  return true;
+}
+
+static void sequence_setup(ADC_TypeDef *adc) {
+  size_t n = 0;
+
+  for (auto &ch : channels) {
+    if (!ch.enabled || ch.adc != adc) {
+      continue;
+    }
+    if (n >= ARRAY_SIZE(inj_ranks)) {
+      LOG_ERR("injected sequence is full, channel %d dropped\n",
+              ch.spec->channel_id);
+      ch.enabled = false;
+      continue;
+    }
+    ch.rank = inj_ranks[n++];
+  }
+
+  LL_ADC_INJ_SetTrigAuto(adc, LL_ADC_INJ_TRIG_INDEPENDENT);
+  LL_ADC_INJ_SetSequencerDiscont(adc, LL_ADC_INJ_SEQ_DISCONT_DISABLE);
+  LL_ADC_INJ_SetTriggerSource(adc, LL_ADC_INJ_TRIG_EXT_TIM1_CH4);
+  // ranks are placed by the length, set it first
+  LL_ADC_INJ_SetSequencerLength(adc, inj_lengths[n - 1]);
+  for (auto &ch : channels) {
+    if (!ch.enabled || ch.adc != adc) {
+      continue;
+    }
+    LL_ADC_INJ_SetSequencerRanks(adc, ch.rank,
+                                 channel_from_idx(ch.spec->channel_id));
+    // Don't re-configure the channel's sampling time, it's already done by
+    // zephyr
+    LL_ADC_INJ_SetOffset(adc, ch.rank, 0);
+  }
+  LL_ADC_DisableIT_JEOS(adc);
+
+  LL_ADC_INJ_StartConversionExtTrig(adc, LL_ADC_INJ_TRIG_EXT_RISING);
+}
+
+static bool setup_done = false;
+static bool setup_result = false;
+
+namespace coriander {
+namespace motorctl {
+namespace zephyr {
+
+bool injectedAdcSetup() {
+  ADC_TypeDef *adcs[ARRAY_SIZE(channels)];
+  size_t adc_count = 0;
+
+  if (setup_done) {
+    return setup_result;
+  }
+  setup_done = true;
+
+  for (auto &ch : channels) {
+    ch.enabled = channel_setup(&ch);
+    if (&ch <= &channels[static_cast<size_t>(InjectedChannel::PhaseW)] &&
+        !ch.enabled) {
+      return false;
+    }
+  }
+
+  // each adc gets its sequence once, in the order of the channels
+  for (auto &ch : channels) {
+    size_t i = 0;
+    if (!ch.enabled) {
+      continue;
+    }
+    while (i < adc_count && adcs[i] != ch.adc) {
+      i++;
+    }
+    if (i == adc_count) {
+      adcs[adc_count++] = ch.adc;
+      sequence_setup(ch.adc);
+    }
+  }
+
+  // parameter check
+  for (size_t i = 0; i <= static_cast<size_t>(InjectedChannel::PhaseW); i++) {
+    if (channels[i].rank != LL_ADC_INJ_RANK_1) {
+      LOG_ERR(
+          "phase current must use different ADCs to sample at the same "
+          "time!\n");
+      k_panic();
+    }
+  }
+
+  setup_result = true;
+  return setup_result;
+}
+
+bool injectedAdcHas(InjectedChannel channel) {
+  return setup_result && channels[static_cast<size_t>(channel)].enabled;
+}
+
+float injectedAdcReadMv(InjectedChannel channel) {
+  const auto &ch = channels[static_cast<size_t>(channel)];
+  uint32_t val;
+
+  if (!injectedAdcHas(channel)) {
+    return 0.0f;
+  }
+  val = LL_ADC_INJ_ReadConversionData12(ch.adc, ch.rank);
+  return val * 3.3f / 4096 * 1000.0f;
+}
+
+}  // namespace zephyr
+}  // namespace motorctl
+}  // namespace coriander
@@ -12,11 +12,12 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stm32f4xx_ll_adc.h>
-#include <zephyr/drivers/adc.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 #include "coriander/base/jscope.h"
+#include "coriander/base/math.h"
+#include "zephyr/zephyr_injected_adc.h"
 
 LOG_MODULE_REGISTER(phase_current_estimator);
 
@@ -33,115 +34,32 @@ ATTR_JSCOPE static float _dPhaseCurrentBeta = 0.0f;
 ATTR_JSCOPE static float _dPhaseCurrentAngle = 0.0f;
 #endif
 
-#ifndef ADC_DT_SPEC_GET_BY_NAME
-#define ADC_DT_SPEC_GET_BY_NAME(node_id, name)                   \
-  ADC_DT_SPEC_STRUCT(DT_IO_CHANNELS_CTLR_BY_NAME(node_id, name), \
-                     DT_IO_CHANNELS_INPUT_BY_NAME(node_id, name))
-#endif
-
 #define PHASE_CURRENT_NODE DT_NODELABEL(phase_current)
 #define PHASE_CURRENT_OFFSET DT_PROP(PHASE_CURRENT_NODE, voltage_offset)
 #define PHASE_CURRENT_SCALE DT_PROP(PHASE_CURRENT_NODE, voltage_scale)
 #define PHASE_CURRENT_REVERSE DT_PROP(PHASE_CURRENT_NODE, reverse)
 
+using InjectedChannel = coriander::motorctl::zephyr::InjectedChannel;
+
 struct adc_instance {
-  const struct adc_dt_spec adc_channels[3];
   int32_t adc_raw[3];
 };
 
 static struct adc_instance adc_inst = {
-    .adc_channels = {ADC_DT_SPEC_GET_BY_NAME(DT_PATH(zephyr_user), motor_iu),
-                     ADC_DT_SPEC_GET_BY_NAME(DT_PATH(zephyr_user), motor_iv),
-                     ADC_DT_SPEC_GET_BY_NAME(DT_PATH(zephyr_user), motor_iw)},
     .adc_raw = {0},
 };
 
-static inline ADC_TypeDef *adc_from_spec(const adc_dt_spec *spec) {
-  // NOTE(savent): based on adc_stm32.c the first four bytes of dev->config is
-  // device base addr
-  uint32_t base_addr = *reinterpret_cast<const uint32_t *>(spec->dev->config);
-  switch (base_addr) {
-    case ADC1_BASE:
-      return ADC1;
-    case ADC2_BASE:
-      return ADC2;
-    case ADC3_BASE:
-      return ADC3;
-    default:
-      break;
-  }
-  return NULL;
-}
-
-static inline uint32_t channel_from_idx(unsigned idx) {
-  constexpr const uint32_t channels[] = {
-      LL_ADC_CHANNEL_0,  LL_ADC_CHANNEL_1,  LL_ADC_CHANNEL_2,
-      LL_ADC_CHANNEL_3,  LL_ADC_CHANNEL_4,  LL_ADC_CHANNEL_5,
-      LL_ADC_CHANNEL_6,  LL_ADC_CHANNEL_7,  LL_ADC_CHANNEL_8,
-      LL_ADC_CHANNEL_9,  LL_ADC_CHANNEL_10, LL_ADC_CHANNEL_11,
-      LL_ADC_CHANNEL_12, LL_ADC_CHANNEL_13, LL_ADC_CHANNEL_14,
-      LL_ADC_CHANNEL_15, LL_ADC_CHANNEL_16, LL_ADC_CHANNEL_17,
-      LL_ADC_CHANNEL_18,
-  };
-  if (idx >= ARRAY_SIZE(channels)) {
-    return 0;
-  }
-  return channels[idx];
-}
-
 static bool adc_inited = false;
-static void adc_init(adc_instance *inst) {
+static void adc_init() {
   auto &init = adc_inited;
-  const adc_dt_spec *adc_channels = &inst->adc_channels[0];
-  int err;
   if (init) {
     return;
   }
   init = true;
 
-  for (int i = 0; i < 3; i++) {
-    if (!adc_is_ready_dt(&adc_channels[i])) {
-      LOG_ERR("ADC controller device %s not ready\n",
-              adc_channels[i].dev->name);
-      return;
-    }
-    err = adc_channel_setup_dt(&adc_channels[i]);
-    if (err < 0) {
-      LOG_ERR("Could not setup channel #%d (%d)\n", i, err);
-      return;
-    }
-  }
-
-  // NOTE(savent): Low-Level configuration
-  ADC_TypeDef *adc_first = NULL, *adc_second = NULL;
-  for (int i = 0; i < 3; i++) {
-    ADC_TypeDef *adc = adc_from_spec(&adc_channels[i]);
-    uint32_t adc_channel = channel_from_idx(adc_channels[i].channel_id);
-
-    LL_ADC_INJ_SetTrigAuto(adc, LL_ADC_INJ_TRIG_INDEPENDENT);
-    LL_ADC_INJ_SetSequencerDiscont(adc, LL_ADC_INJ_SEQ_DISCONT_DISABLE);
-    LL_ADC_INJ_SetTriggerSource(adc, LL_ADC_INJ_TRIG_EXT_TIM1_CH4);
-    LL_ADC_INJ_SetSequencerLength(adc, LL_ADC_INJ_SEQ_SCAN_DISABLE);
-
-    LL_ADC_INJ_SetSequencerRanks(adc, LL_ADC_INJ_RANK_1, adc_channel);
-    // Don't re-configure the channel's sampling time, it's already done by
-    // zephyr
-    LL_ADC_INJ_SetOffset(adc, LL_ADC_INJ_RANK_1, 0);
-    LL_ADC_DisableIT_JEOS(adc);
-
-    LL_ADC_INJ_StartConversionExtTrig(adc, LL_ADC_INJ_TRIG_EXT_RISING);
-    // parameter check
-    if (adc == adc_first || adc == adc_second) {
-      LOG_ERR(
-          "phase current must use different ADCs to sample at the same "
-          "time!\n");
-      k_panic();
-    }
-    if (i == 0) {
-      adc_first = adc;
-    } else if (i == 1) {
-      adc_second = adc;
-    }
+  // the bus voltage shares the sequences, see zephyr_injected_adc.h
+  if (!coriander::motorctl::zephyr::injectedAdcSetup()) {
+    LOG_ERR("phase current channels not ready\n");
   }
 }
 static inline void current_convert(adc_instance *inst, float *Iu, float *Iv,
@@ -173,21 +91,22 @@ static inline void get_current_alpha_beta(adc_instance *inst, const float Ia,
 }
 
 static inline void adc_sync(adc_instance *inst) {
-  constexpr const adc_dt_spec *adc_channels = &adc_inst.adc_channels[0];
   constexpr int32_t *adc_raw = &adc_inst.adc_raw[0];
+  constexpr InjectedChannel phases[] = {
+      InjectedChannel::PhaseU,
+      InjectedChannel::PhaseV,
+      InjectedChannel::PhaseW,
+  };
   for (int i = 0; i < 3; i++) {
-    ADC_TypeDef *adc = adc_from_spec(&adc_channels[i]);
-    uint32_t adc_rank = LL_ADC_INJ_RANK_1;
-    uint32_t val;
-    val = LL_ADC_INJ_ReadConversionData12(adc, adc_rank);
-    adc_raw[i] = static_cast<int32_t>((val * 3.3f / 4096) * 1000.0f);
+    adc_raw[i] = static_cast<int32_t>(
+        coriander::motorctl::zephyr::injectedAdcReadMv(phases[i]));
   }
 }
 
 namespace coriander {
 namespace motorctl {
 namespace zephyr {
-void PhaseCurrentEstimator::enable() { adc_init(&adc_inst); }
+void PhaseCurrentEstimator::enable() { adc_init(); }
 void PhaseCurrentEstimator::disable() {}
 bool PhaseCurrentEstimator::enabled() { return adc_inited; }
 void PhaseCurrentEstimator::sync() {
@@ -197,7 +116,7 @@ void PhaseCurrentEstimator::sync() {
   getPhaseCurrent(&alpha, &beta);
   _dPhaseCurrentAlpha = alpha * 1000;
   _dPhaseCurrentBeta = beta * 1000;
-  angle = atan2f(beta, alpha);
+  angle = coriander::base::math::atan2f(beta, alpha);
   _dPhaseCurrentAngle = angle * 180.0f / M_PI;
 #endif
 }
@@ -0,0 +1,90 @@
+/**
+ * @file backlash_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/backlash_estimator.h"
+
+namespace coriander {
+namespace motorctl {
+
+// a single flank does not tell the center from the backlash, the covariance
+// of that direction stops growing here
+static constexpr float kInitialCovariance = 10.0f;
+static constexpr float kMaxCovarianceTrace = 3.0f * kInitialCovariance;
+
+BacklashEstimator::BacklashEstimator()
+    : mTheta(State::zeros()),
+      mP(Covariance::identity() * kInitialCovariance),
+      mEngageCurrent(0.0f),
+      mForgetting(1.0f),
+      mSide(1) {}
+
+void BacklashEstimator::setup(float engageCurrent, float forgetting,
+                              float backlash, float compliance) {
+  mEngageCurrent = engageCurrent;
+  mForgetting = forgetting > 0.0f && forgetting <= 1.0f ? forgetting : 1.0f;
+  mTheta(1, 0) = 0.5f * backlash;
+  mTheta(2, 0) = compliance;
+}
+
+void BacklashEstimator::reset(float twist) {
+  mTheta(0, 0) = twist;
+  mP = Covariance::identity() * kInitialCovariance;
+  mSide = 1;
+}
+
+void BacklashEstimator::operator()(float twist, float Iq) {
+  State phi;
+  State Pphi;
+  float denominator, error, trace;
+
+  if (Iq > mEngageCurrent) {
+    mSide = 1;
+  } else if (Iq < -mEngageCurrent) {
+    mSide = -1;
+  } else {
+    return;  // inside the gap
+  }
+
+  phi(0, 0) = 1.0f;
+  phi(1, 0) = static_cast<float>(mSide);
+  phi(2, 0) = Iq;
+
+  Pphi = mP * phi;
+  denominator = mForgetting + (phi.transpose() * Pphi)(0, 0);
+  error = twist - (phi.transpose() * mTheta)(0, 0);
+  mTheta = mTheta + Pphi * (error / denominator);
+  mP = mP - Pphi * (Pphi.transpose() * (1.0f / denominator));
+
+  trace = mP(0, 0) + mP(1, 1) + mP(2, 2);
+  if (trace < kMaxCovarianceTrace) {
+    mP = mP * (1.0f / mForgetting);
+  }
+}
+
+float BacklashEstimator::predict(float Iq) const {
+  float side = static_cast<float>(mSide);
+
+  if (Iq > mEngageCurrent) {
+    side = 1.0f;
+  } else if (Iq < -mEngageCurrent) {
+    side = -1.0f;
+  }
+  return getCenter() + side * 0.5f * getBacklash() + getCompliance() * Iq;
+}
+
+float BacklashEstimator::getBacklash() const {
+  return mTheta(1, 0) > 0.0f ? 2.0f * mTheta(1, 0) : 0.0f;
+}
+
+float BacklashEstimator::getCompliance() const {
+  return mTheta(2, 0) > 0.0f ? mTheta(2, 0) : 0.0f;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
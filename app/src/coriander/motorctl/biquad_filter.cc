@@ -0,0 +1,111 @@
+/**
+ * @file biquad_filter.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-08
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/biquad_filter.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+BiquadFilter::BiquadFilter()
+    : mB0(1.0f),
+      mB1(0.0f),
+      mB2(0.0f),
+      mA1(0.0f),
+      mA2(0.0f),
+      mS1(0.0f),
+      mS2(0.0f) {}
+
+bool BiquadFilter::setup(Type type, float frequency, float Q, float gain,
+                         float sampleFrequency) {
+  float sinW, cosW, alpha, K, a0;
+
+  // pass through
+  mB0 = 1.0f;
+  mB1 = mB2 = mA1 = mA2 = 0.0f;
+  reset();
+
+  if (type == Type::Bypass || frequency <= 0.0f ||
+      frequency >= 0.5f * sampleFrequency) {
+    return false;
+  }
+
+  // bilinear transform, prewarped at the cutoff/center frequency
+  math::sincosf(2.0f * M_PI * frequency / sampleFrequency, &sinW, &cosW);
+
+  switch (type) {
+    case Type::LowPass:
+    case Type::Notch:
+      if (Q <= 0.0f) {
+        return false;
+      }
+      alpha = sinW / (2.0f * Q);
+      a0 = 1.0f + alpha;
+      mA1 = -2.0f * cosW / a0;
+      mA2 = (1.0f - alpha) / a0;
+      if (type == Type::LowPass) {
+        mB0 = 0.5f * (1.0f - cosW) / a0;
+        mB1 = 2.0f * mB0;
+        mB2 = mB0;
+      } else {
+        // the center gain is the ratio of the alpha terms
+        mB0 = (1.0f + alpha * gain) / a0;
+        mB1 = mA1;
+        mB2 = (1.0f - alpha * gain) / a0;
+      }
+      break;
+    case Type::LeadLag: {
+      if (gain <= 0.0f) {
+        return false;
+      }
+      // zero and pole placed around the center, the phase peaks there
+      float root = math::sqrtf(gain);
+      float wz = 2.0f * M_PI * frequency / root;
+      float wp = 2.0f * M_PI * frequency * root;
+      K = 2.0f * M_PI * frequency * (1.0f + cosW) / sinW;  // w / tan(w/2)
+      a0 = K / wp + 1.0f;
+      mB0 = (K / wz + 1.0f) / a0;
+      mB1 = (1.0f - K / wz) / a0;
+      mA1 = (1.0f - K / wp) / a0;
+      break;
+    }
+    default:
+      return false;
+  }
+  return true;
+}
+
+void BiquadFilter::reset() {
+  mS1 = 0.0f;
+  mS2 = 0.0f;
+}
+
+BiquadChain::BiquadChain() : mStages(), mSize(0) {}
+
+void BiquadChain::setup(const Stage* stages, int n, float sampleFrequency) {
+  mSize = 0;
+  for (int i = 0; i < n && mSize < kMaxStages; i++) {
+    if (mStages[mSize].setup(stages[i].type, stages[i].frequency, stages[i].Q,
+                             stages[i].gain, sampleFrequency)) {
+      mSize++;
+    }
+  }
+}
+
+void BiquadChain::reset() {
+  for (int i = 0; i < mSize; i++) {
+    mStages[i].reset();
+  }
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,128 @@
+/**
+ * @file deadbeat_controller.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-14
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/deadbeat_controller.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+static constexpr float kRadPerDegree = static_cast<float>(M_PI) / 180.0f;
+
+DeadbeatController::DeadbeatController()
+    : mRs(0.0f),
+      mLd(0.0f),
+      mLq(0.0f),
+      mFlux(0.0f),
+      mKp(0.0f),
+      mKi(0.0f),
+      mUd(0.0f),
+      mUq(0.0f),
+      mOmega(0.0f),
+      mAngle(0.0f),
+      mTs(0.0f),
+      mStarted(false),
+      mSeeded(false) {}
+
+void DeadbeatController::setup(float Rs, float Ld, float Lq, float flux,
+                               float bandwidth) {
+  mRs = Rs;
+  mLd = Ld;
+  mLq = Lq;
+  mFlux = flux;
+  // critically damped, as the pll velocity estimator
+  mKp = bandwidth > 0.0f ? 2.0f * bandwidth : 0.0f;
+  mKi = bandwidth * bandwidth;
+  reset();
+}
+
+void DeadbeatController::reset() {
+  mUd = 0.0f;
+  mUq = 0.0f;
+  mOmega = 0.0f;
+  mTs = 0.0f;
+  mStarted = false;
+  mSeeded = false;
+}
+
+void DeadbeatController::operator()(float targetId, float targetIq, float id,
+                                    float iq, float angle, float Ts,
+                                    float *ud, float *uq) {
+  float nextId, nextIq;
+
+  if (!enabled() || Ts <= 0.0f) {
+    *ud = 0.0f;
+    *uq = 0.0f;
+    return;
+  }
+
+  trackAngle(angle, Ts);
+  mTs = Ts;
+
+  // current at the next update, under the voltage still applied
+  nextId = id + Ts / mLd * (mUd - mRs * id + mOmega * mLq * iq);
+  nextIq = iq + Ts / mLq * (mUq - mRs * iq - mOmega * (mLd * id + mFlux));
+
+  // voltage that lands on the target one period later
+  mUd = mRs * nextId - mOmega * mLq * nextIq +
+        mLd * (targetId - nextId) / Ts;
+  mUq = mRs * nextIq + mOmega * (mLd * nextId + mFlux) +
+        mLq * (targetIq - nextIq) / Ts;
+
+  *ud = mUd;
+  *uq = mUq;
+}
+
+void DeadbeatController::trackAngle(float angle, float Ts) {
+  float error;
+
+  if (!mStarted) {
+    // no step on the first sample
+    mAngle = angle;
+    mOmega = 0.0f;
+    mStarted = true;
+    return;
+  }
+
+  // the loop would overshoot past the sample, follow the raw step instead
+  if (!mSeeded || mKp * Ts >= 1.0f || mKp <= 0.0f) {
+    mOmega = base::math::wrapd180(angle - mAngle) * kRadPerDegree / Ts;
+    mAngle = angle;
+    mSeeded = true;
+    return;
+  }
+
+  mAngle += mOmega / kRadPerDegree * Ts;
+  error = base::math::wrapd180(angle - mAngle);
+  mAngle = base::math::wrapd(mAngle + mKp * Ts * error);
+  mOmega += mKi * Ts * error * kRadPerDegree;
+}
+
+void DeadbeatController::backCalculate(float ud, float uq) {
+  mUd = ud;
+  mUq = uq;
+}
+
+void DeadbeatController::advance(float *ud, float *uq) const {
+  float sinTheta, cosTheta, d = *ud, q = *uq;
+
+  // one period of delay, half of the next one the vector stays while the
+  // rotor turns
+  base::math::sincosf(1.5f * mOmega * mTs, &sinTheta, &cosTheta);
+  *ud = d * cosTheta - q * sinTheta;
+  *uq = d * sinTheta + q * cosTheta;
+}
+
+float DeadbeatController::getVelocity() const {
+  return mOmega / kRadPerDegree;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,165 @@
+/**
+ * @file discrete_pid.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-22
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/discrete_pid.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+DiscretePid::DiscretePid(float P, float I, float D, float ramp, float limit)
+    : mP(P),
+      mI(I),
+      mD(D),
+      mTf(0.0f),
+      mTt(0.0f),
+      mRamp(ramp),
+      mLimit(limit),
+      mPScale(1.0f),
+      mIScale(1.0f),
+      mAntiWindup(AntiWindup::BackCalculation),
+      mDirty(true),
+      mTs(0.0f),
+      mKp(0.0f),
+      mKi(0.0f),
+      mKdFilter(0.0f),
+      mKd(0.0f),
+      mKt(0.0f),
+      mIntegral(0.0f),
+      mDerivative(0.0f),
+      mErrorPrev(0.0f),
+      mOutputPrev(0.0f),
+      mExcess(0.0f) {}
+
+void DiscretePid::setGains(float P, float I, float D) {
+  mP = P;
+  mI = I;
+  mD = D;
+  mDirty = true;
+}
+
+void DiscretePid::setRamp(float ramp) { mRamp = ramp; }
+
+void DiscretePid::setLimit(float limit) { mLimit = limit; }
+
+void DiscretePid::setGainScale(float P, float I) {
+  mPScale = P;
+  mIScale = I;
+  mKp = mP * P;
+  mKi = mI * I * 0.5f;
+}
+
+void DiscretePid::setDerivativeFilter(float Tf) {
+  mTf = Tf;
+  mDirty = true;
+}
+
+void DiscretePid::setAntiWindup(AntiWindup mode, float Tt) {
+  mAntiWindup = mode;
+  mTt = Tt;
+  mDirty = true;
+}
+
+void DiscretePid::discretize(float Ts) {
+  // Tustin integral, backward Euler derivative with a first-order filter
+  float inv = 1.0f / (mTf + Ts);
+  mKp = mP * mPScale;
+  mKi = mI * mIScale * 0.5f;
+  mKdFilter = mTf * inv;
+  mKd = mD * inv;
+  mKt = mTt > Ts ? Ts / mTt : 1.0f;
+  mTs = Ts;
+  mDirty = false;
+}
+
+float DiscretePid::operator()(float error, float Ts, float feedForward) {
+  if (Ts <= 0.0f) {
+    return mOutputPrev;
+  }
+  // measured Ts jitters every call, only a real change of the period is
+  // worth the divisions, integral and ramp follow Ts exactly anyway
+  const float tolerance = 0.05f;
+  float deviation = Ts - mTs;
+  if (mDirty || deviation > tolerance * mTs || -deviation > tolerance * mTs) {
+    discretize(Ts);
+  }
+
+  float proportional = mKp * error;
+  // most loops run without D, skip the filter recursion
+  if (mKd != 0.0f) {
+    mDerivative = mKdFilter * mDerivative + mKd * (error - mErrorPrev);
+  }
+
+  float increment = mKi * Ts * (error + mErrorPrev);
+  if (mAntiWindup == AntiWindup::Conditional) {
+    // hold the integral while it pushes further into saturation
+    float output =
+        proportional + mIntegral + increment + mDerivative + feedForward;
+    bool high = output > mLimit || mExcess > 0.0f;
+    bool low = output < -mLimit || mExcess < 0.0f;
+    if ((high && increment > 0.0f) || (low && increment < 0.0f)) {
+      increment = 0.0f;
+    }
+  }
+  float integral = mIntegral + increment;
+  if (mAntiWindup == AntiWindup::Clamp) {
+    integral = math::constrain(integral, -mLimit, mLimit);
+  }
+
+  float output = proportional + integral + mDerivative + feedForward;
+  if (output > mLimit || output < -mLimit) {
+    float saturated = math::constrain(output, -mLimit, mLimit);
+    if (mAntiWindup == AntiWindup::BackCalculation) {
+      integral += mKt * (saturated - output);
+    }
+    output = saturated;
+  }
+  mIntegral = integral;
+
+  if (mRamp > 0.0f) {
+    float rampStep = mRamp * Ts;
+    output = math::constrain(output, mOutputPrev - rampStep,
+                             mOutputPrev + rampStep);
+  }
+
+  mErrorPrev = error;
+  mOutputPrev = output;
+  mExcess = 0.0f;
+  return output;
+}
+
+void DiscretePid::backCalculate(float output) {
+  float excess = mOutputPrev - output;
+  switch (mAntiWindup) {
+    case AntiWindup::Clamp:
+      mIntegral = math::constrain(mIntegral - excess, -mLimit, mLimit);
+      break;
+    case AntiWindup::BackCalculation:
+      mIntegral -= mKt * excess;
+      break;
+    case AntiWindup::Conditional:
+      mExcess = excess;
+      break;
+  }
+  mOutputPrev = output;
+}
+
+void DiscretePid::reset() {
+  mIntegral = 0.0f;
+  mDerivative = 0.0f;
+  mErrorPrev = 0.0f;
+  mOutputPrev = 0.0f;
+  mExcess = 0.0f;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
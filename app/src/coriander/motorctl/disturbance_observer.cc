@@ -0,0 +1,64 @@
+/**
+ * @file disturbance_observer.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-03
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/disturbance_observer.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+DisturbanceObserver::DisturbanceObserver()
+    : mInertia(0.0f),
+      mTorqueConstant(0.0f),
+      mBandwidth(0.0f),
+      mFiltered(0.0f),
+      mLoad(0.0f),
+      mStarted(false) {}
+
+void DisturbanceObserver::setup(float inertia, float torqueConstant,
+                                float bandwidth) {
+  mInertia = inertia;
+  mTorqueConstant = torqueConstant;
+  mBandwidth = bandwidth;
+  reset();
+}
+
+float DisturbanceObserver::operator()(float velocity, float Iq, float Ts) {
+  // RPM to rad/s
+  float omega = velocity * (2.0f * static_cast<float>(M_PI) / 60.0f);
+  float damping, input, alpha;
+
+  if (!enabled()) {
+    return 0.0f;
+  }
+
+  damping = mBandwidth * mInertia * omega;
+  input = mTorqueConstant * Iq + damping;
+  // no acceleration assumed on the first sample, no kick on start
+  if (!mStarted) {
+    mFiltered = input;
+    mStarted = true;
+  }
+  // backward euler, stable for any Ts
+  alpha = mBandwidth * Ts / (1.0f + mBandwidth * Ts);
+  mFiltered += alpha * (input - mFiltered);
+  mLoad = mFiltered - damping;
+
+  return mLoad / mTorqueConstant;
+}
+
+void DisturbanceObserver::reset() {
+  mFiltered = 0.0f;
+  mLoad = 0.0f;
+  mStarted = false;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
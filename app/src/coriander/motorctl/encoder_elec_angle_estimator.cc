@@ -13,11 +13,7 @@
 
 namespace {
 static float modular_angle(float angle) {
-  angle = coriander::base::math::fmodf(angle, 360.0f);
-  if (angle < 0) {
-    angle += 360.0f;
-  }
-  return angle;
+  return coriander::base::math::wrapd(angle);
 }
 static inline float reverse_angle(float angle) {
   angle = modular_angle(-angle);
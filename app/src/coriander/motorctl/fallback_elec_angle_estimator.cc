@@ -0,0 +1,123 @@
+/**
+ * @file fallback_elec_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/fallback_elec_angle_estimator.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+FallbackElecAngleEstimator::FallbackElecAngleEstimator(
+    std::shared_ptr<EncoderElecAngleEstimator> encoder,
+    std::shared_ptr<SensorlessElecAngleEstimator> sensorless,
+    std::shared_ptr<Diagnosis> diagnosis, std::shared_ptr<Parameter> param,
+    std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept
+    : mEncoder(encoder),
+      mSensorless(sensorless),
+      mDiagnosis(diagnosis),
+      mParam(param),
+      mFaultThreshold(0.0f),
+      mFaultCount(0),
+      mBadCount(0),
+      mUseSensorless(false),
+      mFailed(false),
+      mEnabled(false) {
+  paramReqValidator->addParamReq(this);
+
+  mDiagnosis->setDiagDev(Diagnosis::DiagDevId::MotorInnerPosSensor, [this]() {
+    return mFailed ? Diagnosis::DeviceStatus::Error
+                   : Diagnosis::DeviceStatus::Normal;
+  });
+}
+
+void FallbackElecAngleEstimator::enable() {
+  mFaultThreshold =
+      mParam->getValue<float>(ParamId::MotorCtl_Sensorless_FaultThreshold);
+  mFaultCount =
+      mParam->getValue<int32_t>(ParamId::MotorCtl_Sensorless_FaultCount);
+
+  for (IElecAngleEstimator* sensor :
+       {static_cast<IElecAngleEstimator*>(mEncoder.get()),
+        static_cast<IElecAngleEstimator*>(mSensorless.get())}) {
+    if (!sensor->enabled()) {
+      sensor->enable();
+    }
+    sensor->reset();  // reset sync count
+  }
+  if (!mEncoder->needCalibrate()) {
+    mSensorless->setElectricalAngle(mEncoder->getElectricalAngle());
+  }
+  mBadCount = 0;
+  mUseSensorless = false;
+  mFailed = false;
+  // give the encoder another chance, the diagnosis polls the status
+  mEnabled = true;
+}
+
+void FallbackElecAngleEstimator::disable() {
+  if (mEncoder->enabled()) {
+    mEncoder->disable();
+  }
+  if (mSensorless->enabled()) {
+    mSensorless->disable();
+  }
+  mEnabled = false;
+}
+
+void FallbackElecAngleEstimator::sync() {
+  float diff;
+
+  if (mEncoder->needSync(mSyncId)) {
+    mEncoder->sync();
+  }
+  if (mSensorless->needSync(mSyncId)) {
+    mSensorless->sync();
+  }
+
+  // an uncalibrated encoder has no relation to the rotor flux yet
+  if (mFailed || mEncoder->needCalibrate()) {
+    return;
+  }
+
+  diff = base::math::wrapd180(mEncoder->getElectricalAngle() -
+                              mSensorless->getElectricalAngle());
+  if (mSensorless->converged() &&
+      (diff > mFaultThreshold || diff < -mFaultThreshold)) {
+    mUseSensorless = true;
+    if (++mBadCount >= mFaultCount) {
+      mFailed = true;  // polled by the diagnosis, not reported from here
+    }
+  } else {
+    mUseSensorless = false;
+    mBadCount = 0;
+  }
+}
+
+bool FallbackElecAngleEstimator::enabled() { return mEnabled; }
+
+void FallbackElecAngleEstimator::calibrate() { mEncoder->calibrate(); }
+
+bool FallbackElecAngleEstimator::needCalibrate() {
+  return mEncoder->needCalibrate();
+}
+
+float FallbackElecAngleEstimator::getElectricalAngle() noexcept {
+  if (mUseSensorless || mFailed) {
+    return mSensorless->getElectricalAngle();
+  }
+  return mEncoder->getElectricalAngle();
+}
+
+void FallbackElecAngleEstimator::setVoltage(float alpha, float beta) noexcept {
+  mSensorless->setVoltage(alpha, beta);
+}
+
+}  // namespace motorctl
+}  // namespace coriander
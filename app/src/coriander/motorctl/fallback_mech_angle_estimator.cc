@@ -0,0 +1,84 @@
+/**
+ * @file fallback_mech_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-16
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/fallback_mech_angle_estimator.h"
+
+namespace coriander {
+namespace motorctl {
+
+FallbackMechAngleEstimator::FallbackMechAngleEstimator(
+    std::shared_ptr<EncoderMechAngleEstimator> encoder,
+    std::shared_ptr<FallbackElecAngleEstimator> fallback,
+    std::shared_ptr<ISystick> systick, std::shared_ptr<Parameter> param,
+    std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept
+    : mEncoder(encoder),
+      mFallback(fallback),
+      mSystick(systick),
+      mParam(param),
+      mElecToMech(1.0f),
+      mMechAngle(0.0f),
+      mTimestamp(0) {
+  paramReqValidator->addParamReq(this);
+}
+
+void FallbackMechAngleEstimator::enable() {
+  mElecToMech = 1.0f / static_cast<float>(mParam->getValue<int32_t>(
+                           ParamId::MotorCtl_MotorDriver_PolePair));
+  if (!mEncoder->enabled()) {
+    mEncoder->enable();
+  }
+  mMechAngle = mEncoder->getMechanicalAngle();
+  mTimestamp = mSystick->systick_us();
+}
+
+void FallbackMechAngleEstimator::disable() {
+  if (mEncoder->enabled()) {
+    mEncoder->disable();
+  }
+}
+
+bool FallbackMechAngleEstimator::enabled() { return mEncoder->enabled(); }
+
+void FallbackMechAngleEstimator::sync() {
+  uint32_t current = mSystick->systick_us();
+  float dt = (current - mTimestamp) * 1e-6f;
+
+  if (mEncoder->needSync(mSyncId)) {
+    mEncoder->sync();
+  }
+  mTimestamp = current;
+
+  // the observer speed is electrical degree per second
+  if (mFallback->failed()) {
+    mMechAngle += mFallback->getObserverVelocity() * mElecToMech * dt;
+  } else {
+    mMechAngle = mEncoder->getMechanicalAngle();
+  }
+}
+
+void FallbackMechAngleEstimator::reset() {
+  ISensor::reset();
+  mEncoder->reset();
+}
+
+void FallbackMechAngleEstimator::calibrate() { mEncoder->calibrate(); }
+
+bool FallbackMechAngleEstimator::needCalibrate() {
+  return mEncoder->needCalibrate();
+}
+
+float FallbackMechAngleEstimator::getMechanicalAngle() noexcept {
+  if (!mFallback->failed()) {
+    mMechAngle = mEncoder->getMechanicalAngle();
+  }
+  return mMechAngle;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,53 @@
+/**
+ * @file field_weakening.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-25
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/field_weakening.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+FieldWeakening::FieldWeakening()
+    : mP(0.0f),
+      mI(0.0f),
+      mThreshold(1.0f),
+      mMaxCurrent(0.0f),
+      mIntegral(0.0f) {}
+
+void FieldWeakening::setLimits(float threshold, float maxCurrent) {
+  mThreshold = threshold;
+  mMaxCurrent = maxCurrent > 0.0f ? maxCurrent : 0.0f;
+}
+
+void FieldWeakening::setGains(float P, float I) {
+  mP = P;
+  mI = I;
+}
+
+float FieldWeakening::operator()(float modulationIndex, float Ts) {
+  float error, output;
+
+  if (!enabled()) {
+    return 0.0f;
+  }
+
+  // positive while there is voltage headroom, that drives Id back to zero
+  error = mThreshold - modulationIndex;
+  mIntegral = math::constrain(mIntegral + mI * error * Ts, -mMaxCurrent, 0.0f);
+  output = math::constrain(mP * error + mIntegral, -mMaxCurrent, 0.0f);
+  return output;
+}
+
+void FieldWeakening::reset() { mIntegral = 0.0f; }
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,79 @@
+/**
+ * @file flux_observer.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/flux_observer.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+FluxObserver::FluxObserver()
+    : mRs(0.0f),
+      mLs(0.0f),
+      mFluxSquare(0.0f),
+      mGain(0.0f),
+      mKp(0.0f),
+      mKi(0.0f),
+      mFluxAlpha(0.0f),
+      mFluxBeta(0.0f),
+      mAngle(0.0f),
+      mPllAngle(0.0f),
+      mVelocity(0.0f) {}
+
+void FluxObserver::setup(float Rs, float Ls, float flux, float gain,
+                         float bandwidth) {
+  mRs = Rs;
+  mLs = Ls;
+  mFluxSquare = flux * flux;
+  mGain = mFluxSquare > 0.0f ? gain / mFluxSquare : 0.0f;
+  mKp = 2.0f * bandwidth;
+  mKi = bandwidth * bandwidth;
+  reset();
+}
+
+void FluxObserver::reset(float angle) {
+  float s, c, flux = math::sqrtf(mFluxSquare);
+
+  math::sincosd(angle, &s, &c);
+  mFluxAlpha = flux * c;
+  mFluxBeta = flux * s;
+  mAngle = math::wrapd(angle);
+  mPllAngle = mAngle;
+  mVelocity = 0.0f;
+}
+
+void FluxObserver::operator()(float valpha, float vbeta, float ialpha,
+                              float ibeta, float Ts) {
+  float rotorAlpha, rotorBeta, err;
+
+  // rotor flux, pulled onto the circle of the flux linkage
+  rotorAlpha = mFluxAlpha - mLs * ialpha;
+  rotorBeta = mFluxBeta - mLs * ibeta;
+  err = mFluxSquare - (rotorAlpha * rotorAlpha + rotorBeta * rotorBeta);
+  mFluxAlpha += (valpha - mRs * ialpha + mGain * rotorAlpha * err) * Ts;
+  mFluxBeta += (vbeta - mRs * ibeta + mGain * rotorBeta * err) * Ts;
+
+  rotorAlpha = mFluxAlpha - mLs * ialpha;
+  rotorBeta = mFluxBeta - mLs * ibeta;
+  mAngle = math::wrapd(math::atan2f(rotorBeta, rotorAlpha) *
+                       (180.0f / static_cast<float>(M_PI)));
+
+  // speed from the angle, same loop as PllVelocityEstimator on a wrapped
+  // angle
+  mPllAngle += mVelocity * Ts;
+  err = math::wrapd180(mAngle - mPllAngle);
+  mPllAngle = math::wrapd(mPllAngle + mKp * Ts * err);
+  mVelocity += mKi * Ts * err;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
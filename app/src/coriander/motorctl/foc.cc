@@ -10,18 +10,30 @@
 
 #include "coriander/motorctl/foc.h"
 
-#include <assert.h>
 #include <math.h>
 
 #include <cmath>
 
-namespace {
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
 
 // slow version of svpwm
-static inline void svpwm_slow(float alpha, float beta, float Ts, float Udc,
-                              float* tu, float* tv, float* tw) {
-  float theta, sector_angle, u_ref, u_ref_percent, ts_half, t0_half, t1, t2,
-      v[4], o[3];
+void foc::detail::svpwm_slow(float alpha, float beta, float Ts, float Udc,
+                             float* tu, float* tv, float* tw) {
+  float u_ref, scale;
+
+  // calulate reference voltage
+  u_ref = sqrtf(alpha * alpha + beta * beta);
+  scale = u_ref > Udc ? 1.0f / u_ref : 1.0f / Udc;
+  svpwm_sector(alpha * scale, beta * scale, Ts, tu, tv, tw);
+}
+
+void foc::detail::svpwm_sector(float alpha, float beta, float Ts, float* tu,
+                               float* tv, float* tw) {
+  float theta, sector_angle, u_ref_percent, ts_half, t0_half, t1, t2, v[4],
+      o[3];
   int sector;
 
   constexpr const float sqrt_3 = 1.7320508075688772935274463415059f;
@@ -37,12 +49,7 @@ static inline void svpwm_slow(float alpha, float beta, float Ts, float Udc,
   sector = static_cast<int>(floorf(theta / pi_3));
   sector_angle = theta - sector * pi_3;
 
-  // calulate reference voltage
-  u_ref = sqrtf(alpha * alpha + beta * beta);
-  if (u_ref > Udc) {
-    u_ref = Udc;
-  }
-  u_ref_percent = u_ref * sqrt_3 / Udc;
+  u_ref_percent = sqrtf(alpha * alpha + beta * beta) * sqrt_3;
 
   // calulate switch time
   ts_half = Ts / 2;
@@ -99,23 +106,281 @@ static inline void svpwm_slow(float alpha, float beta, float Ts, float Udc,
     }
   }
   center_offset = ts_half - (max + min) / 2;
+  // on the hexagon t0 is zero, only rounding is left outside
   for (int i = 0; i < 3; i++) {
     o[i] += center_offset;
-    assert(o[i] > 0 && o[i] < Ts);
+    o[i] = o[i] < 0 ? 0 : (o[i] > Ts ? Ts : o[i]);
   }
   *tu = o[0];
   *tv = o[1];
   *tw = o[2];
 }
-}  // namespace
 
-namespace coriander {
-namespace motorctl {
+// fast version of svpwm
+void foc::detail::svpwm_fast(float alpha, float beta, float Ts, float Udc,
+                             float* tu, float* tv, float* tw) {
+  float u_ref_square, scale, va, vb, vc, v_max, v_min, offset, ts_half;
+
+  constexpr const float sqrt_3_2 = 0.86602540378443864676372317075294f;
+
+  // limit reference voltage, sqrtf is only taken when saturated
+  u_ref_square = alpha * alpha + beta * beta;
+  if (u_ref_square > Udc * Udc) {
+    scale = Udc / base::math::sqrtf(u_ref_square);
+    alpha *= scale;
+    beta *= scale;
+  }
+
+  // phase voltages, inverse clarke
+  va = alpha;
+  vb = -0.5f * alpha + sqrt_3_2 * beta;
+  vc = -0.5f * alpha - sqrt_3_2 * beta;
+
+  // min/max zero-sequence injection, the result is the same as a centerized
+  // seven-segment svpwm
+  v_max = va > vb ? va : vb;
+  v_max = v_max > vc ? v_max : vc;
+  v_min = va < vb ? va : vb;
+  v_min = v_min < vc ? v_min : vc;
+  offset = (v_max + v_min) * 0.5f;
+
+  // map [-Udc, Udc] to [0, Ts]
+  ts_half = Ts / 2;
+  scale = ts_half / Udc;
+  *tu = ts_half + (va - offset) * scale;
+  *tv = ts_half + (vb - offset) * scale;
+  *tw = ts_half + (vc - offset) * scale;
+}
+
+float foc::maxVoltage(Modulation mode) {
+  switch (mode) {
+    case Modulation::OverModulationI:
+      return 1.33333333333f;  // 4/3, hexagon vertex
+    case Modulation::OverModulationII:
+      return 1.27323954474f;  // 4/pi, six-step fundamental
+    case Modulation::Linear:
+    default:
+      return 1.15470053838f;  // 2/sqrt(3), inscribed circle
+  }
+}
+
+// hold the vector angle towards the hexagon vertices, from zero at the end of
+// overmodulation I to pi/6 (six-step) at 4/pi
+static void overmodulation_hold(float* alpha, float* beta) {
+  constexpr const float pi = 3.1415926535897932384626433832795f;
+  constexpr const float pi_3 = pi / 3, pi_6 = pi / 6;
+  constexpr const float six_step = 1.27323954474f;
+  // fundamental of the hexagon trajectory, 0.9517 of six-step
+  constexpr const float om1_max = 0.9517f * six_step;
+  float u_ref, hold, theta, sector_angle;
+  int sector;
+
+  u_ref = base::math::sqrtf(*alpha * *alpha + *beta * *beta);
+  if (u_ref <= om1_max) {
+    return;
+  }
+  hold = (u_ref - om1_max) / (six_step - om1_max);
+  hold = (hold > 1.0f ? 1.0f : hold) * pi_6;
+
+  theta = base::math::atan2f(*beta, *alpha);
+  if (theta < 0) {
+    theta += 2 * pi;
+  }
+  sector = static_cast<int>(theta / pi_3);
+  sector_angle = theta - sector * pi_3;
+  if (sector_angle <= hold) {
+    sector_angle = 0;
+  } else if (sector_angle >= pi_3 - hold) {
+    sector_angle = pi_3;
+  } else {
+    sector_angle = (sector_angle - hold) * pi_6 / (pi_6 - hold);
+  }
 
-void foc::SpaceVectorPwm(float alpha, float beta, float* du, float* dv,
-                         float* dw) {
-  ::svpwm_slow(alpha, beta, 1, 1, du, dv, dw);
+  // push the vector out of the hexagon, it is clipped afterwards
+  theta = sector * pi_3 + sector_angle;
+  base::math::sincosf(theta, beta, alpha);
+  *alpha *= 2.0f;
+  *beta *= 2.0f;
 }
 
+void foc::SpaceVectorPwm(Modulation mode, float alpha, float beta, float* du,
+                         float* dv, float* dw) {
+  SpaceVectorPwm(mode, PwmMode::Continuous, alpha, beta, du, dv, dw);
+}
+
+void foc::SpaceVectorPwm(Modulation mode, PwmMode pwm, float alpha, float beta,
+                         float* du, float* dv, float* dw) {
+  constexpr const float sqrt_3_2 = 0.86602540378443864676372317075294f;
+  float va, vb, vc, v_max, v_min, offset, scale;
+
+  if (mode == Modulation::Linear) {
+    float u_max = maxVoltage(mode);
+    float u_ref_square = alpha * alpha + beta * beta;
+    if (u_ref_square > u_max * u_max) {
+      scale = u_max / base::math::sqrtf(u_ref_square);
+      alpha *= scale;
+      beta *= scale;
+    }
+  } else if (mode == Modulation::OverModulationII) {
+    overmodulation_hold(&alpha, &beta);
+  }
+
+  va = alpha;
+  vb = -0.5f * alpha + sqrt_3_2 * beta;
+  vc = -0.5f * alpha - sqrt_3_2 * beta;
+
+  v_max = va > vb ? va : vb;
+  v_max = v_max > vc ? v_max : vc;
+  v_min = va < vb ? va : vb;
+  v_min = v_min < vc ? v_min : vc;
+
+  // clip to the hexagon and keep the angle, line voltage is up to the full
+  // bus(2)
+  if (v_max - v_min > 2.0f) {
+    scale = 2.0f / (v_max - v_min);
+    alpha *= scale;
+    beta *= scale;
+    va *= scale;
+    vb *= scale;
+    vc *= scale;
+    v_max *= scale;
+    v_min *= scale;
+  }
+
+#if CONFIG_CORIANDER_SVPWM_SECTOR
+  // the selected kernel on the limited vector, it only knows the centered
+  // zero-sequence
+  if (pwm == PwmMode::Continuous) {
+    detail::svpwm_sector(alpha, beta, 1, du, dv, dw);
+    return;
+  }
+#endif
+
+  // zero-sequence, discontinuous modes move one phase onto a rail(+-1)
+  switch (pwm) {
+    case PwmMode::DpwmMin:
+      offset = v_min + 1.0f;
+      break;
+    case PwmMode::DpwmMax:
+      offset = v_max - 1.0f;
+      break;
+    case PwmMode::Dpwm60:
+      offset = v_max + v_min >= 0 ? v_max - 1.0f : v_min + 1.0f;
+      break;
+    case PwmMode::Dpwm30:
+      offset = v_max + v_min >= 0 ? v_min + 1.0f : v_max - 1.0f;
+      break;
+    case PwmMode::Continuous:
+    default:
+      offset = (v_max + v_min) * 0.5f;
+      break;
+  }
+
+  *du = 0.5f + (va - offset) * 0.5f;
+  *dv = 0.5f + (vb - offset) * 0.5f;
+  *dw = 0.5f + (vc - offset) * 0.5f;
+}
+
+bool foc::limitVoltage(float* d, float* q, float max) {
+  float q_max;
+  bool saturated = false;
+
+  if (*d > max) {
+    *d = max;
+    saturated = true;
+  } else if (*d < -max) {
+    *d = -max;
+    saturated = true;
+  }
+
+  q_max = base::math::sqrtf(max * max - *d * *d);
+  if (*q > q_max) {
+    *q = q_max;
+    saturated = true;
+  } else if (*q < -q_max) {
+    *q = -q_max;
+    saturated = true;
+  }
+  return saturated;
+}
+
+void foc::compensateDeadTime(float alpha, float beta, float deadTime,
+                             float band, float* du, float* dv, float* dw) {
+  // closer to a rail than a timer tick, the phase does not switch
+  const float clamped = 1e-4f;
+  float current[3];
+  float* duty[3] = {du, dv, dw};
+  float k;
+
+  invClarke(alpha, beta, &current[0], &current[1]);
+  current[2] = -current[0] - current[1];
+
+  // saturated ramp instead of sign(), no chattering around zero crossing
+  k = deadTime / band;
+  for (int i = 0; i < 3; i++) {
+    // no dead time on a clamped phase, e.g. discontinuous pwm, keep it there
+    if (*duty[i] < clamped || *duty[i] > 1.0f - clamped) {
+      continue;
+    }
+    float d = current[i] * k;
+    d = d > deadTime ? deadTime : d;
+    d = d < -deadTime ? -deadTime : d;
+    d += *duty[i];
+    d = d > 1.0f ? 1.0f : d;
+    d = d < 0.0f ? 0.0f : d;
+    *duty[i] = d;
+  }
+}
+
+template <typename N>
+void foc::SpaceVectorPwm(Value<N> alpha, Value<N> beta, Value<N>* du,
+                         Value<N>* dv, Value<N>* dw) {
+  using V = Value<N>;
+  using G = typename N::Gain;
+
+  // limit |u| to 1, |u|^2 is up to 2 so it is computed in gain type
+  G a = G(alpha), b = G(beta);
+  G u_ref_square = a * a + b * b;
+  if (u_ref_square > G(1.0f)) {
+    G u_ref = N::sqrt(u_ref_square);
+    alpha = alpha / u_ref;
+    beta = beta / u_ref;
+  }
+
+  const V half = V(0.5f);
+  V alpha_half = alpha * half, beta_sqrt_3_2 = beta * V(0.86602540378f);
+  V va = alpha;
+  V vb = beta_sqrt_3_2 - alpha_half;
+  V vc = -alpha_half - beta_sqrt_3_2;
+
+  V v_max = va > vb ? va : vb;
+  v_max = v_max > vc ? v_max : vc;
+  V v_min = va < vb ? va : vb;
+  v_min = v_min < vc ? v_min : vc;
+  // (max + min) / 2 may overflow before halved
+  V offset = v_max * half + v_min * half;
+
+  *du = half + (va - offset) * half;
+  *dv = half + (vb - offset) * half;
+  *dw = half + (vc - offset) * half;
+}
+
+template <>
+void foc::SpaceVectorPwm<base::FloatNumeric>(float alpha, float beta,
+                                             float* du, float* dv, float* dw) {
+#if CONFIG_CORIANDER_SVPWM_SECTOR
+  foc::detail::svpwm_slow(alpha, beta, 1, 1, du, dv, dw);
+#else
+  foc::detail::svpwm_fast(alpha, beta, 1, 1, du, dv, dw);
+#endif
+}
+
+template void foc::SpaceVectorPwm<base::Q15Numeric>(base::Q15, base::Q15,
+                                                    base::Q15*, base::Q15*,
+                                                    base::Q15*);
+template void foc::SpaceVectorPwm<base::Q31Numeric>(base::Q31, base::Q31,
+                                                    base::Q31*, base::Q31*,
+                                                    base::Q31*);
+
 }  // namespace motorctl
 }  // namespace coriander
@@ -0,0 +1,210 @@
+/**
+ * @file foc_batch.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-20
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/foc_batch.h"
+
+#include <cmath>
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#include <arm_mve.h>
+#define FOC_BATCH_MVE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FOC_BATCH_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FOC_BATCH_SSE 1
+#endif
+
+namespace coriander {
+namespace motorctl {
+
+namespace {
+
+/**
+ * @brief one float per step, tail of every kernel
+ */
+struct Scalar {
+  static constexpr int lanes = 1;
+  float v;
+
+  static Scalar load(const float* p) { return {*p}; }
+  static Scalar dup(float x) { return {x}; }
+  void store(float* p) const { *p = v; }
+
+  friend Scalar operator+(Scalar a, Scalar b) { return {a.v + b.v}; }
+  friend Scalar operator-(Scalar a, Scalar b) { return {a.v - b.v}; }
+  friend Scalar operator*(Scalar a, Scalar b) { return {a.v * b.v}; }
+  friend Scalar min(Scalar a, Scalar b) { return {a.v < b.v ? a.v : b.v}; }
+  friend Scalar max(Scalar a, Scalar b) { return {a.v > b.v ? a.v : b.v}; }
+  // 1 / sqrt(max(x, 1)), scale of the circle limit
+  friend Scalar limit_scale(Scalar x) {
+    return {x.v > 1.0f ? 1.0f / std::sqrt(x.v) : 1.0f};
+  }
+};
+
+#if FOC_BATCH_MVE || FOC_BATCH_NEON
+struct Simd {
+  static constexpr int lanes = 4;
+  float32x4_t v;
+
+  static Simd load(const float* p) { return {vld1q_f32(p)}; }
+  static Simd dup(float x) { return {vdupq_n_f32(x)}; }
+  void store(float* p) const { vst1q_f32(p, v); }
+
+  friend Simd operator+(Simd a, Simd b) { return {vaddq_f32(a.v, b.v)}; }
+  friend Simd operator-(Simd a, Simd b) { return {vsubq_f32(a.v, b.v)}; }
+  friend Simd operator*(Simd a, Simd b) { return {vmulq_f32(a.v, b.v)}; }
+#if FOC_BATCH_MVE
+  friend Simd min(Simd a, Simd b) { return {vminnmq_f32(a.v, b.v)}; }
+  friend Simd max(Simd a, Simd b) { return {vmaxnmq_f32(a.v, b.v)}; }
+#else
+  friend Simd min(Simd a, Simd b) { return {vminq_f32(a.v, b.v)}; }
+  friend Simd max(Simd a, Simd b) { return {vmaxq_f32(a.v, b.v)}; }
+#endif
+  friend Simd limit_scale(Simd x) {
+#if defined(__aarch64__)
+    float32x4_t one = vdupq_n_f32(1.0f);
+    return {vdivq_f32(one, vsqrtq_f32(vmaxq_f32(x.v, one)))};
+#else
+    // no vector sqrt/div, saturation is rare so the lanes are solved alone
+    float buf[4];
+    vst1q_f32(buf, x.v);
+    for (float& b : buf) {
+      b = limit_scale(Scalar{b}).v;
+    }
+    return {vld1q_f32(buf)};
+#endif
+  }
+};
+#elif FOC_BATCH_SSE
+struct Simd {
+  static constexpr int lanes = 4;
+  __m128 v;
+
+  static Simd load(const float* p) { return {_mm_loadu_ps(p)}; }
+  static Simd dup(float x) { return {_mm_set1_ps(x)}; }
+  void store(float* p) const { _mm_storeu_ps(p, v); }
+
+  friend Simd operator+(Simd a, Simd b) { return {_mm_add_ps(a.v, b.v)}; }
+  friend Simd operator-(Simd a, Simd b) { return {_mm_sub_ps(a.v, b.v)}; }
+  friend Simd operator*(Simd a, Simd b) { return {_mm_mul_ps(a.v, b.v)}; }
+  friend Simd min(Simd a, Simd b) { return {_mm_min_ps(a.v, b.v)}; }
+  friend Simd max(Simd a, Simd b) { return {_mm_max_ps(a.v, b.v)}; }
+  friend Simd limit_scale(Simd x) {
+    __m128 one = _mm_set1_ps(1.0f);
+    return {_mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(x.v, one)))};
+  }
+};
+#else
+using Simd = Scalar;
+#endif
+
+/**
+ * @brief run kernel K over [0, n), Simd steps first and Scalar for the tail
+ */
+template <typename K>
+static inline void for_each(int n, K kernel) {
+  int i = 0;
+  if (Simd::lanes > 1) {
+    for (; i + Simd::lanes <= n; i += Simd::lanes) {
+      kernel(Simd(), i);
+    }
+  }
+  for (; i < n; i++) {
+    kernel(Scalar(), i);
+  }
+}
+
+}  // namespace
+
+int foc::batch::lanes() { return Simd::lanes; }
+
+void foc::batch::clarke(const float* a, const float* b, float* alpha,
+                        float* beta, int n) {
+  for_each(n, [=](auto v, int i) {
+    using V = decltype(v);
+    const V k = V::dup(0.57735026919f);
+    V va = V::load(a + i), vb = V::load(b + i);
+    V t = vb * k;
+    va.store(alpha + i);
+    (va * k + t + t).store(beta + i);
+  });
+}
+
+void foc::batch::park(const float* alpha, const float* beta,
+                      const float* sinTheta, const float* cosTheta, float* d,
+                      float* q, int n) {
+  for_each(n, [=](auto v, int i) {
+    using V = decltype(v);
+    V a = V::load(alpha + i), b = V::load(beta + i);
+    V s = V::load(sinTheta + i), c = V::load(cosTheta + i);
+    (a * c + b * s).store(d + i);
+    (b * c - a * s).store(q + i);
+  });
+}
+
+void foc::batch::invPark(const float* d, const float* q,
+                         const float* sinTheta, const float* cosTheta,
+                         float* alpha, float* beta, int n) {
+  for_each(n, [=](auto v, int i) {
+    using V = decltype(v);
+    V vd = V::load(d + i), vq = V::load(q + i);
+    V s = V::load(sinTheta + i), c = V::load(cosTheta + i);
+    (vd * c - vq * s).store(alpha + i);
+    (vd * s + vq * c).store(beta + i);
+  });
+}
+
+void foc::batch::SpaceVectorPwm(const float* alpha, const float* beta,
+                                float* du, float* dv, float* dw, int n) {
+  for_each(n, [=](auto v, int i) {
+    using V = decltype(v);
+    const V half = V::dup(0.5f), sqrt_3_2 = V::dup(0.86602540378f);
+    V a = V::load(alpha + i), b = V::load(beta + i);
+
+    V scale = limit_scale(a * a + b * b);
+    a = a * scale;
+    b = b * scale;
+
+    V va = a;
+    V vb = sqrt_3_2 * b - half * a;
+    V vc = V::dup(0.0f) - half * a - sqrt_3_2 * b;
+    V offset = (max(max(va, vb), vc) + min(min(va, vb), vc)) * half;
+
+    (half + (va - offset) * half).store(du + i);
+    (half + (vb - offset) * half).store(dv + i);
+    (half + (vc - offset) * half).store(dw + i);
+  });
+}
+
+void foc::batch::pi(const PiArrays& pi, const float* error, float Ts,
+                    float* output, int n) {
+  for_each(n, [=](auto v, int i) {
+    using V = decltype(v);
+    V e = V::load(error + i), e_prev = V::load(pi.errorPrev + i);
+    V limit = V::load(pi.limit + i), neg_limit = V::dup(0.0f) - limit;
+
+    // Tustin transform of the integral part, same order as Pid
+    V integral_gain = V::load(pi.I + i) * V::dup(Ts * 0.5f);
+    V integral = V::load(pi.integral + i) + e * integral_gain +
+                 e_prev * integral_gain;
+    integral = min(max(integral, neg_limit), limit);
+
+    V out = e * V::load(pi.P + i) + integral;
+    out = min(max(out, neg_limit), limit);
+
+    integral.store(pi.integral + i);
+    e.store(pi.errorPrev + i);
+    out.store(output + i);
+  });
+}
+
+}  // namespace motorctl
+}  // namespace coriander
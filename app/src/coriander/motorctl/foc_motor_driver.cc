@@ -16,25 +16,81 @@ namespace coriander {
 namespace motorctl {
 
 void FocMotorDriverBase::setVoltageNoSensor(float d, float q, float angle) {
-  float elecAngle = angle;
-  float elecAngleRad = elecAngle / 180.0f * M_PI;
-  float sinTheta = sinf(elecAngleRad);
-  float cosTheta = cosf(elecAngleRad);
+  float sinTheta, cosTheta;
+
+  base::math::sincosd(angle, &sinTheta, &cosTheta);
+  setVoltageNoSensor(d, q, sinTheta, cosTheta);
+}
+
+void FocMotorDriverBase::setVoltageNoSensor(float d, float q, float sinTheta,
+                                            float cosTheta) {
   float alpha, beta;
   float vu, vv, vw;
+  float u_ref_square, hysteresis;
   uint16_t u, v, w;
 
+  // discontinuous pwm only above the threshold, 5% hysteresis against
+  // toggling around it, on the modulation index actually applied
+  u_ref_square = (d * d + q * q) * mBusScale * mBusScale;
+  hysteresis = mPwmThreshold * 0.95f;
+  if (u_ref_square > mPwmThreshold * mPwmThreshold) {
+    mDiscontinuous = true;
+  } else if (u_ref_square < hysteresis * hysteresis) {
+    mDiscontinuous = false;
+  }
+
   foc::invPark(d, q, sinTheta, cosTheta, &alpha, &beta);
-  foc::SpaceVectorPwm(alpha, beta, &vu, &vv, &vw);
+  mVoltageAlpha = alpha;
+  mVoltageBeta = beta;
+  alpha *= mBusScale;
+  beta *= mBusScale;
+  foc::SpaceVectorPwm(mModulation,
+                      mDiscontinuous ? mPwmMode : foc::PwmMode::Continuous,
+                      alpha, beta, &vu, &vv, &vw);
+  // only on a current measured for this period, the open loop and
+  // calibration drive without one
+  if (mDeadTime > 0.0f && mCurrentFresh) {
+    foc::compensateDeadTime(mCurrentAlpha, mCurrentBeta, mDeadTime,
+                            mDeadTimeCurrentBand, &vu, &vv, &vw);
+  }
+  mCurrentFresh = false;
   u = static_cast<uint16_t>(vu * UINT16_MAX);
   v = static_cast<uint16_t>(vv * UINT16_MAX);
   w = static_cast<uint16_t>(vw * UINT16_MAX);
   setPhaseDutyCycle(u, v, w);
 }
 
+void FocMotorDriverBase::setDeadTime(float deadTime, float currentBand) {
+  // band must stay positive, it divides the phase current
+  const float minBand = 1e-3f;
+  mDeadTime = deadTime;
+  mDeadTimeCurrentBand = currentBand > minBand ? currentBand : minBand;
+}
+
+void FocMotorDriverBase::setBusVoltage(float voltage) {
+  // a collapsing bus is under-voltage, not something to follow
+  const float maxScale = 2.0f;
+  mBusVoltage = voltage;
+  if (mSupplyVoltage <= 0.0f || voltage <= 0.0f) {
+    mBusScale = 1.0f;
+  } else if (voltage * maxScale < mSupplyVoltage) {
+    mBusScale = maxScale;
+  } else {
+    mBusScale = mSupplyVoltage / voltage;
+  }
+}
+
 void FocMotorDriver::setVoltage(float d, float q) {
+  // injection first, it may move the estimated angle
+  float injection = mElecAngleEstimator->nextInjection();
   float angle = mElecAngleEstimator->getElectricalAngle();
-  setVoltageNoSensor(d, q, angle);
+  setVoltageNoSensor(d + injection, q, angle);
+}
+
+void FocMotorDriver::setVoltage(float d, float q, float sinTheta,
+                                float cosTheta) {
+  float injection = mElecAngleEstimator->nextInjection();
+  setVoltageNoSensor(d + injection, q, sinTheta, cosTheta);
 }
 
 }  // namespace motorctl
@@ -0,0 +1,65 @@
+/**
+ * @file gain_schedule.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-27
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/gain_schedule.h"
+
+namespace coriander {
+namespace motorctl {
+
+GainSchedule::GainSchedule() : mPoints(), mSize(0), mSegment(0) {}
+
+void GainSchedule::setup(const Point* points, int n) {
+  mSize = 0;
+  mSegment = 0;
+  for (int i = 0; i < n && i < kMaxPoints; i++) {
+    if (i > 0 && points[i].x <= points[i - 1].x) {
+      break;
+    }
+    mPoints[mSize++] = points[i];
+  }
+}
+
+void GainSchedule::operator()(float x, float* P, float* I) {
+  float t;
+
+  if (mSize == 0) {
+    *P = 1.0f;
+    *I = 1.0f;
+    return;
+  }
+
+  x = x < 0.0f ? -x : x;
+  if (mSize == 1 || x <= mPoints[0].x) {
+    *P = mPoints[0].P;
+    *I = mPoints[0].I;
+    return;
+  }
+  if (x >= mPoints[mSize - 1].x) {
+    *P = mPoints[mSize - 1].P;
+    *I = mPoints[mSize - 1].I;
+    return;
+  }
+
+  // walk from the last segment
+  while (x < mPoints[mSegment].x) {
+    mSegment--;
+  }
+  while (x > mPoints[mSegment + 1].x) {
+    mSegment++;
+  }
+
+  const Point& a = mPoints[mSegment];
+  const Point& b = mPoints[mSegment + 1];
+  t = (x - a.x) / (b.x - a.x);
+  *P = a.P + (b.P - a.P) * t;
+  *I = a.I + (b.I - a.I) * t;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
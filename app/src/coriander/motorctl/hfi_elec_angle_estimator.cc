@@ -0,0 +1,171 @@
+/**
+ * @file hfi_elec_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-02
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/hfi_elec_angle_estimator.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+HfiElecAngleEstimator::HfiElecAngleEstimator(
+    std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+    std::shared_ptr<SensorlessElecAngleEstimator> sensorless,
+    std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+    std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept
+    : mPhaseCurrentEstimator(phaseCurrentEstimator),
+      mSensorless(sensorless),
+      mParam(param),
+      mSystick(systick),
+      mHfi(),
+      mVoltageScale(0.0f),
+      mBlendSpeed(0.0f),
+      mWeight(0.0f),
+      mTimestamp(0),
+      mSeeded(false),
+      mEnabled(false) {
+  paramReqValidator->addParamReq(this);
+}
+
+void HfiElecAngleEstimator::enable() {
+  int32_t polePair =
+      mParam->getValue<int32_t>(ParamId::MotorCtl_MotorDriver_PolePair);
+
+  // SpaceVectorPwm units, the full bus is 2
+  mVoltageScale =
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_SupplyVoltage) *
+      0.5f;
+  mHfi.setup(
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_Ld),
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_Lq),
+      mParam->getValue<float>(ParamId::MotorCtl_Hfi_Voltage),
+      mParam->getValue<float>(ParamId::MotorCtl_Hfi_PllBandwidth),
+      mParam->getValue<float>(ParamId::MotorCtl_Hfi_PulseVoltage),
+      mParam->getValue<int32_t>(ParamId::MotorCtl_Hfi_PulseDuration) * 1e-6f);
+  // RPM to electrical degree per second
+  mBlendSpeed = mParam->getValue<float>(ParamId::MotorCtl_Hfi_BlendSpeed) *
+                6.0f * polePair;
+
+  if (!mPhaseCurrentEstimator->enabled()) {
+    mPhaseCurrentEstimator->enable();
+  }
+  if (!mSensorless->enabled()) {
+    mSensorless->enable();
+  }
+  mSensorless->reset();  // reset sync count
+  mWeight = 0.0f;
+  mSeeded = false;
+  mTimestamp = mSystick->systick_us();
+  mEnabled = true;
+}
+
+void HfiElecAngleEstimator::disable() {
+  if (mPhaseCurrentEstimator->enabled()) {
+    mPhaseCurrentEstimator->disable();
+  }
+  if (mSensorless->enabled()) {
+    mSensorless->disable();
+  }
+  mEnabled = false;
+}
+
+void HfiElecAngleEstimator::sync() {
+  float velocity, weight;
+
+  if (mPhaseCurrentEstimator->needSync(mSyncId)) {
+    mPhaseCurrentEstimator->sync();
+  }
+  if (mSensorless->needSync(mSyncId)) {
+    mSensorless->sync();
+  }
+
+  if (!mHfi.ready()) {
+    return;
+  }
+  // the flux observer can not find the angle at standstill, start it here
+  if (!mSeeded) {
+    mSensorless->setElectricalAngle(mHfi.getAngle());
+    mSeeded = true;
+  }
+
+  velocity = mHfi.tracking() ? mSensorless->getElectricalVelocity()
+                             : mHfi.getVelocity();
+  if (velocity < 0.0f) {
+    velocity = -velocity;
+  }
+
+  // blend over [mBlendSpeed, 2 * mBlendSpeed], 10% hysteresis on injection
+  if (mHfi.tracking() && velocity < mBlendSpeed * 1.8f) {
+    mHfi.resume();
+  } else if (!mHfi.tracking() && velocity >= mBlendSpeed * 2.0f) {
+    mHfi.track(mSensorless->getElectricalAngle(),
+               mSensorless->getElectricalVelocity());
+  }
+  if (mHfi.tracking()) {
+    mHfi.track(mSensorless->getElectricalAngle(),
+               mSensorless->getElectricalVelocity());
+  }
+
+  weight = mBlendSpeed > 0.0f ? velocity / mBlendSpeed - 1.0f : 1.0f;
+  mWeight = weight < 0.0f ? 0.0f : (weight > 1.0f ? 1.0f : weight);
+}
+
+bool HfiElecAngleEstimator::enabled() {
+  return mEnabled && mPhaseCurrentEstimator->enabled();
+}
+
+void HfiElecAngleEstimator::calibrate() {}
+
+bool HfiElecAngleEstimator::needCalibrate() { return false; }
+
+float HfiElecAngleEstimator::getElectricalAngle() noexcept {
+  float angle = mHfi.getAngle();
+
+  if (mWeight > 0.0f) {
+    angle +=
+        mWeight * math::wrapd180(mSensorless->getElectricalAngle() - angle);
+  }
+  return math::wrapd(angle);
+}
+
+void HfiElecAngleEstimator::setVoltage(float alpha, float beta) noexcept {
+  mSensorless->setVoltage(alpha, beta);
+}
+
+float HfiElecAngleEstimator::nextInjection() noexcept {
+  uint32_t current = mSystick->systick_us();
+  float Ialpha, Ibeta;
+
+  if (!mEnabled) {
+    return 0.0f;
+  }
+
+  // the current answers the injection handed out last time
+  if (current != mTimestamp && !mHfi.tracking()) {
+    mPhaseCurrentEstimator->getPhaseCurrent(&Ialpha, &Ibeta);
+    mHfi(Ialpha * IPhaseCurrentEstimator::kAmplitudeScale,
+         Ibeta * IPhaseCurrentEstimator::kAmplitudeScale,
+         (current - mTimestamp) * 1e-6f);
+  }
+  mTimestamp = current;
+
+  return mHfi.getInjection() / mVoltageScale;
+}
+
+float HfiElecAngleEstimator::getInjectionAmplitude() noexcept {
+  if (!mEnabled) {
+    return 0.0f;
+  }
+  return mHfi.getInjectionAmplitude() / mVoltageScale;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,188 @@
+/**
+ * @file hfi_observer.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-02
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/hfi_observer.h"
+
+#include "coriander/base/math.h"
+#include "coriander/motorctl/foc.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+HfiObserver::HfiObserver()
+    : mState(State::Lock),
+      mVoltage(0.0f),
+      mDemodGain(0.0f),
+      mKp(0.0f),
+      mKi(0.0f),
+      mLockTime(0.0f),
+      mPulseVoltage(0.0f),
+      mPulseDuration(0.0f),
+      mTimer(0.0f),
+      mPulseCurrent(0.0f),
+      mPulseStart(0.0f),
+      mSign(1.0f),
+      mHistory(0),
+      mLastAlpha(0.0f),
+      mLastBeta(0.0f),
+      mLastDeltaAlpha(0.0f),
+      mLastDeltaBeta(0.0f),
+      mAngle(0.0f),
+      mVelocity(0.0f) {}
+
+void HfiObserver::setup(float Ld, float Lq, float voltage, float bandwidth,
+                        float pulseVoltage, float pulseDuration) {
+  // q current step per volt-second is (1/Ld - 1/Lq) * sin(2 * error) / 2,
+  // the period is applied per update in demodulate()
+  float saliency = Ld > 0.0f && Lq > Ld ? 1.0f / Ld - 1.0f / Lq : 0.0f;
+
+  mVoltage = voltage;
+  mDemodGain = saliency * voltage > 0.0f ? 1.0f / (saliency * voltage) : 0.0f;
+  mKp = 2.0f * bandwidth;
+  mKi = bandwidth * bandwidth;
+  // the tracking loop settles within about 10 time constants
+  mLockTime = bandwidth > 0.0f ? 10.0f / bandwidth : 0.0f;
+  mPulseVoltage = pulseVoltage;
+  mPulseDuration = pulseDuration;
+  reset();
+}
+
+void HfiObserver::reset(float angle) {
+  mState = State::Lock;
+  mTimer = 0.0f;
+  mHistory = 0;
+  mSign = 1.0f;
+  mAngle = math::wrapd(angle);
+  mVelocity = 0.0f;
+}
+
+void HfiObserver::track(float angle, float velocity) {
+  mState = State::Track;
+  mAngle = math::wrapd(angle);
+  mVelocity = velocity;
+}
+
+void HfiObserver::resume() {
+  mState = State::Run;
+  mHistory = 0;
+}
+
+float HfiObserver::getInjection() const {
+  switch (mState) {
+    case State::Lock:
+    case State::Run:
+      return mSign * mVoltage;
+    case State::PulsePositive:
+    case State::PulseReturn:
+      return mPulseVoltage;
+    case State::PulseBack:
+    case State::PulseNegative:
+      return -mPulseVoltage;
+    case State::Track:
+      break;
+  }
+  return 0.0f;
+}
+
+float HfiObserver::getInjectionAmplitude() const {
+  float voltage = mVoltage > 0.0f ? mVoltage : -mVoltage;
+  float pulseVoltage = mPulseVoltage > 0.0f ? mPulseVoltage : -mPulseVoltage;
+
+  if (mState == State::Track) {
+    return 0.0f;
+  }
+  return voltage > pulseVoltage ? voltage : pulseVoltage;
+}
+
+void HfiObserver::operator()(float ialpha, float ibeta, float Ts) {
+  float sinTheta, cosTheta, id, iq;
+
+  mTimer += Ts;
+  switch (mState) {
+    case State::Lock:
+      demodulate(ialpha, ibeta, Ts);
+      if (mTimer >= mLockTime) {
+        mState = State::PulsePositive;
+        mTimer = 0.0f;
+      }
+      break;
+    case State::PulsePositive:
+      if (mTimer >= mPulseDuration) {
+        math::sincosd(mAngle, &sinTheta, &cosTheta);
+        foc::park(ialpha, ibeta, sinTheta, cosTheta, &id, &iq);
+        mPulseCurrent = id;
+        mState = State::PulseBack;
+        mTimer = 0.0f;
+      }
+      break;
+    case State::PulseBack:
+      if (mTimer >= mPulseDuration) {
+        math::sincosd(mAngle, &sinTheta, &cosTheta);
+        foc::park(ialpha, ibeta, sinTheta, cosTheta, &id, &iq);
+        mPulseStart = id;
+        mState = State::PulseNegative;
+        mTimer = 0.0f;
+      }
+      break;
+    case State::PulseNegative:
+      if (mTimer >= mPulseDuration) {
+        math::sincosd(mAngle, &sinTheta, &cosTheta);
+        foc::park(ialpha, ibeta, sinTheta, cosTheta, &id, &iq);
+        // saturation lowers Ld, the magnet side gives more current
+        if (mPulseCurrent + (id - mPulseStart) < 0.0f) {
+          mAngle = math::wrapd(mAngle + 180.0f);
+        }
+        mState = State::PulseReturn;
+        mTimer = 0.0f;
+      }
+      break;
+    case State::PulseReturn:
+      if (mTimer >= mPulseDuration) {
+        resume();
+      }
+      break;
+    case State::Run:
+      demodulate(ialpha, ibeta, Ts);
+      break;
+    case State::Track:
+      break;
+  }
+}
+
+void HfiObserver::demodulate(float ialpha, float ibeta, float Ts) {
+  float deltaAlpha = ialpha - mLastAlpha;
+  float deltaBeta = ibeta - mLastBeta;
+  float sinTheta, cosTheta, hfAlpha, hfBeta, hfD, hfQ, err;
+
+  mLastAlpha = ialpha;
+  mLastBeta = ibeta;
+  if (mHistory < 2) {
+    mHistory++;
+  } else {
+    // alternating injection, the fundamental step is common to both
+    hfAlpha = (deltaAlpha - mLastDeltaAlpha) * 0.5f * mSign;
+    hfBeta = (deltaBeta - mLastDeltaBeta) * 0.5f * mSign;
+    math::sincosd(mAngle, &sinTheta, &cosTheta);
+    foc::park(hfAlpha, hfBeta, sinTheta, cosTheta, &hfD, &hfQ);
+
+    // sin(2 * error) / 2, about the error in radian
+    err = hfQ * mDemodGain / Ts * (180.0f / static_cast<float>(M_PI));
+    mAngle += mVelocity * Ts;
+    mAngle = math::wrapd(mAngle + mKp * Ts * err);
+    mVelocity += mKi * Ts * err;
+  }
+  mLastDeltaAlpha = deltaAlpha;
+  mLastDeltaBeta = deltaBeta;
+  mSign = -mSign;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -0,0 +1,173 @@
+/**
+ * @file kalman_velocity_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-29
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/kalman_velocity_estimator.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+static constexpr float kRadPerDeg = static_cast<float>(M_PI) / 180.0f;
+static constexpr float kRpmPerRadPerSec = 30.0f / static_cast<float>(M_PI);
+
+KalmanVelocityEstimator::KalmanVelocityEstimator(
+    std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+    std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+    std::shared_ptr<IParamReqValidator> paramReqValidator)
+    : mMechAngleEstimator(mechAngleEstimator),
+      mParam(param),
+      mSystick(systick),
+      mTorqueGain(0.0f),
+      mLoadGain(0.0f),
+      mAccelerationNoise(0.0f),
+      mLoadNoise(0.0f),
+      mPositionNoise(0.0f),
+      mIq(0.0f),
+      mState(State::zeros()),
+      mCovariance(Covariance::zeros()),
+      mTimestamp(0),
+      mEnabled(false) {
+  paramReqValidator->addParamReq(this);
+}
+
+void KalmanVelocityEstimator::enable() {
+  float inertia =
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_Inertia);
+  float torqueConstant =
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_TorqueConstant);
+  float positionNoise = mParam->getValue<float>(
+      ParamId::MotorCtl_SpeedEstimator_KalmanPositionNoise);
+  float accelerationNoise = mParam->getValue<float>(
+      ParamId::MotorCtl_SpeedEstimator_KalmanAccelerationNoise);
+  float loadNoise = mParam->getValue<float>(
+      ParamId::MotorCtl_SpeedEstimator_KalmanLoadNoise);
+
+  mLoadGain = 1.0f / inertia;
+  mTorqueGain = torqueConstant * mLoadGain;
+  mPositionNoise = positionNoise * kRadPerDeg * positionNoise * kRadPerDeg;
+  mAccelerationNoise = accelerationNoise * accelerationNoise;
+  mLoadNoise = loadNoise * loadNoise;
+
+  if (!mMechAngleEstimator->enabled()) {
+    mMechAngleEstimator->enable();
+  }
+  mMechAngleEstimator->reset();  // reset sync count
+  mEnabled = true;
+
+  // force sync to start from the current angle at rest, velocity and load
+  // are unknown: 100rad/s and the torque of 1000rad/s^2
+  mMechAngleEstimator->sync();
+  mState = State::zeros();
+  mState(0, 0) = mMechAngleEstimator->getMechanicalAngle() * kRadPerDeg;
+  mCovariance = Covariance::zeros();
+  mCovariance(0, 0) = mPositionNoise;
+  mCovariance(1, 1) = 100.0f * 100.0f;
+  mCovariance(2, 2) = 1000.0f * inertia * 1000.0f * inertia;
+  mIq = 0.0f;
+  mTimestamp = mSystick->systick_us();
+}
+
+void KalmanVelocityEstimator::disable() {
+  if (mMechAngleEstimator->enabled()) {
+    mMechAngleEstimator->disable();
+  }
+  mEnabled = false;
+  mState = State::zeros();
+}
+
+bool KalmanVelocityEstimator::enabled() {
+  return mEnabled && mMechAngleEstimator->enabled();
+}
+
+void KalmanVelocityEstimator::sync() {
+  uint32_t current = mSystick->systick_us();
+  float dt;
+
+  // no time elapsed, nothing to predict
+  if (current == mTimestamp) {
+    return;
+  }
+  dt = (current - mTimestamp) * 1e-6f;
+  mTimestamp = current;
+
+  if (mMechAngleEstimator->needSync(mSyncId)) {
+    mMechAngleEstimator->sync();
+  }
+
+  // Iq commanded over the last period drove the rotor here
+  predict(dt, mIq);
+  correct(mMechAngleEstimator->getMechanicalAngle() * kRadPerDeg);
+}
+
+void KalmanVelocityEstimator::predict(float dt, float iq) {
+  float dt2 = dt * dt * 0.5f;
+  float dt3 = dt * dt * dt / 3.0f;
+  Covariance F = Covariance::identity();
+  Covariance Q = Covariance::zeros();
+  State B = State::zeros();
+
+  F(0, 1) = dt;
+  F(0, 2) = -mLoadGain * dt2;
+  F(1, 2) = -mLoadGain * dt;
+  B(0, 0) = mTorqueGain * dt2;
+  B(1, 0) = mTorqueGain * dt;
+
+  // white acceleration noise on (angle, velocity), random walk load
+  Q(0, 0) = mAccelerationNoise * dt3;
+  Q(0, 1) = mAccelerationNoise * dt2;
+  Q(1, 0) = mAccelerationNoise * dt2;
+  Q(1, 1) = mAccelerationNoise * dt;
+  Q(2, 2) = mLoadNoise * dt;
+
+  mState = F * mState + B * iq;
+  mCovariance = F * mCovariance * F.transpose() + Q;
+}
+
+void KalmanVelocityEstimator::correct(float angle) {
+  // H = (1, 0, 0), the gain is the first column of P over the innovation
+  // variance
+  float innovation = angle - mState(0, 0);
+  float s = 1.0f / (mCovariance(0, 0) + mPositionNoise);
+  State K;
+  for (int i = 0; i < 3; i++) {
+    K(i, 0) = mCovariance(i, 0) * s;
+  }
+
+  mState = mState + K * innovation;
+
+  // P -= K * H * P, only row 0 of P is involved, kept symmetric
+  Covariance P = mCovariance;
+  for (int i = 0; i < 3; i++) {
+    for (int j = i; j < 3; j++) {
+      float v = P(i, j) - K(i, 0) * P(0, j);
+      mCovariance(i, j) = v;
+      mCovariance(j, i) = v;
+    }
+  }
+}
+
+void KalmanVelocityEstimator::calibrate() {}
+
+bool KalmanVelocityEstimator::needCalibrate() { return false; }
+
+float KalmanVelocityEstimator::getVelocity() {
+  return mState(1, 0) * kRpmPerRadPerSec;
+}
+
+float KalmanVelocityEstimator::getPosition() const {
+  return mState(0, 0) / kRadPerDeg;
+}
+
+float KalmanVelocityEstimator::getAcceleration() const {
+  return (mTorqueGain * mIq - mLoadGain * mState(2, 0)) * kRpmPerRadPerSec;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
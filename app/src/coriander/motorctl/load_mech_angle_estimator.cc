@@ -0,0 +1,78 @@
+/**
+ * @file load_mech_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/load_mech_angle_estimator.h"
+
+namespace coriander {
+namespace motorctl {
+LoadMechAngleEstimator::LoadMechAngleEstimator(
+    std::shared_ptr<ILoadEncoder> encoder, std::shared_ptr<Parameter> param,
+    std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept
+    : mEncoder(encoder),
+      mParam(param),
+      mRawMechAngle(0.0f),
+      mMechAngleOffset(0.0f),
+      mDirection(1.0f),
+      mNeedCalibrate(true) {
+  paramReqValidator->addParamReq(this);
+}
+
+void LoadMechAngleEstimator::enable() {
+  if (mParam->has(ParamId::MotorCtl_Calibrate_CaliLoadAngleOffset)) {
+    mMechAngleOffset = mParam->getValue<float>(
+        ParamId::MotorCtl_Calibrate_CaliLoadAngleOffset);
+    mNeedCalibrate = false;
+  }
+  mDirection = 1.0f;
+  if (mParam->has(ParamId::Sensor_LoadEncoder_Reverse) &&
+      mParam->getValue<int32_t>(ParamId::Sensor_LoadEncoder_Reverse)) {
+    mDirection = -1.0f;
+  }
+
+  if (!mEncoder->enabled()) {
+    mEncoder->enable();
+  }
+
+  mEncoder->reset();  // reset sync count
+}
+
+void LoadMechAngleEstimator::disable() {
+  if (mEncoder->enabled()) {
+    mEncoder->disable();
+  }
+}
+
+bool LoadMechAngleEstimator::enabled() { return mEncoder->enabled(); }
+
+void LoadMechAngleEstimator::sync() {
+  if (mEncoder->needSync(mSyncId)) {
+    mEncoder->sync();
+  }
+}
+
+void LoadMechAngleEstimator::calibrate() {
+  getMechanicalAngle();
+  mMechAngleOffset = -mRawMechAngle;
+  mNeedCalibrate = false;
+  if (mParam->has(ParamId::MotorCtl_Calibrate_CaliLoadAngleOffset)) {
+    mParam->setValue(ParamId::MotorCtl_Calibrate_CaliLoadAngleOffset,
+                     mMechAngleOffset);
+  }
+}
+
+bool LoadMechAngleEstimator::needCalibrate() { return mNeedCalibrate; }
+
+float LoadMechAngleEstimator::getMechanicalAngle() noexcept {
+  float t = (static_cast<float>(mEncoder->getEncoderCount()) /
+             mEncoder->getEncoderCountPerRound());
+  mRawMechAngle = (t + mEncoder->getOverflowCount()) * 360.0f * mDirection;
+  return mRawMechAngle + mMechAngleOffset;
+}
+}  // namespace motorctl
+}  // namespace coriander
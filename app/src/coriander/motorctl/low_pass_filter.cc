@@ -12,20 +12,33 @@
 namespace coriander {
 namespace motorctl {
 
-LowPassFilter::LowPassFilter(float time_constant)
-    : Tf(time_constant), y_prev(0.0f) {}
+template <typename N>
+detail::LowPassFilter<N>::LowPassFilter(Gain time_constant)
+    : Tf(time_constant), y_prev() {}
 
-float LowPassFilter::operator()(float x, float ts) {
-  float dt = ts;
-  float alpha = Tf / (Tf + dt);
-  float y = alpha * y_prev + (1.0f - alpha) * x;
+template <typename N>
+typename detail::LowPassFilter<N>::Value detail::LowPassFilter<N>::operator()(
+    Value x, Gain ts) {
+  Gain dt = ts;
+  Gain alpha = Tf / (Tf + dt);
+  Value y = y_prev * alpha + x * (Gain(1.0f) - alpha);
   y_prev = y;
   return y;
 }
 
-void LowPassFilter::clear() {
-  y_prev = 0.0f;
+template <typename N>
+void detail::LowPassFilter<N>::clear() {
+  y_prev = Value();
 }
 
+template <typename N>
+void detail::LowPassFilter<N>::reset(Value y) {
+  y_prev = y;
+}
+
+template struct detail::LowPassFilter<base::FloatNumeric>;
+template struct detail::LowPassFilter<base::Q15Numeric>;
+template struct detail::LowPassFilter<base::Q31Numeric>;
+
 }  // namespace motorctl
 }  // namespace coriander
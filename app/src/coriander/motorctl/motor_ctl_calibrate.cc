@@ -16,18 +16,24 @@ namespace motorctl {
 MotorCtlCalibrate::MotorCtlCalibrate(
     std::shared_ptr<IBldcDriver> motor,
     std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+    std::shared_ptr<IBusVoltageEstimator> busVoltageEstimator,
     std::shared_ptr<IElecAngleEstimator> elecAngleEstimator,
     std::shared_ptr<Parameter> param, std::shared_ptr<IBoardEvent> boardEvent,
     std::shared_ptr<ISystick> systick, std::shared_ptr<ILogger> logger,
     std::shared_ptr<IParamReqValidator> paramReqValidator)
     : mMotor(motor),
       mPhaseCurrentEstimator(phaseCurrentEstimator),
+      mBusVoltageEstimator(busVoltageEstimator),
       mElecAngleEstimator(elecAngleEstimator),
       mParam(param),
       mBoardEvent(boardEvent),
       mSystick(systick),
       mLogger(logger),
-      mSensorHandler{phaseCurrentEstimator, mElecAngleEstimator} {
+      mSensorHandler{phaseCurrentEstimator, busVoltageEstimator,
+                     mElecAngleEstimator},
+      mBusVoltageLpf(0.0f),
+      mBusTimestamp(0),
+      mDutyCycle(0) {
   paramReqValidator->addParamReq(this);
 }
 
@@ -56,6 +62,7 @@ void MotorCtlCalibrate::loop() {
       mPhaseCurrentEstimator->calibrate();
       break;
     case State::Calibrate_ElecAngle:
+      updateBusVoltage(current);
       mElecAngleEstimator->calibrate();
       break;
   }
@@ -84,22 +91,28 @@ void MotorCtlCalibrate::enterState(State state) {
       mLogger->log("Phase current calibration start");
       break;
     case State::Calibrate_ElecAngle: {
-      uint16_t dc;
       mCalibrateVoltage =
           mParam->getValue<float>(ParamId::MotorCtl_Calibrate_CaliVoltage);
       mMotorSupplyVoltage =
           mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_SupplyVoltage);
       mCalibrateDuration =
           mParam->getValue<int32_t>(ParamId::MotorCtl_Calibrate_CaliDuration);
-      dc = static_cast<uint16_t>(UINT16_MAX * mCalibrateVoltage /
-                                 mMotorSupplyVoltage);
+      // start at the supply voltage as the current loop does
+      mBusVoltageLpf.Tf = 0.0f;
+      if (mParam->has(ParamId::MotorCtl_MotorDriver_BusLpf_TimeConstant)) {
+        mBusVoltageLpf.Tf = mParam->getValue<float>(
+            ParamId::MotorCtl_MotorDriver_BusLpf_TimeConstant);
+      }
+      mBusVoltageLpf.reset(mMotorSupplyVoltage);
+      mDutyCycle = calibrateDutyCycle(mMotorSupplyVoltage);
       mMotor->enable();
-      mMotor->setPhaseDutyCycle(dc, 0, 0);
+      mMotor->setPhaseDutyCycle(mDutyCycle, 0, 0);
       mLogger->log("Electrical angle calibration start");
     } break;
   }
   // start timer
   startTimestamp = mSystick->systick_ms();
+  mBusTimestamp = startTimestamp;
   mState = state;
 }
 
@@ -120,6 +133,40 @@ void MotorCtlCalibrate::exitState() {
   mState = State::Calibrate_Idle;
 }
 
+void MotorCtlCalibrate::updateBusVoltage(uint32_t timestamp) {
+  float busVoltage;
+  uint16_t dc;
+
+  // boards without the channels stay at the supply voltage, the main loop
+  // is faster than the ms timestamp, filter once per tick
+  if (!mBusVoltageEstimator->enabled() || timestamp == mBusTimestamp) {
+    return;
+  }
+  busVoltage = mBusVoltageEstimator->getBusVoltage();
+  if (busVoltage <= 0.0f) {
+    return;
+  }
+  busVoltage =
+      mBusVoltageLpf(busVoltage, (timestamp - mBusTimestamp) * 1.0e-3f);
+  mBusTimestamp = timestamp;
+
+  dc = calibrateDutyCycle(busVoltage);
+  if (dc != mDutyCycle) {
+    mDutyCycle = dc;
+    mMotor->setPhaseDutyCycle(mDutyCycle, 0, 0);
+  }
+}
+
+uint16_t MotorCtlCalibrate::calibrateDutyCycle(float busVoltage) const {
+  // same cap as FocMotorDriverBase::setBusVoltage, at most twice the duty
+  const float maxScale = 2.0f;
+  float minVoltage = mMotorSupplyVoltage / maxScale;
+  float duty = mCalibrateVoltage /
+               (busVoltage > minVoltage ? busVoltage : minVoltage);
+
+  return static_cast<uint16_t>(UINT16_MAX * (duty < 1.0f ? duty : 1.0f));
+}
+
 void MotorCtlCalibrate::seekCalibrateItem() {
   if (mPhaseCurrentEstimator->needCalibrate()) {
     enterState(State::Calibrate_PhaseCurrent);
@@ -9,14 +9,10 @@
  */
 #include "coriander/motorctl/motor_ctl_current.h"
 
-#include <math.h>
-
 #include "coriander/base/jscope.h"
+#include "coriander/base/math.h"
 #include "coriander/motorctl/foc.h"
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846f
-#endif
+#include "coriander/motorctl/param_tables.h"
 
 #if CONFIG_JSCOPE_ENABLE
 ATTR_JSCOPE static float _dCurrCtlElecAngle = 0.0f;
@@ -33,25 +29,49 @@ ATTR_JSCOPE static float _dCurrCtlOutputUq = 0.0f;
 namespace coriander {
 namespace motorctl {
 
+static const GainScheduleParams kGainSchedule[] = {
+    {ParamId::MotorCtl_CurrCtl_Sched0_Current,
+     ParamId::MotorCtl_CurrCtl_Sched0_PScale,
+     ParamId::MotorCtl_CurrCtl_Sched0_IScale},
+    {ParamId::MotorCtl_CurrCtl_Sched1_Current,
+     ParamId::MotorCtl_CurrCtl_Sched1_PScale,
+     ParamId::MotorCtl_CurrCtl_Sched1_IScale},
+    {ParamId::MotorCtl_CurrCtl_Sched2_Current,
+     ParamId::MotorCtl_CurrCtl_Sched2_PScale,
+     ParamId::MotorCtl_CurrCtl_Sched2_IScale},
+    {ParamId::MotorCtl_CurrCtl_Sched3_Current,
+     ParamId::MotorCtl_CurrCtl_Sched3_PScale,
+     ParamId::MotorCtl_CurrCtl_Sched3_IScale},
+};
+
+// dq current feedback filter, after the low pass
+static const BiquadStageParams kFbFilter[] = {
+    {ParamId::MotorCtl_CurrCtl_FbFilter0_Type,
+     ParamId::MotorCtl_CurrCtl_FbFilter0_Frequency,
+     ParamId::MotorCtl_CurrCtl_FbFilter0_Q,
+     ParamId::MotorCtl_CurrCtl_FbFilter0_Gain},
+};
+
 void MotorCtlCurrent::start() {
-  mPidD.P = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidP);
-  mPidD.I = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidI);
-  mPidD.D = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidD);
-  mPidD.output_ramp =
-      mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidOutputRamp);
-  mPidD.limit = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidLimit);
-  mPidD.reset();
-
-  mPidQ.P = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidP);
-  mPidQ.I = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidI);
-  mPidQ.D = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidD);
-  mPidQ.output_ramp =
-      mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidOutputRamp);
-  mPidQ.limit = mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidLimit);
-  mPidQ.reset();
-
-  mDurationTimeout->setDuration(static_cast<uint32_t>(
-      1e6 / mParams->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_Freq)));
+  float gainP, gainI;
+
+  for (auto pid : {&mPidD, &mPidQ}) {
+    pid->setGains(mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidP),
+                  mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidI),
+                  mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidD));
+    pid->setRamp(
+        mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidOutputRamp));
+    pid->setLimit(mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PidLimit));
+    pid->reset();
+  }
+
+  setupGainSchedule(mParams.get(), kGainSchedule, &mGainSchedule);
+  mGainSchedule(0.0f, &gainP, &gainI);
+  mPidD.setGainScale(gainP, gainI);
+  mPidQ.setGainScale(gainP, gainI);
+
+  float freq = mParams->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_Freq);
+  mDurationTimeout->setDuration(static_cast<uint32_t>(1e6 / freq));
 
   mTargetId =
       mParams->getValue<float>(ParamId::MotorCtl_General_TargetCurrentD_RT);
@@ -66,6 +86,98 @@ void MotorCtlCurrent::start() {
       mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_Lpf_TimeConstant);
   mIqLpf.clear();
 
+  // feedback filter, coefficients for the loop frequency
+  for (auto filter : {&mIdFilter, &mIqFilter}) {
+    setupBiquadChain(mParams.get(), kFbFilter, freq, filter);
+  }
+
+  // measured bus, duty cycles stay in units of the supply voltage and the
+  // driver rescales them, temperature is filtered alongside
+  mSupplyVoltage = 0.0f;
+  if (mParams->has(ParamId::MotorCtl_MotorDriver_SupplyVoltage)) {
+    mSupplyVoltage =
+        mParams->getValue<float>(ParamId::MotorCtl_MotorDriver_SupplyVoltage);
+  }
+  mFocMotorDriver->setSupplyVoltage(mSupplyVoltage);
+  mBusVoltageLpf.Tf = 0.0f;
+  if (mParams->has(ParamId::MotorCtl_MotorDriver_BusLpf_TimeConstant)) {
+    mBusVoltageLpf.Tf = mParams->getValue<float>(
+        ParamId::MotorCtl_MotorDriver_BusLpf_TimeConstant);
+  }
+  mTemperatureLpf.Tf = mBusVoltageLpf.Tf;
+  mBusSampled = false;
+  mPublishPeriods =
+      mParams->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_Freq) / 10;
+  mPublishCounter = 0;
+
+  // deadbeat needs the motor model and the supply to turn volts into duty
+  mStrategy = Strategy::Pi;
+  if (mParams->has(ParamId::MotorCtl_CurrCtl_Strategy)) {
+    mStrategy = static_cast<Strategy>(
+        mParams->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_Strategy));
+  }
+  if (mStrategy == Strategy::Deadbeat) {
+    // a missing parameter reads 0, no inductance falls back to pi
+    auto value = [this](ParamId id) {
+      return mParams->has(id) ? mParams->getValue<float>(id) : 0.0f;
+    };
+    // the loop current is 3/2 of the phase amplitude, the model takes it
+    // with the resistance and inductances scaled by 2/3
+    constexpr float k = IPhaseCurrentEstimator::kAmplitudeScale;
+    mDeadbeat.setup(value(ParamId::MotorCtl_MotorDriver_Rs) * k,
+                    value(ParamId::MotorCtl_MotorDriver_Ld) * k,
+                    value(ParamId::MotorCtl_MotorDriver_Lq) * k,
+                    value(ParamId::MotorCtl_MotorDriver_FluxLinkage),
+                    value(ParamId::MotorCtl_CurrCtl_DeadbeatSpeedBandwidth));
+    if (!mDeadbeat.enabled() || mSupplyVoltage <= 0.0f) {
+      mStrategy = Strategy::Pi;
+    }
+  }
+
+  // an unknown mode would fall through to the hexagon clip, refuse to run
+  // with it, linear until the fatal error stops the motor
+  auto modulation = foc::Modulation::Linear;
+  mInvalidConfig = false;
+  if (mParams->has(ParamId::MotorCtl_CurrCtl_Modulation)) {
+    int32_t value =
+        mParams->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_Modulation);
+    if (value < static_cast<int32_t>(foc::Modulation::Linear) ||
+        value > static_cast<int32_t>(foc::Modulation::OverModulationII)) {
+      mInvalidConfig = true;
+    } else {
+      modulation = static_cast<foc::Modulation>(value);
+    }
+  }
+  mFocMotorDriver->setModulation(modulation);
+  mVoltageLimit = foc::maxVoltage(modulation);
+  mModulationIndex = 0.0f;
+
+  // same for the pwm mode, continuous until the fatal error stops the motor
+  auto pwmMode = foc::PwmMode::Continuous;
+  float pwmThreshold = 0.0f;
+  if (mParams->has(ParamId::MotorCtl_CurrCtl_PwmMode)) {
+    int32_t value =
+        mParams->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_PwmMode);
+    if (value < static_cast<int32_t>(foc::PwmMode::Continuous) ||
+        value > static_cast<int32_t>(foc::PwmMode::Dpwm30)) {
+      mInvalidConfig = true;
+    } else {
+      pwmMode = static_cast<foc::PwmMode>(value);
+      pwmThreshold =
+          mParams->getValue<float>(ParamId::MotorCtl_CurrCtl_PwmModeThreshold);
+    }
+  }
+  mFocMotorDriver->setPwmMode(pwmMode, pwmThreshold);
+
+  if (mParams->has(ParamId::MotorCtl_MotorDriver_DeadTime)) {
+    mFocMotorDriver->setDeadTime(
+        mParams->getValue<float>(ParamId::MotorCtl_MotorDriver_DeadTime),
+        mParams->getValue<float>(
+            ParamId::MotorCtl_MotorDriver_DeadTimeCurrentBand));
+  }
+
+  mFocMotorDriver->resetPhaseCurrent();
+
   // enable sensors, motor
   mSensorHandler.enable();
   mDurationEstimator->recordStart();
@@ -75,6 +187,8 @@ void MotorCtlCurrent::start() {
 
 void MotorCtlCurrent::stop() {
   mSensorHandler.disable();
+  mFocMotorDriver->setBusVoltage(0.0f);
+  mFocMotorDriver->resetPhaseCurrent();
   mFocMotorDriver->disable();
 }
 
@@ -84,8 +198,10 @@ void MotorCtlCurrent::loop() {
   float errorId, errorIq;
   float currId, currIq;
   float Ialpha, Ibeta;
-  float thetaRad, sinTheta, cosTheta;
+  float angle, sinTheta, cosTheta;
   float outputUd, outputUq;
+  float Ualpha, Ubeta;
+  float limit;
 
   mSensorHandler.sync();
 
@@ -101,30 +217,63 @@ void MotorCtlCurrent::loop() {
       durationUs = maxDurationUs;
     }
 
+    updateBusVoltage(durationUs * 1.0e-6f);
+
     // get phase current
     mPhaseCurrentEstimator->getPhaseCurrent(&Ialpha, &Ibeta);
-    thetaRad = mElecAngleEstimator->getElectricalAngle() / 180.0f * M_PI;
-    sinTheta = sinf(thetaRad);
-    cosTheta = cosf(thetaRad);
+    mFocMotorDriver->setPhaseCurrent(Ialpha, Ibeta);
+    angle = mElecAngleEstimator->getElectricalAngle();
+    base::math::sincosd(angle, &sinTheta, &cosTheta);
     foc::park(Ialpha, Ibeta, sinTheta, cosTheta, &currId, &currIq);
+    limit = voltageLimit();
+
+    if (mStrategy == Strategy::Deadbeat) {
+      // unfiltered, a filter lag is not in the motor model
+      errorId = mTargetId - currId;
+      errorIq = mTargetIq - currIq;
+      deadbeat(currId, currIq, angle, durationUs * 1.0e-6f, limit, &outputUd,
+               &outputUq);
+    } else {
+      currId = mIdFilter(mIdLpf(currId, durationUs * 1.0e-6f));
+      currIq = mIqFilter(mIqLpf(currIq, durationUs * 1.0e-6f));
+
+      // scheduled over the current magnitude
+      if (mGainSchedule.size() > 1) {
+        float gainP, gainI;
+        mGainSchedule(base::math::sqrtf(currId * currId + currIq * currIq),
+                      &gainP, &gainI);
+        mPidD.setGainScale(gainP, gainI);
+        mPidQ.setGainScale(gainP, gainI);
+      }
 
-    currId = mIdLpf(currId, durationUs * 1.0e-6f);
-    currIq = mIqLpf(currIq, durationUs * 1.0e-6f);
+      // calculate error
+      errorId = mTargetId - currId;
+      errorIq = mTargetIq - currIq;
 
-    // calculate error
-    errorId = mTargetId - currId;
-    errorIq = mTargetIq - currIq;
+      // calculate output
+      outputUd = mPidD(errorId, durationUs * 1.0e-6f);
+      outputUq = mPidQ(errorIq, durationUs * 1.0e-6f);
 
-    // calculate output
-    outputUd = mPidD(errorId, durationUs * 1.0e-6f);
-    outputUq = mPidQ(errorIq, durationUs * 1.0e-6f);
+      // limit voltage vector, feed back to pid when saturated
+      if (foc::limitVoltage(&outputUd, &outputUq, limit)) {
+        mPidD.backCalculate(outputUd);
+        mPidQ.backCalculate(outputUq);
+      }
+    }
+    mModulationIndex =
+        limit > 0.0f
+            ? base::math::sqrtf(outputUd * outputUd + outputUq * outputUq) /
+                  limit
+            : 1.0f;
 
-    // set output
-    mFocMotorDriver->setVoltage(outputUd, outputUq);
+    // set output, observers see the applied voltage on the next sync
+    mFocMotorDriver->setVoltage(outputUd, outputUq, sinTheta, cosTheta);
+    mFocMotorDriver->getVoltage(&Ualpha, &Ubeta);
+    mElecAngleEstimator->setVoltage(Ualpha, Ubeta);
 
     mDurationEstimator->recordStart();
 #if CONFIG_JSCOPE_ENABLE
-    _dCurrCtlElecAngle = mElecAngleEstimator->getElectricalAngle();
+    _dCurrCtlElecAngle = angle;
     _dCurrCtlTargetId = mTargetId * 1000.0f;
     _dCurrCtlTargetIq = mTargetIq * 1000.0f;
     _dCurrCtlCurrId = currId * 1000.0f;
@@ -137,9 +286,71 @@ void MotorCtlCurrent::loop() {
   }
 }
 
+void MotorCtlCurrent::deadbeat(float currId, float currIq, float angle,
+                               float Ts, float limit, float* outputUd,
+                               float* outputUq) {
+  // duty cycles in units of half the supply voltage
+  float voltsToDuty = 2.0f / mSupplyVoltage;
+  float ud, uq;
+
+  mDeadbeat(mTargetId, mTargetIq, currId, currIq, angle, Ts, &ud, &uq);
+  ud *= voltsToDuty;
+  uq *= voltsToDuty;
+
+  // the next prediction runs on what is applied, not what was asked for
+  if (foc::limitVoltage(&ud, &uq, limit)) {
+    mDeadbeat.backCalculate(ud / voltsToDuty, uq / voltsToDuty);
+  }
+  mDeadbeat.advance(&ud, &uq);
+  *outputUd = ud;
+  *outputUq = uq;
+}
+
+float MotorCtlCurrent::voltageLimit() {
+  // the driver rescales to the measured bus after the limiter, a sagging
+  // bus leaves less of the supply voltage
+  float limit = mVoltageLimit / mFocMotorDriver->getBusScale() -
+                mElecAngleEstimator->getInjectionAmplitude();
+
+  return limit > 0.0f ? limit : 0.0f;
+}
+
+void MotorCtlCurrent::updateBusVoltage(float Ts) {
+  float busVoltage, temperature;
+
+  if (!mBusVoltageEstimator->enabled()) {
+    return;
+  }
+
+  // the data register reads zero before the first conversion, a negative
+  // bus after the offset, the duty cycles stay as they are until then
+  busVoltage = mBusVoltageEstimator->getBusVoltage();
+  if (busVoltage <= 0.0f) {
+    return;
+  }
+  temperature = mBusVoltageEstimator->getTemperature();
+  if (!mBusSampled) {
+    // start at the supply voltage, a ramp from zero would double the duty,
+    // at the first sample when the supply is unknown
+    mBusVoltageLpf.reset(mSupplyVoltage > 0.0f ? mSupplyVoltage : busVoltage);
+    mTemperatureLpf.reset(temperature);
+    mBusSampled = true;
+  }
+  busVoltage = mBusVoltageLpf(busVoltage, Ts);
+  temperature = mTemperatureLpf(temperature, Ts);
+  mFocMotorDriver->setBusVoltage(busVoltage);
+
+  // parameters are too heavy for every period, ~10Hz is enough to report
+  if (++mPublishCounter >= mPublishPeriods) {
+    mPublishCounter = 0;
+    mParams->setValue(ParamId::Sensor_Motor_Voltage_RT, busVoltage);
+    mParams->setValue(ParamId::Sensor_Motor_Temp_RT, temperature);
+  }
+}
+
 void MotorCtlCurrent::emergencyStop() { this->stop(); }
 
-bool MotorCtlCurrent::fatalError() { return false; }
+bool MotorCtlCurrent::fatalError() { return mInvalidConfig; }
 
 void MotorCtlCurrent::setTargetCurrent(float id, float iq) {
   mTargetId = id;
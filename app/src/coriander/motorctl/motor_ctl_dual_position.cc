@@ -0,0 +1,224 @@
+/**
+ * @file motor_ctl_dual_position.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/motor_ctl_dual_position.h"
+
+#include "coriander/base/jscope.h"
+
+#if CONFIG_JSCOPE_ENABLE
+ATTR_JSCOPE static float _dDualPosLoad = 0.0f;
+ATTR_JSCOPE static float _dDualPosFeedback = 0.0f;
+ATTR_JSCOPE static float _dDualPosTarget = 0.0f;
+ATTR_JSCOPE static float _dDualPosBacklash = 0.0f;
+#endif
+
+namespace coriander {
+namespace motorctl {
+
+MotorCtlDualPosition::MotorCtlDualPosition(
+    std::shared_ptr<MotorCtlVelocity> motorCtlVelocity,
+    std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+    std::shared_ptr<ILoadMechAngleEstimator> loadAngleEstimator,
+    std::shared_ptr<Diagnosis> diagnosis,
+    std::unique_ptr<Duration> durationEstimator,
+    std::unique_ptr<DurationTimeout> durationTimeout,
+    std::shared_ptr<Parameter> parameters,
+    std::shared_ptr<IParamReqValidator> paramReqValidator)
+    : mMotorCtlVelocity{motorCtlVelocity},
+      mMechAngleEstimator{mechAngleEstimator},
+      mLoadAngleEstimator{loadAngleEstimator},
+      mDiagnosis{diagnosis},
+      mParameters{parameters},
+      mDurationEstimator{std::move(durationEstimator)},
+      mDurationTimeout{std::move(durationTimeout)},
+      mTargetPosition(0.0f),
+      mGearRatio(1.0f),
+      mMaxDeviation(0.0f),
+      mSensorHandler{mMechAngleEstimator, mLoadAngleEstimator},
+      mMechAnglePid(0.0f, 0.0f, 0.0f, 0.0f, 0.0f),
+      mResidualLpf(0.0f),
+      mStatus(Diagnosis::DeviceStatus::Unknown),
+      mUseTrajectory(false),
+      mTrajectoryStarted(false) {
+  paramReqValidator->addParamReq(this);
+
+  // nothing to tell before the mode ran once, boards without a load
+  // encoder stay Unknown, polled by the diagnosis
+  mDiagnosis->setDiagDev(Diagnosis::DiagDevId::MotorOuterPosSensor,
+                         [this]() { return mStatus; });
+}
+
+void MotorCtlDualPosition::start() {
+  mMechAnglePid.setGains(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidP),
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidI),
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidD));
+  mMechAnglePid.setRamp(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidOutputRamp));
+  mMechAnglePid.setLimit(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidLimit));
+  mMechAnglePid.reset();
+
+  mTargetPosition =
+      mParameters->getValue<float>(ParamId::MotorCtl_General_TargetPosition_RT);
+  mDurationTimeout->setDuration(static_cast<int32_t>(
+      1e6 / mParameters->getValue<int32_t>(ParamId::MotorCtl_PosCtl_Freq)));
+
+  mGearRatio =
+      mParameters->getValue<float>(ParamId::MotorCtl_DualPosCtl_GearRatio);
+  mMaxDeviation =
+      mParameters->getValue<float>(ParamId::MotorCtl_DualPosCtl_MaxDeviation);
+  mResidualLpf.Tf = mParameters->getValue<float>(
+      ParamId::MotorCtl_DualPosCtl_Lpf_TimeConstant);
+  mResidualLpf.clear();
+
+  // last estimates as the starting point, the center is where the gear is
+  mBacklashEstimator.setup(
+      mParameters->getValue<float>(ParamId::MotorCtl_DualPosCtl_EngageCurrent),
+      mParameters->getValue<float>(ParamId::MotorCtl_DualPosCtl_Forgetting),
+      mParameters->getValue<float>(ParamId::MotorCtl_DualPosCtl_Backlash),
+      mParameters->getValue<float>(ParamId::MotorCtl_DualPosCtl_Compliance));
+
+  // position in degree, profile limits in RPM
+  mUseTrajectory = false;
+  if (mParameters->has(ParamId::MotorCtl_PosCtl_TrajVelocity)) {
+    float velocity =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajVelocity);
+    float acceleration =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajAcceleration);
+    float jerk =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajJerk);
+    mTrajectory.setLimits(velocity * 6.0f, acceleration * 6.0f, jerk * 6.0f);
+    mUseTrajectory = velocity > 0.0f;
+  }
+  mTrajectoryStarted = false;
+
+  mDurationEstimator->reset();
+  mSensorHandler.enable();
+  mSensorHandler.sync();
+
+  // no load encoder, or no gear to relate it to the motor
+  if (!mLoadAngleEstimator->enabled() || mGearRatio == 0.0f) {
+    mStatus = Diagnosis::DeviceStatus::Lost;
+  } else {
+    mBacklashEstimator.reset(mMechAngleEstimator->getMechanicalAngle() /
+                                 mGearRatio -
+                             mLoadAngleEstimator->getMechanicalAngle());
+    mStatus = Diagnosis::DeviceStatus::Normal;
+  }
+
+  // next level start
+  mMotorCtlVelocity->start();
+}
+
+void MotorCtlDualPosition::stop() {
+  mSensorHandler.disable();
+
+  // keep what was learnt for the next start
+  if (mStatus == Diagnosis::DeviceStatus::Normal) {
+    mParameters->setValue(ParamId::MotorCtl_DualPosCtl_Backlash,
+                          mBacklashEstimator.getBacklash());
+    mParameters->setValue(ParamId::MotorCtl_DualPosCtl_Compliance,
+                          mBacklashEstimator.getCompliance());
+  }
+
+  // next level stop
+  mMotorCtlVelocity->stop();
+}
+
+float MotorCtlDualPosition::feedback(float Ts) {
+  float motorAngle = mMechAngleEstimator->getMechanicalAngle() / mGearRatio;
+  float loadAngle = mLoadAngleEstimator->getMechanicalAngle();
+  float torque = mMotorCtlVelocity->getTorqueCurrent();
+  float twist, predicted, residual;
+
+  twist = motorAngle - loadAngle;
+  mBacklashEstimator(twist, torque);
+  predicted = mBacklashEstimator.predict(torque);
+  residual = mResidualLpf(twist - predicted, Ts);
+
+  if (residual > mMaxDeviation || residual < -mMaxDeviation) {
+    mStatus = Diagnosis::DeviceStatus::Error;
+  }
+
+  // the load angle once the correction settled, motor dynamics before
+  return motorAngle - predicted - residual;
+}
+
+void MotorCtlDualPosition::loop() {
+  const uint32_t maxDurationUs = 20'000;
+  uint32_t durationUs;
+  float mechAngle, mechAngleError;
+  float reference, targetVelocity, targetAcceleration;
+
+  mSensorHandler.sync();
+
+  // limit calculation frequency
+  if (mDurationTimeout->expired()) {
+    mDurationTimeout->reset();
+
+    mDurationEstimator->recordStop();
+
+    // limit durationMs
+    durationUs = mDurationEstimator->getDuration();
+    if (durationUs > maxDurationUs) {
+      durationUs = maxDurationUs;
+    }
+
+    // follow target changes without a restart of the whole cascade
+    mTargetPosition = mParameters->getValue<float>(
+        ParamId::MotorCtl_General_TargetPosition_RT);
+
+    // the loop runs in motor degrees, gains and profile are the motor ones
+    mechAngle = feedback(durationUs * 1.0e-6f) * mGearRatio;
+
+    reference = mTargetPosition * mGearRatio;
+    targetVelocity = 0.0f;
+    targetAcceleration = 0.0f;
+    if (mUseTrajectory) {
+      if (!mTrajectoryStarted) {
+        mTrajectory.reset(mechAngle);
+        mTrajectoryStarted = true;
+      }
+      mTrajectory(reference, durationUs * 1.0e-6f);
+      // degree/s to RPM
+      reference = mTrajectory.getPosition();
+      targetVelocity = mTrajectory.getVelocity() / 6.0f;
+      targetAcceleration = mTrajectory.getAcceleration() / 6.0f;
+    }
+
+    mechAngleError = reference - mechAngle;
+    targetVelocity += mMechAnglePid(mechAngleError, durationUs * 1.0e-6f);
+    mMotorCtlVelocity->setTargetVelocity(targetVelocity, targetAcceleration);
+
+    mDurationEstimator->recordStart();
+
+#if CONFIG_JSCOPE_ENABLE
+    _dDualPosLoad = mLoadAngleEstimator->getMechanicalAngle();
+    _dDualPosFeedback = mechAngle / mGearRatio;
+    _dDualPosTarget = reference / mGearRatio;
+    _dDualPosBacklash = mBacklashEstimator.getBacklash();
+#endif
+  }
+  // next level loop
+  mMotorCtlVelocity->loop();
+}
+
+void MotorCtlDualPosition::emergencyStop() {
+  mMotorCtlVelocity->emergencyStop();
+}
+
+bool MotorCtlDualPosition::fatalError() {
+  return mStatus == Diagnosis::DeviceStatus::Lost ||
+         mStatus == Diagnosis::DeviceStatus::Error ||
+         mMechAngleEstimator->lost() || mMotorCtlVelocity->fatalError();
+}
+
+}  // namespace motorctl
+}  // namespace coriander
@@ -11,6 +11,7 @@
 
 #include <math.h>
 
+#include "coriander/base/math.h"
 #include "coriander/motorctl/foc.h"
 
 #ifndef CONFIG_JSCOPE_ENABLE
@@ -56,11 +57,9 @@ void MotorCtlOpenLoop::loop() {
 #if CONFIG_JSCOPE_ENABLE
     _dOpenLoopElecAngle = mCurrentAngle;
     _dOpenLoopSensorElecAngle = mElecAngleEstimator->getElectricalAngle();
-    float alpha, beta, sineTheta, cosineTheta, theta, d, q;
+    float alpha, beta, sineTheta, cosineTheta, d, q;
     mPhaseCurrentEstimator->getPhaseCurrent(&alpha, &beta);
-    theta = _dOpenLoopSensorElecAngle / 180.0f * 3.1415926f;
-    sineTheta = sinf(theta);
-    cosineTheta = cosf(theta);
+    base::math::sincosd(_dOpenLoopSensorElecAngle, &sineTheta, &cosineTheta);
     foc::park(alpha, beta, sineTheta, cosineTheta, &d, &q);
     _dOpenLoopId = d * 1000;
     _dOpenLoopIq = q * 1000;
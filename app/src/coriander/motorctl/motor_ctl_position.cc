@@ -21,13 +21,14 @@ namespace coriander {
 namespace motorctl {
 
 void MotorCtlPosition::start() {
-  mMechAnglePid.P = mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidP);
-  mMechAnglePid.I = mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidI);
-  mMechAnglePid.D = mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidD);
-  mMechAnglePid.output_ramp =
-      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidOutputRamp);
-  mMechAnglePid.limit =
-      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidLimit);
+  mMechAnglePid.setGains(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidP),
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidI),
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidD));
+  mMechAnglePid.setRamp(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidOutputRamp));
+  mMechAnglePid.setLimit(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_PidLimit));
   mMechAnglePid.reset();
 
   mTargetPosition =
@@ -39,6 +40,20 @@ void MotorCtlPosition::start() {
       mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_Lpf_TimeConstant);
   mMechLpf.clear();
 
+  // position in degree, profile limits in RPM
+  mUseTrajectory = false;
+  if (mParameters->has(ParamId::MotorCtl_PosCtl_TrajVelocity)) {
+    float velocity =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajVelocity);
+    float acceleration =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajAcceleration);
+    float jerk =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajJerk);
+    mTrajectory.setLimits(velocity * 6.0f, acceleration * 6.0f, jerk * 6.0f);
+    mUseTrajectory = velocity > 0.0f;
+  }
+  mTrajectoryStarted = false;
+
   mDurationEstimator->reset();
   mSensorHandler.enable();
 
@@ -57,7 +72,7 @@ void MotorCtlPosition::loop() {
   const uint32_t maxDurationUs = 20'000;
   uint32_t durationUs;
   float mechAngle, mechAngleError;
-  float targetVelocity;
+  float reference, targetVelocity, targetAcceleration;
 
   mSensorHandler.sync();
 
@@ -73,18 +88,40 @@ void MotorCtlPosition::loop() {
       durationUs = maxDurationUs;
     }
 
+    // follow target changes without a restart of the whole cascade
+    mTargetPosition = mParameters->getValue<float>(
+        ParamId::MotorCtl_General_TargetPosition_RT);
+
     mechAngle = mMechLpf(mMechAngleEstimator->getMechanicalAngle(),
                          durationUs * 1.0e-6f);
-    mechAngleError = mTargetPosition - mechAngle;
-    targetVelocity = mMechAnglePid(mechAngleError, durationUs * 1.0e-6f);
-    mMotorCtlVelocity->setTargetVelocity(targetVelocity);
+
+    reference = mTargetPosition;
+    targetVelocity = 0.0f;
+    targetAcceleration = 0.0f;
+    if (mUseTrajectory) {
+      if (!mTrajectoryStarted) {
+        mTrajectory.reset(mMechAngleEstimator->getMechanicalAngle());
+        mTrajectoryStarted = true;
+      }
+      mTrajectory(mTargetPosition, durationUs * 1.0e-6f);
+      // degree/s to RPM
+      reference = mTrajectory.getPosition();
+      targetVelocity = mTrajectory.getVelocity() / 6.0f;
+      targetAcceleration = mTrajectory.getAcceleration() / 6.0f;
+    }
+
+    // the pid only corrects the tracking error, planned velocity is fed
+    // forward past its ramp
+    mechAngleError = reference - mechAngle;
+    targetVelocity += mMechAnglePid(mechAngleError, durationUs * 1.0e-6f);
+    mMotorCtlVelocity->setTargetVelocity(targetVelocity, targetAcceleration);
 
     mDurationEstimator->recordStart();
 
 #if CONFIG_JSCOPE_ENABLE
     _dPosCurr = mechAngle;
     _dPosErr = mechAngleError;
-    _dPosTarget = mTargetPosition;
+    _dPosTarget = reference;
 #endif
   }
   // next level loop
@@ -93,7 +130,9 @@ void MotorCtlPosition::loop() {
 
 void MotorCtlPosition::emergencyStop() { mMotorCtlVelocity->emergencyStop(); }
 
-bool MotorCtlPosition::fatalError() { return mMotorCtlVelocity->fatalError(); }
+bool MotorCtlPosition::fatalError() {
+  return mMechAngleEstimator->lost() || mMotorCtlVelocity->fatalError();
+}
 
 }  // namespace motorctl
 }  // namespace coriander
@@ -0,0 +1,161 @@
+/**
+ * @file motor_ctl_position_direct.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-24
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/motor_ctl_position_direct.h"
+
+#include "coriander/base/jscope.h"
+#include "coriander/base/math.h"
+
+#if CONFIG_JSCOPE_ENABLE
+ATTR_JSCOPE static float _dPosDirectCurr = 0.0f;
+ATTR_JSCOPE static float _dPosDirectTarget = 0.0f;
+ATTR_JSCOPE static float _dPosDirectVel = 0.0f;
+ATTR_JSCOPE static float _dPosDirectIq = 0.0f;
+#endif
+
+namespace coriander {
+namespace motorctl {
+
+void MotorCtlPositionDirect::start() {
+  int32_t divider;
+
+  mPositionP =
+      mParameters->getValue<float>(ParamId::MotorCtl_PosDirectCtl_PosP);
+  mVelocityLimit =
+      mParameters->getValue<float>(ParamId::MotorCtl_PosDirectCtl_VelLimit);
+
+  mVelocityPid.setGains(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosDirectCtl_VelP),
+      mParameters->getValue<float>(ParamId::MotorCtl_PosDirectCtl_VelI), 0.0f);
+  mVelocityPid.setRamp(0.0f);
+  mVelocityPid.setLimit(
+      mParameters->getValue<float>(ParamId::MotorCtl_PosDirectCtl_CurrLimit));
+  mVelocityPid.reset();
+
+  mVelocityLpf.Tf = mParameters->getValue<float>(
+      ParamId::MotorCtl_PosDirectCtl_Lpf_TimeConstant);
+  mVelocityLpf.clear();
+
+  // a multiple of the current loop period
+  divider =
+      mParameters->getValue<int32_t>(ParamId::MotorCtl_PosDirectCtl_Divider);
+  divider = divider < 1 ? 1 : divider;
+  mDurationTimeout->setDuration(static_cast<int32_t>(
+      1e6 * divider /
+      mParameters->getValue<int32_t>(ParamId::MotorCtl_CurrCtl_Freq)));
+
+  // motion profile and feed-forward are shared with the cascaded position mode
+  mUseTrajectory = false;
+  if (mParameters->has(ParamId::MotorCtl_PosCtl_TrajVelocity)) {
+    float velocity =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajVelocity);
+    float acceleration =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajAcceleration);
+    float jerk =
+        mParameters->getValue<float>(ParamId::MotorCtl_PosCtl_TrajJerk);
+    mTrajectory.setLimits(velocity * 6.0f, acceleration * 6.0f, jerk * 6.0f);
+    mUseTrajectory = velocity > 0.0f;
+  }
+  mAccelerationFeedForward = 0.0f;
+  if (mParameters->has(ParamId::MotorCtl_SpeedCtl_AccelerationFeedForward)) {
+    mAccelerationFeedForward = mParameters->getValue<float>(
+        ParamId::MotorCtl_SpeedCtl_AccelerationFeedForward);
+  }
+  mStarted = false;
+
+  mDurationEstimator->reset();
+  mSensorHandler.enable();
+
+  // next level start
+  mMotorCtlCurrent->start();
+}
+
+void MotorCtlPositionDirect::stop() {
+  mSensorHandler.disable();
+
+  // next level stop
+  mMotorCtlCurrent->stop();
+}
+
+void MotorCtlPositionDirect::loop() {
+  const uint32_t maxDurationUs = 5'000;
+  uint32_t durationUs;
+  float Ts, mechAngle, velocity;
+  float reference, targetVelocity, targetAcceleration, targetIq;
+
+  mSensorHandler.sync();
+
+  if (mDurationTimeout->expired()) {
+    mDurationTimeout->reset();
+
+    mDurationEstimator->recordStop();
+
+    durationUs = mDurationEstimator->getDuration();
+    if (durationUs > maxDurationUs) {
+      durationUs = maxDurationUs;
+    }
+    Ts = durationUs * 1.0e-6f;
+
+    mTargetPosition = mParameters->getValue<float>(
+        ParamId::MotorCtl_General_TargetPosition_RT);
+    mechAngle = mMechAngleEstimator->getMechanicalAngle();
+    if (!mStarted) {
+      mMechAnglePrev = mechAngle;
+      mTrajectory.reset(mechAngle);
+      mStarted = true;
+    }
+
+    // degree per tick to RPM
+    velocity = 0.0f;
+    if (durationUs > 0) {
+      velocity = mVelocityLpf((mechAngle - mMechAnglePrev) / Ts / 6.0f, Ts);
+    }
+    mMechAnglePrev = mechAngle;
+
+    reference = mTargetPosition;
+    targetVelocity = 0.0f;
+    targetAcceleration = 0.0f;
+    if (mUseTrajectory) {
+      mTrajectory(mTargetPosition, Ts);
+      reference = mTrajectory.getPosition();
+      targetVelocity = mTrajectory.getVelocity() / 6.0f;
+      targetAcceleration = mTrajectory.getAcceleration() / 6.0f;
+    }
+
+    // P on position, PI on velocity, acceleration as current feed-forward
+    targetVelocity = base::math::constrain(
+        targetVelocity + mPositionP * (reference - mechAngle), -mVelocityLimit,
+        mVelocityLimit);
+    targetIq = mVelocityPid(targetVelocity - velocity, Ts,
+                            mAccelerationFeedForward * targetAcceleration);
+    mMotorCtlCurrent->setTargetCurrent(0.0f, targetIq);
+
+    mDurationEstimator->recordStart();
+
+#if CONFIG_JSCOPE_ENABLE
+    _dPosDirectCurr = mechAngle;
+    _dPosDirectTarget = reference;
+    _dPosDirectVel = velocity;
+    _dPosDirectIq = targetIq * 1000.0f;
+#endif
+  }
+  // next level loop
+  mMotorCtlCurrent->loop();
+}
+
+void MotorCtlPositionDirect::emergencyStop() {
+  mMotorCtlCurrent->emergencyStop();
+}
+
+bool MotorCtlPositionDirect::fatalError() {
+  return mMechAngleEstimator->lost() || mMotorCtlCurrent->fatalError();
+}
+
+}  // namespace motorctl
+}  // namespace coriander
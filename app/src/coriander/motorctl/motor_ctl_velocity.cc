@@ -10,6 +10,8 @@
 #include "coriander/motorctl/motor_ctl_velocity.h"
 
 #include "coriander/base/jscope.h"
+#include "coriander/base/math.h"
+#include "coriander/motorctl/param_tables.h"
 
 #if CONFIG_JSCOPE_ENABLE
 ATTR_JSCOPE static float _dVelCurrent = 0.0f;
@@ -20,25 +22,108 @@ ATTR_JSCOPE static float _dVelErr = 0.0f;
 namespace coriander {
 namespace motorctl {
 
+static const GainScheduleParams kGainSchedule[] = {
+    {ParamId::MotorCtl_SpeedCtl_Sched0_Speed,
+     ParamId::MotorCtl_SpeedCtl_Sched0_PScale,
+     ParamId::MotorCtl_SpeedCtl_Sched0_IScale},
+    {ParamId::MotorCtl_SpeedCtl_Sched1_Speed,
+     ParamId::MotorCtl_SpeedCtl_Sched1_PScale,
+     ParamId::MotorCtl_SpeedCtl_Sched1_IScale},
+    {ParamId::MotorCtl_SpeedCtl_Sched2_Speed,
+     ParamId::MotorCtl_SpeedCtl_Sched2_PScale,
+     ParamId::MotorCtl_SpeedCtl_Sched2_IScale},
+    {ParamId::MotorCtl_SpeedCtl_Sched3_Speed,
+     ParamId::MotorCtl_SpeedCtl_Sched3_PScale,
+     ParamId::MotorCtl_SpeedCtl_Sched3_IScale},
+};
+
+// current reference filter on the pid output, before the current loop
+static const BiquadStageParams kRefFilter[] = {
+    {ParamId::MotorCtl_SpeedCtl_RefFilter0_Type,
+     ParamId::MotorCtl_SpeedCtl_RefFilter0_Frequency,
+     ParamId::MotorCtl_SpeedCtl_RefFilter0_Q,
+     ParamId::MotorCtl_SpeedCtl_RefFilter0_Gain},
+    {ParamId::MotorCtl_SpeedCtl_RefFilter1_Type,
+     ParamId::MotorCtl_SpeedCtl_RefFilter1_Frequency,
+     ParamId::MotorCtl_SpeedCtl_RefFilter1_Q,
+     ParamId::MotorCtl_SpeedCtl_RefFilter1_Gain},
+    {ParamId::MotorCtl_SpeedCtl_RefFilter2_Type,
+     ParamId::MotorCtl_SpeedCtl_RefFilter2_Frequency,
+     ParamId::MotorCtl_SpeedCtl_RefFilter2_Q,
+     ParamId::MotorCtl_SpeedCtl_RefFilter2_Gain},
+};
+
+// velocity feedback filter, after the low pass
+static const BiquadStageParams kFbFilter[] = {
+    {ParamId::MotorCtl_SpeedCtl_FbFilter0_Type,
+     ParamId::MotorCtl_SpeedCtl_FbFilter0_Frequency,
+     ParamId::MotorCtl_SpeedCtl_FbFilter0_Q,
+     ParamId::MotorCtl_SpeedCtl_FbFilter0_Gain},
+};
+
+// parameter of an optional feature, not in requiredParameters()
+static float optionalValue(const Parameter& params, ParamId id,
+                           float fallback = 0.0f) {
+  return params.has(id) ? params.getValue<float>(id) : fallback;
+}
+
 void MotorCtlVelocity::start() {
+  float gainP, gainI;
+
   // reset pid
-  mVelocityPid.P =
-      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidP);
-  mVelocityPid.I =
-      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidI);
-  mVelocityPid.D =
-      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidD);
-  mVelocityPid.output_ramp =
-      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidOutputRamp);
-  mVelocityPid.limit =
+  mVelocityPid.setGains(
+      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidP),
+      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidI),
+      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidD));
+  mVelocityPid.setRamp(
+      mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidOutputRamp));
+  mCurrentLimit =
       mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_PidLimit);
+  mVelocityPid.setLimit(mCurrentLimit);
   mVelocityPid.reset();
 
+  setupGainSchedule(mParameters.get(), kGainSchedule, &mGainSchedule);
+  mGainSchedule(0.0f, &gainP, &gainI);
+  mVelocityPid.setGainScale(gainP, gainI);
+
+  // field weakening, disabled without a current budget for Id
+  mFieldWeakening.setGains(
+      optionalValue(*mParameters, ParamId::MotorCtl_FieldWeakening_PidP),
+      optionalValue(*mParameters, ParamId::MotorCtl_FieldWeakening_PidI));
+  mFieldWeakening.setLimits(
+      optionalValue(*mParameters, ParamId::MotorCtl_FieldWeakening_Threshold,
+                    1.0f),
+      optionalValue(*mParameters, ParamId::MotorCtl_FieldWeakening_MaxCurrent));
+  mFieldWeakening.reset();
+
+  // mtpa, disabled on non-salient motors(Lq <= Ld). The loop current is
+  // 3/2 of the phase amplitude, the split takes it with the flux scaled by
+  // the same factor
+  mMtpa.setup(
+      optionalValue(*mParameters, ParamId::MotorCtl_MotorDriver_Ld),
+      optionalValue(*mParameters, ParamId::MotorCtl_MotorDriver_Lq),
+      optionalValue(*mParameters, ParamId::MotorCtl_MotorDriver_FluxLinkage) /
+          IPhaseCurrentEstimator::kAmplitudeScale,
+      mCurrentLimit);
+
+  // load torque observer, disabled without a torque constant
+  mDisturbanceObserver.setup(
+      optionalValue(*mParameters, ParamId::MotorCtl_MotorDriver_Inertia),
+      optionalValue(*mParameters, ParamId::MotorCtl_MotorDriver_TorqueConstant),
+      optionalValue(*mParameters,
+                    ParamId::MotorCtl_SpeedCtl_DisturbanceObserverBandwidth));
+  mLastTargetIq = 0.0f;
+
   // read parameters
   mTargetVelocity =
       mParameters->getValue<float>(ParamId::MotorCtl_General_TargetVelocity_RT);
-  mMotorSupplyVoltage =
-      mParameters->getValue<float>(ParamId::MotorCtl_MotorDriver_SupplyVoltage);
+
+  mTargetAcceleration = 0.0f;
+  mAccelerationFeedForward = 0.0f;
+  if (mParameters->has(ParamId::MotorCtl_SpeedCtl_AccelerationFeedForward)) {
+    mAccelerationFeedForward = mParameters->getValue<float>(
+        ParamId::MotorCtl_SpeedCtl_AccelerationFeedForward);
+  }
 
   mDurationTimeout->setDuration(static_cast<int32_t>(
       1e6 / mParameters->getValue<int32_t>(ParamId::MotorCtl_SpeedCtl_Freq)));
@@ -47,6 +132,16 @@ void MotorCtlVelocity::start() {
       mParameters->getValue<float>(ParamId::MotorCtl_SpeedCtl_Lpf_TimeConstant);
   mVelocityLpf.clear();
 
+  // coefficients for the nominal loop frequency
+  setupBiquadChain(
+      mParameters.get(), kRefFilter,
+      mParameters->getValue<int32_t>(ParamId::MotorCtl_SpeedCtl_Freq),
+      &mRefFilter);
+  setupBiquadChain(
+      mParameters.get(), kFbFilter,
+      mParameters->getValue<int32_t>(ParamId::MotorCtl_SpeedCtl_Freq),
+      &mFbFilter);
+
   // enable sensors, motor
   mSensorHandler.enable();
 
@@ -64,8 +159,8 @@ void MotorCtlVelocity::stop() {
 void MotorCtlVelocity::loop() {
   const uint32_t maxDurationUs = 20'000;
   uint32_t durationUs;
-  float velocityError;
-  float torqueTargetIq, torqueTargetId;
+  float velocity, velocityError;
+  float torqueTargetIq, torqueTargetId, torqueCompensationIq;
   float torqueTargetUq, torqueTargetUd;
 
   mSensorHandler.sync();
@@ -82,11 +177,61 @@ void MotorCtlVelocity::loop() {
       durationUs = maxDurationUs;
     }
 
-    velocityError =
-        mTargetVelocity -
-        mVelocityLpf(mVelocityEstimator->getVelocity(), durationUs * 1.0e-6f);
-    torqueTargetIq = mVelocityPid(velocityError, durationUs * 1.0e-6f);
-    torqueTargetId = 0.0f;
+    velocity = mFbFilter(
+        mVelocityLpf(mVelocityEstimator->getVelocity(), durationUs * 1.0e-6f));
+    velocityError = mTargetVelocity - velocity;
+
+    // scheduled over the speed
+    if (mGainSchedule.size() > 1) {
+      float gainP, gainI;
+      mGainSchedule(velocity, &gainP, &gainI);
+      mVelocityPid.setGainScale(gainP, gainI);
+    }
+
+    // negative Id once the voltage runs out, Iq gets what is left of the
+    // current circle
+    torqueTargetId = mFieldWeakening(mMotorCtlCurrent->getModulationIndex(),
+                                     durationUs * 1.0e-6f);
+    if (mFieldWeakening.enabled()) {
+      float left = mCurrentLimit * mCurrentLimit -
+                   torqueTargetId * torqueTargetId;
+      mVelocityPid.setLimit(base::math::sqrtf(left > 0.0f ? left : 0.0f));
+    }
+
+    // load torque compensation, on the unfiltered velocity, a filter lag
+    // would be taken for load
+    torqueCompensationIq =
+        mDisturbanceObserver(mVelocityEstimator->getVelocity(), mLastTargetIq,
+                             durationUs * 1.0e-6f);
+
+    // acceleration feed-forward and load compensation inside the pid
+    // limit, a saturated output is taken back from the integral instead of
+    // winding it up
+    torqueTargetIq = mVelocityPid(
+        velocityError, durationUs * 1.0e-6f,
+        mAccelerationFeedForward * mTargetAcceleration + torqueCompensationIq);
+    // notches for load resonances. The input is already within the pid
+    // limit and the filters have unity dc gain, so the clip only cuts a
+    // transient overshoot and leaves the integral alone
+    if (mRefFilter.size() > 0) {
+      torqueTargetIq = base::math::constrain(mRefFilter(torqueTargetIq),
+                                             -mVelocityPid.getLimit(),
+                                             mVelocityPid.getLimit());
+    }
+    mLastTargetIq = torqueTargetIq;
+    mVelocityEstimator->setTorqueCurrent(torqueTargetIq);
+
+    // split the demand into the mtpa Id/Iq pair on salient motors, passes
+    // through otherwise
+    if (mMtpa.enabled()) {
+      float mtpaId, left;
+      mMtpa(torqueTargetIq, &mtpaId, &torqueTargetIq);
+      torqueTargetId = base::math::constrain(torqueTargetId + mtpaId,
+                                             -mCurrentLimit, 0.0f);
+      left = mCurrentLimit * mCurrentLimit - torqueTargetId * torqueTargetId;
+      left = base::math::sqrtf(left > 0.0f ? left : 0.0f);
+      torqueTargetIq = base::math::constrain(torqueTargetIq, -left, left);
+    }
 
     mMotorCtlCurrent->setTargetCurrent(torqueTargetId, torqueTargetIq);
 
@@ -104,10 +249,14 @@ void MotorCtlVelocity::loop() {
 
 void MotorCtlVelocity::emergencyStop() { this->stop(); }
 
-bool MotorCtlVelocity::fatalError() { return false; }
+bool MotorCtlVelocity::fatalError() {
+  return mMotorCtlCurrent->fatalError();
+}
 
-void MotorCtlVelocity::setTargetVelocity(float velocityInRpm) {
+void MotorCtlVelocity::setTargetVelocity(float velocityInRpm,
+                                         float accelerationInRpmPerSecond) {
   mTargetVelocity = velocityInRpm;
+  mTargetAcceleration = accelerationInRpmPerSecond;
   mParameters->setValue(ParamId::MotorCtl_General_TargetVelocity_RT,
                         mTargetVelocity);
 }
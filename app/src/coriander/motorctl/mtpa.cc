@@ -0,0 +1,88 @@
+/**
+ * @file mtpa.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-26
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/mtpa.h"
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+// mtpa point of |Is|, dT/d(angle) = 0 solved for Id
+static void mtpa_point(float Ld, float Lq, float flux, float is, float* id,
+                       float* iq) {
+  float dL = Lq - Ld;
+  *id = (flux - math::sqrtf(flux * flux + 8.0f * dL * dL * is * is)) /
+        (4.0f * dL);
+  *iq = math::sqrtf(is * is - *id * *id);
+}
+
+Mtpa::Mtpa() : mEnabled(false), mScale(0.0f), mId(), mIq() {}
+
+void Mtpa::setup(float Ld, float Lq, float flux, float maxCurrent) {
+  float id, iq, torqueMax;
+
+  mEnabled = Lq > Ld && flux > 0.0f && maxCurrent > 0.0f;
+  if (!mEnabled) {
+    return;
+  }
+
+  // torque over 1.5 * p, monotonic in |Is| along the mtpa curve
+  auto torque = [&](float is) {
+    mtpa_point(Ld, Lq, flux, is, &id, &iq);
+    return flux * iq + (Ld - Lq) * id * iq;
+  };
+
+  // equally spaced in torque, |Is| of every entry found by bisection
+  torqueMax = torque(maxCurrent);
+  for (int i = 0; i < kTableSize; i++) {
+    float target = torqueMax * i / (kTableSize - 1);
+    float lo = 0.0f, hi = maxCurrent;
+    for (int n = 0; n < 32; n++) {
+      float mid = (lo + hi) * 0.5f;
+      if (torque(mid) < target) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    mtpa_point(Ld, Lq, flux, (lo + hi) * 0.5f, &mId[i], &mIq[i]);
+  }
+
+  // a demand of 1A is a torque of flux * 1A
+  mScale = flux * (kTableSize - 1) / torqueMax;
+}
+
+void Mtpa::operator()(float current, float* id, float* iq) const {
+  float x, frac;
+  int i;
+
+  if (!mEnabled) {
+    *id = 0.0f;
+    *iq = current;
+    return;
+  }
+
+  x = (current < 0.0f ? -current : current) * mScale;
+  if (x >= kTableSize - 1) {
+    i = kTableSize - 2;
+    frac = 1.0f;
+  } else {
+    i = static_cast<int>(x);
+    frac = x - i;
+  }
+  *id = mId[i] + (mId[i + 1] - mId[i]) * frac;
+  *iq = mIq[i] + (mIq[i + 1] - mIq[i]) * frac;
+  *iq = current < 0.0f ? -*iq : *iq;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
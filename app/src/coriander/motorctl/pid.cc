@@ -19,45 +19,52 @@ static inline T _constrain(T v, T min, T max) {
 namespace coriander {
 namespace motorctl {
 
-Pid::Pid(float P, float I, float D, float ramp, float limit)
+template <typename N>
+detail::Pid<N>::Pid(Gain P, Gain I, Gain D, Gain ramp, Value limit)
     : P(P),
       I(I),
       D(D),
       output_ramp(ramp),  // output derivative limit [volts/second]
       limit(limit),       // output supply limit     [volts]
-      error_prev(0.0f),
-      output_prev(0.0f),
-      integral_prev(0.0f) {}
+      error_prev(),
+      output_prev(),
+      integral_prev() {}
 
 // PID controller function
-float Pid::operator()(float error, float Ts) {
+template <typename N>
+typename detail::Pid<N>::Value detail::Pid<N>::operator()(Value error,
+                                                          Gain Ts) {
   // u(s) = (P + I/s + Ds)e(s)
   // Discrete implementations
   // proportional part
   // u_p  = P *e(k)
-  float proportional = P * error;
+  Value proportional = error * P;
   // Tustin transform of the integral part
   // u_ik = u_ik_1  + I*Ts/2*(ek + ek_1)
-  float integral = integral_prev + I * Ts * 0.5f * (error + error_prev);
+  // ek and ek_1 are scaled separately, (ek + ek_1) overflows in fixed-point
+  Gain integral_gain = I * Ts * Gain(0.5f);
+  Value integral =
+      integral_prev + error * integral_gain + error_prev * integral_gain;
   // antiwindup - limit the output
   integral = _constrain(integral, -limit, limit);
   // Discrete derivation
   // u_dk = D(ek - ek_1)/Ts
-  float derivative = D * (error - error_prev) / Ts;
+  Value derivative = (error - error_prev) * (D / Ts);
 
   // sum all the components
-  float output = proportional + integral + derivative;
+  Value output = proportional + integral + derivative;
   // antiwindup - limit the output variable
   output = _constrain(output, -limit, limit);
 
   // if output ramp defined
-  if (output_ramp > 0) {
+  if (output_ramp > Gain(0.0f)) {
     // limit the acceleration by ramping the output
-    float output_rate = (output - output_prev) / Ts;
-    if (output_rate > output_ramp) {
-      output = output_prev + output_ramp * Ts;
-    } else if (output_rate < -output_ramp) {
-      output = output_prev - output_ramp * Ts;
+    Value output_step = Value(output_ramp * Ts);
+    Value output_delta = output - output_prev;
+    if (output_delta > output_step) {
+      output = output_prev + output_step;
+    } else if (output_delta < -output_step) {
+      output = output_prev - output_step;
     }
   }
   // saving for the next pass
@@ -67,11 +74,23 @@ float Pid::operator()(float error, float Ts) {
   return output;
 }
 
-void Pid::reset() {
-  integral_prev = 0.0f;
-  output_prev = 0.0f;
-  error_prev = 0.0f;
+template <typename N>
+void detail::Pid<N>::reset() {
+  integral_prev = Value();
+  output_prev = Value();
+  error_prev = Value();
 }
 
+template <typename N>
+void detail::Pid<N>::backCalculate(Value output) {
+  integral_prev = _constrain(integral_prev - (output_prev - output), -limit,
+                             limit);
+  output_prev = output;
+}
+
+template struct detail::Pid<base::FloatNumeric>;
+template struct detail::Pid<base::Q15Numeric>;
+template struct detail::Pid<base::Q31Numeric>;
+
 }  // namespace motorctl
 }  // namespace coriander
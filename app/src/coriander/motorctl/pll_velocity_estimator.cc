@@ -0,0 +1,102 @@
+/**
+ * @file pll_velocity_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-28
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/pll_velocity_estimator.h"
+
+namespace coriander {
+namespace motorctl {
+
+PllVelocityEstimator::PllVelocityEstimator(
+    std::shared_ptr<IMechAngleEstimator> mechAngleEstimator,
+    std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+    std::shared_ptr<IParamReqValidator> paramReqValidator)
+    : mMechAngleEstimator(mechAngleEstimator),
+      mParam(param),
+      mSystick(systick),
+      mKp(0.0f),
+      mKi(0.0f),
+      mAngle(0.0f),
+      mVelocity(0.0f),
+      mTimestamp(0),
+      mEnabled(false) {
+  paramReqValidator->addParamReq(this);
+}
+
+void PllVelocityEstimator::enable() {
+  float bandwidth =
+      mParam->getValue<float>(ParamId::MotorCtl_SpeedEstimator_PllBandwidth);
+  mKp = 2.0f * bandwidth;
+  mKi = bandwidth * bandwidth;
+
+  if (!mMechAngleEstimator->enabled()) {
+    mMechAngleEstimator->enable();
+  }
+  mMechAngleEstimator->reset();  // reset sync count
+  mEnabled = true;
+
+  // force sync to lock on the current angle
+  mMechAngleEstimator->sync();
+  mAngle = mMechAngleEstimator->getMechanicalAngle();
+  mVelocity = 0.0f;
+  mTimestamp = mSystick->systick_us();
+}
+
+void PllVelocityEstimator::disable() {
+  if (mMechAngleEstimator->enabled()) {
+    mMechAngleEstimator->disable();
+  }
+  mEnabled = false;
+  mVelocity = 0.0f;
+}
+
+bool PllVelocityEstimator::enabled() {
+  return mEnabled && mMechAngleEstimator->enabled();
+}
+
+void PllVelocityEstimator::sync() {
+  uint32_t current = mSystick->systick_us();
+  float dt, angle, err;
+
+  // no time elapsed, nothing to integrate
+  if (current == mTimestamp) {
+    return;
+  }
+  dt = (current - mTimestamp) * 1e-6f;
+  mTimestamp = current;
+
+  if (mMechAngleEstimator->needSync(mSyncId)) {
+    mMechAngleEstimator->sync();
+  }
+  angle = mMechAngleEstimator->getMechanicalAngle();
+
+  // the discrete loop is unstable once Kp * dt reaches 1, a gap that long
+  // (stalled caller) re-locks on the measurement instead
+  if (mKp * dt >= 1.0f) {
+    mVelocity = (angle - mAngle) / dt;
+    mAngle = angle;
+    return;
+  }
+
+  mAngle += mVelocity * dt;
+  err = angle - mAngle;
+  mAngle += mKp * dt * err;
+  mVelocity += mKi * dt * err;
+}
+
+void PllVelocityEstimator::calibrate() {}
+
+bool PllVelocityEstimator::needCalibrate() { return false; }
+
+float PllVelocityEstimator::getVelocity() {
+  // degree per second to RPM
+  return mVelocity / 6.0f;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
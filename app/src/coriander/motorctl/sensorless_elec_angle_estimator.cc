@@ -0,0 +1,113 @@
+/**
+ * @file sensorless_elec_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/sensorless_elec_angle_estimator.h"
+
+namespace coriander {
+namespace motorctl {
+
+SensorlessElecAngleEstimator::SensorlessElecAngleEstimator(
+    std::shared_ptr<IPhaseCurrentEstimator> phaseCurrentEstimator,
+    std::shared_ptr<Parameter> param, std::shared_ptr<ISystick> systick,
+    std::shared_ptr<IParamReqValidator> paramReqValidator) noexcept
+    : mPhaseCurrentEstimator(phaseCurrentEstimator),
+      mParam(param),
+      mSystick(systick),
+      mObserver(),
+      mVoltageScale(0.0f),
+      mVoltageAlpha(0.0f),
+      mVoltageBeta(0.0f),
+      mMinVelocity(0.0f),
+      mTimestamp(0),
+      mFluxKnown(false),
+      mEnabled(false) {
+  paramReqValidator->addParamReq(this);
+}
+
+void SensorlessElecAngleEstimator::enable() {
+  int32_t polePair =
+      mParam->getValue<int32_t>(ParamId::MotorCtl_MotorDriver_PolePair);
+  float flux =
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_FluxLinkage);
+
+  // SpaceVectorPwm units, the full bus is 2
+  mVoltageScale =
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_SupplyVoltage) *
+      0.5f;
+  mObserver.setup(
+      mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_Rs),
+      (mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_Ld) +
+       mParam->getValue<float>(ParamId::MotorCtl_MotorDriver_Lq)) *
+          0.5f,
+      flux, mParam->getValue<float>(ParamId::MotorCtl_Sensorless_ObserverGain),
+      mParam->getValue<float>(ParamId::MotorCtl_Sensorless_PllBandwidth));
+  // RPM to electrical degree per second
+  mMinVelocity =
+      mParam->getValue<float>(ParamId::MotorCtl_Sensorless_MinSpeed) * 6.0f *
+      polePair;
+  mFluxKnown = flux > 0.0f;
+
+  if (!mPhaseCurrentEstimator->enabled()) {
+    mPhaseCurrentEstimator->enable();
+  }
+  mVoltageAlpha = 0.0f;
+  mVoltageBeta = 0.0f;
+  mTimestamp = mSystick->systick_us();
+  mEnabled = true;
+}
+
+void SensorlessElecAngleEstimator::disable() {
+  if (mPhaseCurrentEstimator->enabled()) {
+    mPhaseCurrentEstimator->disable();
+  }
+  mEnabled = false;
+}
+
+void SensorlessElecAngleEstimator::sync() {
+  uint32_t current = mSystick->systick_us();
+  float Ialpha, Ibeta;
+
+  // no time elapsed, nothing to integrate
+  if (current == mTimestamp) {
+    return;
+  }
+
+  if (mPhaseCurrentEstimator->needSync(mSyncId)) {
+    mPhaseCurrentEstimator->sync();
+  }
+  mPhaseCurrentEstimator->getPhaseCurrent(&Ialpha, &Ibeta);
+  Ialpha *= IPhaseCurrentEstimator::kAmplitudeScale;
+  Ibeta *= IPhaseCurrentEstimator::kAmplitudeScale;
+
+  // the voltage was applied since the last sync
+  mObserver(mVoltageAlpha * mVoltageScale, mVoltageBeta * mVoltageScale,
+            Ialpha, Ibeta, (current - mTimestamp) * 1e-6f);
+  mTimestamp = current;
+}
+
+bool SensorlessElecAngleEstimator::enabled() {
+  return mEnabled && mPhaseCurrentEstimator->enabled();
+}
+
+void SensorlessElecAngleEstimator::calibrate() {}
+
+bool SensorlessElecAngleEstimator::needCalibrate() { return false; }
+
+float SensorlessElecAngleEstimator::getElectricalAngle() noexcept {
+  return mObserver.getAngle();
+}
+
+void SensorlessElecAngleEstimator::setVoltage(float alpha,
+                                              float beta) noexcept {
+  mVoltageAlpha = alpha;
+  mVoltageBeta = beta;
+}
+
+}  // namespace motorctl
+}  // namespace coriander
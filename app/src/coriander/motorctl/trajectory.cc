@@ -0,0 +1,149 @@
+/**
+ * @file trajectory.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-23
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include "coriander/motorctl/trajectory.h"
+
+#include <cmath>
+
+#include "coriander/base/math.h"
+
+namespace coriander {
+namespace motorctl {
+
+using base::math;
+
+// highest speed that still stops within distance, decelerating by rate * Ts
+// every step. Discrete form of sqrt(2 * rate * distance), so the last step
+// lands on the target instead of oscillating around it
+static float brake(float distance, float rate, float Ts) {
+  float step = rate * Ts;
+  return step * (math::sqrtf(0.25f + 2.0f * distance / (step * Ts)) - 0.5f);
+}
+
+// distance covered by the fastest jerk limited stop from (velocity,
+// acceleration), acceleration is brought to -am, held and released to zero so
+// that velocity and acceleration reach zero together
+static float stopDistance(float velocity, float acceleration, float maxAcc,
+                          float jerk) {
+  float sign, k, am, t1, t2, t3, d, v;
+
+  // direction of the stop, velocity left once acceleration is released
+  v = velocity + acceleration * std::fabs(acceleration) * 0.5f / jerk;
+  sign = v < 0.0f ? -1.0f : 1.0f;
+  velocity *= sign;
+  acceleration *= sign;
+
+  k = velocity + acceleration * acceleration * 0.5f / jerk;
+  if (k * jerk >= maxAcc * maxAcc) {
+    am = maxAcc;
+    t2 = (k - maxAcc * maxAcc / jerk) / maxAcc;
+  } else {
+    am = math::sqrtf(k * jerk);
+    t2 = 0.0f;
+  }
+
+  t1 = (acceleration + am) / jerk;
+  d = velocity * t1 + acceleration * t1 * t1 * 0.5f -
+      jerk * t1 * t1 * t1 / 6.0f;
+  v = velocity + (acceleration * acceleration - am * am) * 0.5f / jerk;
+  d += v * t2 - am * t2 * t2 * 0.5f;
+  v -= am * t2;
+  t3 = am / jerk;
+  d += v * t3 - am * t3 * t3 * 0.5f + jerk * t3 * t3 * t3 / 6.0f;
+  return sign * d;
+}
+
+Trajectory::Trajectory()
+    : mMaxVelocity(0.0f),
+      mMaxAcceleration(0.0f),
+      mMaxJerk(0.0f),
+      mPosition(0.0f),
+      mVelocity(0.0f),
+      mAcceleration(0.0f),
+      mDone(true) {}
+
+void Trajectory::setLimits(float velocity, float acceleration, float jerk) {
+  mMaxVelocity = velocity;
+  mMaxAcceleration = acceleration;
+  mMaxJerk = jerk > 0.0f ? jerk : 0.0f;
+}
+
+void Trajectory::reset(float position, float velocity) {
+  mPosition = position;
+  mVelocity = velocity;
+  mAcceleration = 0.0f;
+  mDone = false;
+}
+
+void Trajectory::operator()(float target, float Ts) {
+  float error, direction, previous;
+
+  if (Ts <= 0.0f || mMaxVelocity <= 0.0f || mMaxAcceleration <= 0.0f) {
+    return;
+  }
+
+  error = target - mPosition;
+  direction = error < 0.0f ? -1.0f : 1.0f;
+  previous = mAcceleration;
+
+  if (mMaxJerk > 0.0f) {
+    // largest jerk towards the target that can still stop at it and keep the
+    // velocity limit, the constraints are monotonic so bisect over jerk
+    const float A = mMaxAcceleration, J = mMaxJerk;
+    float distance = error * direction;
+    float velocity = mVelocity * direction;
+    float acceleration = mAcceleration * direction;
+    auto feasible = [&](float jerk, float* a) {
+      *a = math::constrain(acceleration + jerk * Ts, -A, A);
+      float v = velocity + *a * Ts;
+      float release = *a > 0.0f ? *a * *a * 0.5f / J : 0.0f;
+      return v + release <= mMaxVelocity &&
+             stopDistance(v, *a, A, J) <= distance - v * Ts;
+    };
+
+    float lo = -J, hi = J, a;
+    if (feasible(hi, &a)) {
+      lo = hi;
+    } else {
+      for (int i = 0; i < 12; i++) {
+        float mid = (lo + hi) * 0.5f;
+        if (feasible(mid, &a)) {
+          lo = mid;
+        } else {
+          hi = mid;
+        }
+      }
+    }
+    feasible(lo, &a);
+    mAcceleration = a * direction;
+  } else {
+    float velocity = brake(error * direction, mMaxAcceleration, Ts);
+    velocity = direction * (velocity < mMaxVelocity ? velocity : mMaxVelocity);
+    mAcceleration = math::constrain((velocity - mVelocity) / Ts,
+                                    -mMaxAcceleration, mMaxAcceleration);
+  }
+
+  mVelocity += mAcceleration * Ts;
+  mPosition += mVelocity * Ts;
+
+  // snap once the last step reaches or crosses the target at crawling speed
+  mDone = false;
+  float crawl = mMaxJerk > 0.0f ? mMaxJerk * Ts * Ts : mMaxAcceleration * Ts;
+  if ((target - mPosition) * direction <= crawl * Ts &&
+      std::fabs(mVelocity) <= crawl &&
+      (mMaxJerk <= 0.0f || std::fabs(previous) <= mMaxJerk * Ts)) {
+    mPosition = target;
+    mVelocity = 0.0f;
+    mAcceleration = 0.0f;
+    mDone = true;
+  }
+}
+
+}  // namespace motorctl
+}  // namespace coriander
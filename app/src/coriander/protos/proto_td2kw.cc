@@ -183,13 +183,10 @@ void ProtoTd2kw::rxRoutine() noexcept {
   mEnable = mRxFrameParser.getEnable();
   mCurrTargetPos = newTargetPos;
 
-  // update target position
+  // update target position, the position loop follows it without a restart
   if (targetPosChanged && mEnable) {
     mParams->setValue(ParamId::MotorCtl_General_TargetPosition_RT,
                       mCurrTargetPos);
-    if (!enableTriggered && !disableTriggered) {
-      mBoardEvent->raiseEvent(BoardEvent::ParameterUpdate);
-    }
   }
 
   // update enable state
@@ -19,6 +19,7 @@
 // backends
 #include "coriander/iprotocol_ctl.h"
 #include "zephyr/zephyr_appstatus.h"
+#include "zephyr/zephyr_bus_voltage_estimator.h"
 #include "zephyr/zephyr_diagnosis.h"
 #include "zephyr/zephyr_encoder.h"
 #include "zephyr/zephyr_logger.h"
@@ -47,6 +48,10 @@ extern void board_parameter_default_value_setup(
 namespace {
 
 static void loop_hook() {
+  // report the position sensor fail-over, the inspectors run on the main loop
+  coriander::application::zephyr::DiagnosisRegister::getInstance()
+      ->dispatch();
+
   // wait for main loop tick, max wait time is 1ms
   k_sem_take(&main_wakeup, K_MSEC(1));
 }
@@ -58,6 +63,8 @@ static auto zephyr_backends_bindings() {
   using FocMotorDriverBase = coriander::motorctl::FocMotorDriverBase;
   using IBldcDriver = coriander::motorctl::IBldcDriver;
   using IEncoder = coriander::motorctl::IEncoder;
+  using ILoadEncoder = coriander::motorctl::ILoadEncoder;
+  using BackendLoadEncoder = coriander::motorctl::zephyr::LoadEncoder;
   using ISystick = coriander::os::ISystick;
   using ISemaphore = coriander::os::ISemaphore;
   using IThread = coriander::os::IThread;
@@ -69,6 +76,8 @@ static auto zephyr_backends_bindings() {
   using IPhaseCurrentEstimator = coriander::motorctl::IPhaseCurrentEstimator;
   using PhaseCurrentEstimator =
       coriander::motorctl::zephyr::PhaseCurrentEstimator;
+  using IBusVoltageEstimator = coriander::motorctl::IBusVoltageEstimator;
+  using BusVoltageEstimator = coriander::motorctl::zephyr::BusVoltageEstimator;
   using coriander::Parameter;
   using PersistentParameter = coriander::zephyr::PersistentParameter;
   return boost::di::make_injector(
@@ -77,11 +86,13 @@ static auto zephyr_backends_bindings() {
       boost::di::bind<FocMotorDriver>.to<BackendMotorDriver>(),
       boost::di::bind<IBldcDriver>.to<BackendMotorDriver>(),
       boost::di::bind<IEncoder>.to<coriander::motorctl::zephyr::Encoder>(),
+      boost::di::bind<ILoadEncoder>.to<BackendLoadEncoder>(),
       boost::di::bind<ISystick>.to<coriander::os::zephyr::Systick>(),
       boost::di::bind<ISemaphore>.to<coriander::os::zephyr::Semaphore>(),
       boost::di::bind<IThread>.to<coriander::os::zephyr::Thread>(),
       boost::di::bind<IMutex>.to<coriander::os::zephyr::Mutex>(),
       boost::di::bind<IPhaseCurrentEstimator>.to<PhaseCurrentEstimator>(),
+      boost::di::bind<IBusVoltageEstimator>.to<BusVoltageEstimator>(),
       boost::di::bind<Parameter>.to<PersistentParameter>(),
       boost::di::bind<IShellCtl>.to<coriander::zephyr::ShellProtocol>());
 }
@@ -0,0 +1,111 @@
+/**
+ * @file foc_batch_fixture.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief scalar and batched current loops of n axes, shared by
+ *        ut_foc_batch.cc and bench_foc_batch.cc
+ * @date 2023-10-15
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "coriander/motorctl/foc.h"
+#include "coriander/motorctl/foc_batch.h"
+#include "coriander/motorctl/pid.h"
+
+namespace testing {
+namespace foc_batch {
+
+namespace foc = coriander::motorctl::foc;
+namespace batch = coriander::motorctl::foc::batch;
+using coriander::motorctl::Pid;
+
+constexpr int maxAxes = 11;  // two simd steps and a tail
+
+inline float random_float(float range) {
+  return range * (2.0f * std::rand() / RAND_MAX - 1.0f);
+}
+
+/**
+ * @brief d/q current loop of n axes, scalar transforms one axis at a time
+ */
+struct ScalarAxes {
+  explicit ScalarAxes(int n)
+      : n(n),
+        pidD(n, Pid{0.5f, 100.0f, 0.0f, 0.0f, 0.7f}),
+        pidQ(n, Pid{0.5f, 100.0f, 0.0f, 0.0f, 0.7f}) {}
+
+  void operator()(const float* alpha, const float* beta, const float* s,
+                  const float* c, const float* targetD, const float* targetQ,
+                  float Ts) {
+    for (int i = 0; i < n; i++) {
+      float d, q, ud, uq, ua, ub;
+      foc::park(alpha[i], beta[i], s[i], c[i], &d, &q);
+      ud = pidD[i](targetD[i] - d, Ts);
+      uq = pidQ[i](targetQ[i] - q, Ts);
+      foc::invPark(ud, uq, s[i], c[i], &ua, &ub);
+      foc::SpaceVectorPwm(ua, ub, &du[i], &dv[i], &dw[i]);
+    }
+  }
+
+  int n;
+  std::vector<Pid> pidD, pidQ;
+  float du[maxAxes], dv[maxAxes], dw[maxAxes];
+};
+
+/**
+ * @brief same current loop, d and q channels packed as [d0..dn, q0..qn]
+ */
+struct BatchAxes {
+  explicit BatchAxes(int n) : n(n) {
+    for (int i = 0; i < 2 * n; i++) {
+      P[i] = 0.5f, I[i] = 100.0f, limit[i] = 0.7f;
+      integral[i] = errorPrev[i] = 0;
+    }
+  }
+
+  void operator()(const float* alpha, const float* beta, const float* s,
+                  const float* c, const float* targetD, const float* targetQ,
+                  float Ts) {
+    float dq[2 * maxAxes], error[2 * maxAxes], u[2 * maxAxes];
+    float ua[maxAxes], ub[maxAxes];
+    batch::park(alpha, beta, s, c, dq, dq + n, n);
+    for (int i = 0; i < n; i++) {
+      error[i] = targetD[i] - dq[i];
+      error[n + i] = targetQ[i] - dq[n + i];
+    }
+    batch::pi({P, I, limit, integral, errorPrev}, error, Ts, u, 2 * n);
+    batch::invPark(u, u + n, s, c, ua, ub, n);
+    batch::SpaceVectorPwm(ua, ub, du, dv, dw, n);
+  }
+
+  int n;
+  float P[2 * maxAxes], I[2 * maxAxes], limit[2 * maxAxes];
+  float integral[2 * maxAxes], errorPrev[2 * maxAxes];
+  float du[maxAxes], dv[maxAxes], dw[maxAxes];
+};
+
+struct Sample {
+  float alpha[maxAxes], beta[maxAxes], s[maxAxes], c[maxAxes];
+  float targetD[maxAxes], targetQ[maxAxes];
+};
+
+inline void random_sample(Sample* sample) {
+  for (int i = 0; i < maxAxes; i++) {
+    float angle = random_float(3.14159265358979f);
+    sample->alpha[i] = random_float(2.0f);
+    sample->beta[i] = random_float(2.0f);
+    sample->s[i] = std::sin(angle);
+    sample->c[i] = std::cos(angle);
+    sample->targetD[i] = random_float(0.5f);
+    sample->targetQ[i] = random_float(2.0f);
+  }
+}
+
+}  // namespace foc_batch
+}  // namespace testing
@@ -60,6 +60,8 @@ static inline auto createInjector() {
       bind<coriander::Parameter>().to<testing::mock::MockPersistentParameter>(),
       bind<coriander::motorctl::IPhaseCurrentEstimator>()
           .to<testing::mock::MockPhaseCurrentEstimator>(),
+      bind<coriander::motorctl::IBusVoltageEstimator>()
+          .to<testing::mock::MockBusVoltageEstimator>(),
       bind<coriander::IParamReqValidator>()
           .to<testing::mock::MockParamReqValidator>());
 }
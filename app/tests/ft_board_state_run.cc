@@ -52,7 +52,11 @@ static auto createInjector() {
       bind<coriander::os::IMutex>.to<coriander::os::posix::Mutex>(),
       bind<coriander::os::ISemaphore>.to<coriander::os::posix::Semaphore>(),
       bind<coriander::motorctl::IEncoder>.to<testing::mock::MockEncoder>(),
+      bind<coriander::motorctl::ILoadEncoder>.to<
+          testing::mock::MockLoadEncoder>(),
       bind<coriander::motorctl::IPhaseCurrentEstimator>.to<Mpce>(),
+      bind<coriander::motorctl::IBusVoltageEstimator>.to<
+          testing::mock::MockBusVoltageEstimator>(),
       bind<coriander::Parameter>.to<testing::mock::MockPersistentParameter>(),
       bind<coriander::motorctl::FocMotorDriver>.to<MockFocMotorDriver>());
 }
@@ -28,6 +28,8 @@ TEST(Coriander, DiagError) {
       bind<coriander::base::ILogger>.to<coriander::base::posix::Logger>(),
       bind<coriander::application::IAppStatus>.to<BackendAppStatus>(),
       bind<coriander::motorctl::IEncoder>.to<testing::mock::MockEncoder>(),
+      bind<coriander::motorctl::ILoadEncoder>.to<
+          testing::mock::MockLoadEncoder>(),
       bind<coriander::os::ISystick>.to<testing::mock::MockSystick>(),
       bind<coriander::motorctl::IBldcDriver>.to<MockBldcDriver>(),
       bind<coriander::motorctl::FocMotorDriver>.to<MockFocMotorDriver>(),
@@ -35,6 +37,8 @@ TEST(Coriander, DiagError) {
       bind<coriander::os::IThread>.to<testing::mock::MockThread>(),
       bind<coriander::os::IMutex>.to<coriander::os::posix::Mutex>(),
       bind<coriander::motorctl::IPhaseCurrentEstimator>.to<Mpce>(),
+      bind<coriander::motorctl::IBusVoltageEstimator>.to<
+          testing::mock::MockBusVoltageEstimator>(),
       bind<coriander::Parameter>.to<testing::mock::MockPersistentParameter>(),
       bind<coriander::IShellCtl>.to<testing::mock::MockShellCtl>()));
 
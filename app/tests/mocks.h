@@ -29,6 +29,7 @@
 #include "coriander/istate_handler.h"
 #include "coriander/motorctl/foc_motor_driver.h"
 #include "coriander/motorctl/ibldc_driver.h"
+#include "coriander/motorctl/ibus_voltage_estimator.h"
 #include "coriander/motorctl/ielec_angle_estimator.h"
 #include "coriander/motorctl/iencoder.h"
 #include "coriander/motorctl/imech_angle_estimator.h"
@@ -101,6 +102,18 @@ struct MockEncoder : public coriander::motorctl::IEncoder {
   MOCK_METHOD0(calibrate, void());
 };
 
+struct MockLoadEncoder : public coriander::motorctl::ILoadEncoder {
+  MOCK_METHOD0(getEncoderCount, unsigned());
+  MOCK_METHOD0(getEncoderCountPerRound, unsigned());
+  MOCK_METHOD0(getOverflowCount, int());
+  MOCK_METHOD0(enable, void());
+  MOCK_METHOD0(disable, void());
+  MOCK_METHOD0(enabled, bool());
+  MOCK_METHOD0(sync, void());
+  MOCK_METHOD0(needCalibrate, bool());
+  MOCK_METHOD0(calibrate, void());
+};
+
 struct MockAppStatus : public coriander::application::IAppStatus {
   MOCK_METHOD(void, setStatus, (Status), (noexcept));
   MOCK_METHOD(Status, getStatus, (), (const, noexcept));
@@ -168,7 +181,8 @@ struct MockFocMotorDriver : public coriander::motorctl::FocMotorDriver {
   MOCK_METHOD0(fatalError, bool());
   MOCK_METHOD(void, setPhaseDutyCycle, (uint16_t, uint16_t, uint16_t),
               (override));
-  MOCK_METHOD(void, setVoltage, (float, float), (override));
+  using coriander::motorctl::FocMotorDriver::setVoltage;
+  MOCK_METHOD(void, setVoltage, (float, float, float, float), (override));
   // void setPhaseDutyCycle(uint16_t u, uint16_t v, uint16_t w) override {}
 };
 
@@ -216,6 +230,18 @@ struct MockPhaseCurrentEstimator
   MOCK_METHOD(bool, needCalibrate, (), (override));
 };
 
+struct MockBusVoltageEstimator
+    : public coriander::motorctl::IBusVoltageEstimator {
+  MOCK_METHOD(float, getBusVoltage, (), (override));
+  MOCK_METHOD(float, getTemperature, (), (override));
+  MOCK_METHOD(void, enable, (), (override));
+  MOCK_METHOD(void, disable, (), (override));
+  MOCK_METHOD(bool, enabled, (), (override));
+  MOCK_METHOD(void, sync, (), (override));
+  MOCK_METHOD(void, calibrate, (), (override));
+  MOCK_METHOD(bool, needCalibrate, (), (override));
+};
+
 struct MockPersistentParameter : public coriander::IPersistentParameter {
   MOCK_METHOD(bool, save, (), (override));
   MOCK_METHOD(bool, load, (), (override));
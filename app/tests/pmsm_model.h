@@ -0,0 +1,117 @@
+/**
+ * @file pmsm_model.h
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#pragma once
+
+#include <cmath>
+
+namespace testing {
+namespace sim {
+
+/**
+ * @brief surface PMSM in the stationary frame, speed imposed by a stiff load
+ *
+ * L * di/dt = v - R * i - e, e = flux * w * (-sin(theta), cos(theta))
+ */
+struct PmsmModel {
+  double R = 0.2;       // Ohm
+  double L = 0.3e-3;    // H
+  double flux = 8e-3;   // Wb
+  double theta = 0.0;   // electrical angle, rad
+  double omega = 0.0;   // electrical speed, rad/s
+  double ialpha = 0.0;  // A
+  double ibeta = 0.0;   // A
+
+  /**
+   * @brief hold the voltage over dt, integrated in small steps
+   */
+  void step(double valpha, double vbeta, double dt, int substeps = 20) {
+    double h = dt / substeps;
+    for (int n = 0; n < substeps; n++) {
+      double ealpha = -flux * omega * std::sin(theta);
+      double ebeta = flux * omega * std::cos(theta);
+      ialpha += (valpha - R * ialpha - ealpha) / L * h;
+      ibeta += (vbeta - R * ibeta - ebeta) / L * h;
+      theta += omega * h;
+    }
+    theta = std::remainder(theta, 2 * M_PI);
+  }
+
+  /**
+   * @return electrical angle, degree in [0, 360)
+   */
+  float angle() const {
+    double deg = theta * 180.0 / M_PI;
+    return static_cast<float>(deg < 0 ? deg + 360.0 : deg);
+  }
+
+  /**
+   * @brief steady state voltage for (id, iq) in a frame at angle, what an
+   *        ideal current loop outputs
+   *
+   * @param angle rotor angle the controller believes, degree
+   */
+  void feedForward(double id, double iq, double angle, float *valpha,
+                   float *vbeta) const {
+    double vd = R * id - omega * L * iq;
+    double vq = R * iq + omega * L * id + omega * flux;
+    double rad = angle * M_PI / 180.0;
+    *valpha = static_cast<float>(vd * std::cos(rad) - vq * std::sin(rad));
+    *vbeta = static_cast<float>(vd * std::sin(rad) + vq * std::cos(rad));
+  }
+};
+
+/**
+ * @brief salient PMSM in the rotor frame, d-axis saturating with positive Id
+ *
+ * Ld(id) * did/dt = vd - R * id + w * Lq * iq
+ * Lq * diq/dt = vq - R * iq - w * (Ld * id + flux)
+ * Ld(id) = Ld / (1 + saturation * id) for id > 0, the magnet side
+ */
+struct SalientPmsmModel {
+  double R = 0.2;             // Ohm
+  double Ld = 0.25e-3;        // H
+  double Lq = 0.4e-3;         // H
+  double flux = 8e-3;         // Wb
+  double saturation = 0.05;   // 1/A
+  double theta = 0.0;         // electrical angle, rad
+  double omega = 0.0;         // electrical speed, rad/s
+  double id = 0.0;            // A
+  double iq = 0.0;            // A
+
+  void step(double valpha, double vbeta, double dt, int substeps = 20) {
+    double h = dt / substeps;
+    for (int n = 0; n < substeps; n++) {
+      double c = std::cos(theta), s = std::sin(theta);
+      double vd = valpha * c + vbeta * s;
+      double vq = -valpha * s + vbeta * c;
+      double ld = id > 0 ? Ld / (1 + saturation * id) : Ld;
+      double did = (vd - R * id + omega * Lq * iq) / ld;
+      double diq = (vq - R * iq - omega * (Ld * id + flux)) / Lq;
+      id += did * h;
+      iq += diq * h;
+      theta += omega * h;
+    }
+    theta = std::remainder(theta, 2 * M_PI);
+  }
+
+  double ialpha() const { return id * std::cos(theta) - iq * std::sin(theta); }
+  double ibeta() const { return id * std::sin(theta) + iq * std::cos(theta); }
+
+  /**
+   * @return electrical angle, degree in [0, 360)
+   */
+  float angle() const {
+    double deg = theta * 180.0 / M_PI;
+    return static_cast<float>(deg < 0 ? deg + 360.0 : deg);
+  }
+};
+
+}  // namespace sim
+}  // namespace testing
@@ -46,9 +46,36 @@ def svpwm_raw(alpha: float, beta: float, switch_duration:float, Udc: float):
 
     return i,j,k
 
+def svpwm_minmax(alpha: float, beta: float, switch_duration:float, Udc: float):
+    u_ref = math.sqrt(alpha * alpha + beta * beta)
+    if u_ref > Udc:
+        alpha, beta = alpha * Udc / u_ref, beta * Udc / u_ref
+    va = alpha
+    vb = -0.5 * alpha + math.sqrt(3) / 2 * beta
+    vc = -0.5 * alpha - math.sqrt(3) / 2 * beta
+    offset = (max(va, vb, vc) + min(va, vb, vc)) / 2
+    t_halfsample = switch_duration / 2
+    scale = t_halfsample / Udc
+    return (t_halfsample + (va - offset) * scale,
+            t_halfsample + (vb - offset) * scale,
+            t_halfsample + (vc - offset) * scale)
+
 def svpwm(alpha: float, beta: float):
     return svpwm_raw(alpha, beta, 1, 1)
 
+def emulator_dense_grid(steps: int = 301, limit: float = 1.5):
+    # same grid as ut_foc.cc, svpwm_minmax must match svpwm_raw everywhere
+    max_err = 0
+    for x in range(steps):
+        for y in range(steps):
+            alpha = -limit + 2 * limit * x / (steps - 1)
+            beta = -limit + 2 * limit * y / (steps - 1)
+            ref = svpwm_raw(alpha, beta, 1, 1)
+            out = svpwm_minmax(alpha, beta, 1, 1)
+            max_err = max(max_err, *[abs(r - o) for r, o in zip(ref, out)])
+    print("dense grid: %d points, max error: %.3e" % (steps * steps, max_err))
+    assert(max_err < 1e-9)
+
 def emulator_key_point():
     for idx in range(36):
         angle = idx * math.pi / 18
@@ -60,6 +87,7 @@ def emulator_key_point():
 if __name__ == '__main__':
 
     emulator_key_point()
+    emulator_dense_grid()
 
     # show the wave to verify the correctness
     t = np.linspace(0, 0.01, 1000)
@@ -0,0 +1,93 @@
+/**
+ * @file ut_backlash_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "coriander/base/math.h"
+#include "coriander/motorctl/backlash_estimator.h"
+
+namespace {
+using coriander::motorctl::BacklashEstimator;
+
+constexpr float kEngageCurrent = 0.5f;
+constexpr float kCenter = 1.5f;
+constexpr float kBacklash = 0.8f;
+constexpr float kCompliance = 0.05f;
+
+/**
+ * @brief twist of a gear loaded on the flank of the torque, anywhere in the
+ *        gap below the engage current
+ */
+float gearTwist(float Iq, float gapPosition) {
+  if (Iq > kEngageCurrent) {
+    return kCenter + 0.5f * kBacklash + kCompliance * Iq;
+  }
+  if (Iq < -kEngageCurrent) {
+    return kCenter - 0.5f * kBacklash + kCompliance * Iq;
+  }
+  return kCenter + gapPosition * 0.5f * kBacklash;
+}
+}  // namespace
+
+TEST(BacklashEstimator, converge) {
+  BacklashEstimator estimator;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> gap(-1.0f, 1.0f);
+  std::normal_distribution<float> noise(0.0f, 0.01f);
+
+  estimator.setup(kEngageCurrent, 0.999f, 0.0f, 0.0f);
+  estimator.reset(0.0f);
+
+  // reversing moves, torque sweeps both flanks
+  for (int i = 0; i < 5000; i++) {
+    float Iq = 3.0f * std::sin(2 * M_PI * i / 500.0);
+    estimator(gearTwist(Iq, gap(rng)) + noise(rng), Iq);
+  }
+
+  EXPECT_NEAR(estimator.getCenter(), kCenter, 0.01f);
+  EXPECT_NEAR(estimator.getBacklash(), kBacklash, 0.01f);
+  EXPECT_NEAR(estimator.getCompliance(), kCompliance, 0.005f);
+  EXPECT_NEAR(estimator.predict(2.0f), gearTwist(2.0f, 0.0f), 0.01f);
+  EXPECT_NEAR(estimator.predict(-2.0f), gearTwist(-2.0f, 0.0f), 0.01f);
+}
+
+TEST(BacklashEstimator, ignoreGap) {
+  BacklashEstimator estimator;
+
+  estimator.setup(kEngageCurrent, 0.999f, kBacklash, kCompliance);
+  estimator.reset(kCenter);
+
+  for (int i = 0; i < 100; i++) {
+    estimator(10.0f, 0.2f);  // the gear floats, nothing to learn
+  }
+  EXPECT_FLOAT_EQ(estimator.getCenter(), kCenter);
+  EXPECT_FLOAT_EQ(estimator.getBacklash(), kBacklash);
+  EXPECT_FLOAT_EQ(estimator.getCompliance(), kCompliance);
+}
+
+TEST(BacklashEstimator, side) {
+  BacklashEstimator estimator;
+
+  estimator.setup(kEngageCurrent, 1.0f, kBacklash, kCompliance);
+  estimator.reset(kCenter);
+  EXPECT_EQ(estimator.side(), 1);
+
+  // held inside the engage band
+  estimator(gearTwist(-1.0f, 0.0f), -1.0f);
+  EXPECT_EQ(estimator.side(), -1);
+  estimator(gearTwist(0.3f, 0.0f), 0.3f);
+  EXPECT_EQ(estimator.side(), -1);
+  EXPECT_FLOAT_EQ(estimator.predict(0.0f), kCenter - 0.5f * kBacklash);
+  estimator(gearTwist(0.6f, 0.0f), 0.6f);
+  EXPECT_EQ(estimator.side(), 1);
+  EXPECT_FLOAT_EQ(estimator.predict(0.0f), kCenter + 0.5f * kBacklash);
+}
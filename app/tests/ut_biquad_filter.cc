@@ -0,0 +1,127 @@
+/**
+ * @file ut_biquad_filter.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-08
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/base/math.h"
+#include "coriander/motorctl/biquad_filter.h"
+
+namespace {
+using coriander::motorctl::BiquadChain;
+using coriander::motorctl::BiquadFilter;
+using Type = coriander::motorctl::BiquadFilter::Type;
+
+constexpr float kSampleFrequency = 1000.0f;
+
+/**
+ * @brief amplitude of the settled response to a unit sine, projected on the
+ *        input frequency over the last second
+ */
+template <typename F>
+float gainAt(F& filter, float frequency) {
+  const int n = static_cast<int>(kSampleFrequency);
+  double s = 0.0, c = 0.0;
+
+  for (int i = 0; i < 4 * n; i++) {
+    double phase = 2 * M_PI * frequency * i / kSampleFrequency;
+    float y = filter(static_cast<float>(std::sin(phase)));
+    if (i >= 3 * n) {
+      s += y * std::sin(phase);
+      c += y * std::cos(phase);
+    }
+  }
+  return static_cast<float>(2.0 / n * std::sqrt(s * s + c * c));
+}
+}  // namespace
+
+TEST(BiquadFilter, bypass) {
+  BiquadFilter filter;
+
+  EXPECT_FLOAT_EQ(filter(1.5f), 1.5f);
+  EXPECT_FALSE(filter.setup(Type::Bypass, 10.0f, 1.0f, 0.0f, 1000.0f));
+  EXPECT_FLOAT_EQ(filter(-2.0f), -2.0f);
+
+  // above nyquist it passes through rather than going unstable
+  EXPECT_FALSE(filter.setup(Type::LowPass, 600.0f, 0.7f, 0.0f, 1000.0f));
+  EXPECT_FLOAT_EQ(filter(3.0f), 3.0f);
+}
+
+TEST(BiquadFilter, lowPass) {
+  BiquadFilter filter;
+  float y = 0.0f;
+
+  ASSERT_TRUE(
+      filter.setup(Type::LowPass, 50.0f, M_SQRT1_2, 0.0f, kSampleFrequency));
+  for (int i = 0; i < 200; i++) {
+    y = filter(1.0f);
+  }
+  EXPECT_NEAR(y, 1.0f, 1e-4f);
+
+  filter.reset();
+  EXPECT_NEAR(gainAt(filter, 5.0f), 1.0f, 0.01f);
+  filter.reset();
+  EXPECT_NEAR(gainAt(filter, 50.0f), M_SQRT1_2, 0.01f);
+  filter.reset();
+  EXPECT_LT(gainAt(filter, 300.0f), 0.05f);
+}
+
+TEST(BiquadFilter, notch) {
+  BiquadFilter filter;
+
+  ASSERT_TRUE(filter.setup(Type::Notch, 120.0f, 2.0f, 0.0f, kSampleFrequency));
+  EXPECT_LT(gainAt(filter, 120.0f), 0.01f);
+  filter.reset();
+  EXPECT_NEAR(gainAt(filter, 10.0f), 1.0f, 0.01f);
+  filter.reset();
+  EXPECT_NEAR(gainAt(filter, 450.0f), 1.0f, 0.02f);
+
+  // partial depth
+  ASSERT_TRUE(
+      filter.setup(Type::Notch, 120.0f, 2.0f, 0.1f, kSampleFrequency));
+  EXPECT_NEAR(gainAt(filter, 120.0f), 0.1f, 0.005f);
+}
+
+TEST(BiquadFilter, leadLag) {
+  BiquadFilter filter;
+  float y = 0.0f;
+
+  ASSERT_TRUE(
+      filter.setup(Type::LeadLag, 50.0f, 0.0f, 4.0f, kSampleFrequency));
+  for (int i = 0; i < 200; i++) {
+    y = filter(1.0f);
+  }
+  EXPECT_NEAR(y, 1.0f, 1e-4f);  // unit dc gain
+
+  // geometric mean of the dc and the high frequency gain at the center
+  filter.reset();
+  EXPECT_NEAR(gainAt(filter, 50.0f), 2.0f, 0.02f);
+  filter.reset();
+  EXPECT_NEAR(gainAt(filter, 450.0f), 4.0f, 0.05f);
+}
+
+TEST(BiquadChain, cascade) {
+  BiquadChain chain;
+  const BiquadChain::Stage stages[] = {
+      {Type::Notch, 120.0f, 2.0f, 0.0f},
+      {Type::Bypass, 0.0f, 0.0f, 0.0f},  // dropped
+      {Type::LowPass, 200.0f, 0.7f, 0.0f},
+  };
+
+  EXPECT_FLOAT_EQ(chain(2.0f), 2.0f);
+
+  chain.setup(stages, 3, kSampleFrequency);
+  EXPECT_EQ(chain.size(), 2);
+  EXPECT_LT(gainAt(chain, 120.0f), 0.01f);
+  chain.reset();
+  EXPECT_NEAR(gainAt(chain, 5.0f), 1.0f, 0.01f);
+  chain.reset();
+  EXPECT_LT(gainAt(chain, 400.0f), 0.25f);
+}
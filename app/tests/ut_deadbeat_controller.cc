@@ -0,0 +1,182 @@
+/**
+ * @file ut_deadbeat_controller.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-14
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "coriander/motorctl/deadbeat_controller.h"
+#include "tests/pmsm_model.h"
+
+using coriander::motorctl::DeadbeatController;
+using testing::sim::SalientPmsmModel;
+
+namespace {
+constexpr float Ts = 1e-4f;          // 10kHz current loop
+constexpr float kBandwidth = 300.0f;  // MotorCtl_CurrCtl_DeadbeatSpeedBandwidth
+
+/**
+ * @brief motor behind a pwm that takes the voltage one period after its
+ *        sample, measured as the hardware does
+ */
+struct Plant {
+  SalientPmsmModel motor;
+  float valpha = 0.0f;  //!< voltage on over the current period
+  float vbeta = 0.0f;
+  float angleStep = 0.0f;    //!< encoder resolution, electrical degree
+  float currentStep = 0.0f;  //!< adc resolution of a phase current, A
+
+  Plant() { motor.saturation = 0.0; }
+
+  float quantize(float value, float step) {
+    return step > 0.0f ? std::round(value / step) * step : value;
+  }
+
+  /**
+   * @brief phase currents through the adc, amplitude invariant clarke and
+   *        park at the measured angle
+   */
+  void measure(float angle, float* id, float* iq) {
+    float rad = angle * static_cast<float>(M_PI) / 180.0f;
+    float ia = motor.ialpha();
+    float ib = -0.5f * motor.ialpha() + 0.5f * std::sqrt(3.0f) * motor.ibeta();
+    float ic = -ia - ib;
+    float alpha, beta;
+
+    ia = quantize(ia, currentStep);
+    ib = quantize(ib, currentStep);
+    ic = quantize(ic, currentStep);
+    alpha = (2.0f * ia - ib - ic) / 3.0f;
+    beta = (ib - ic) / std::sqrt(3.0f);
+    *id = alpha * std::cos(rad) + beta * std::sin(rad);
+    *iq = -alpha * std::sin(rad) + beta * std::cos(rad);
+  }
+
+  /**
+   * @brief closed loop over some periods, errors after the last one, A
+   */
+  void run(DeadbeatController* ctl, float targetId, float targetIq,
+           int periods, float* errorId, float* errorIq) {
+    for (int k = 0; k < periods; k++) {
+      // the encoder count below the shaft
+      float angle = angleStep > 0.0f
+                        ? std::floor(motor.angle() / angleStep) * angleStep
+                        : motor.angle();
+      float rad = angle * static_cast<float>(M_PI) / 180.0f;
+      float id, iq, ud, uq;
+
+      measure(angle, &id, &iq);
+      (*ctl)(targetId, targetIq, id, iq, angle, Ts, &ud, &uq);
+      ctl->advance(&ud, &uq);
+
+      motor.step(valpha, vbeta, Ts);
+      valpha = ud * std::cos(rad) - uq * std::sin(rad);
+      vbeta = ud * std::sin(rad) + uq * std::cos(rad);
+    }
+    *errorId = targetId - motor.id;
+    *errorIq = targetIq - motor.iq;
+  }
+};
+}  // namespace
+
+TEST(DeadbeatController, disabled) {
+  DeadbeatController ctl;
+  float ud = 1.0f, uq = 1.0f;
+
+  ctl.setup(0.2f, 0.0f, 0.4e-3f, 8e-3f, kBandwidth);
+  EXPECT_FALSE(ctl.enabled());
+  ctl(0.0f, 1.0f, 0.0f, 0.0f, 0.0f, Ts, &ud, &uq);
+  EXPECT_EQ(ud, 0.0f);
+  EXPECT_EQ(uq, 0.0f);
+}
+
+TEST(DeadbeatController, standstill) {
+  Plant plant;
+  DeadbeatController ctl;
+  float errorId, errorIq;
+
+  ctl.setup(plant.motor.R, plant.motor.Ld, plant.motor.Lq, plant.motor.flux,
+            kBandwidth);
+
+  // one period of computation delay, on target the period after
+  plant.run(&ctl, 0.0f, 2.0f, 1, &errorId, &errorIq);
+  EXPECT_NEAR(errorIq, 2.0f, 1e-3f);
+  plant.run(&ctl, 0.0f, 2.0f, 1, &errorId, &errorIq);
+  EXPECT_NEAR(errorIq, 0.0f, 0.05f);
+  EXPECT_NEAR(errorId, 0.0f, 0.01f);
+
+  plant.run(&ctl, 0.0f, 2.0f, 100, &errorId, &errorIq);
+  EXPECT_NEAR(errorIq, 0.0f, 0.02f);
+}
+
+TEST(DeadbeatController, atSpeed) {
+  Plant plant;
+  DeadbeatController ctl;
+  float errorId, errorIq;
+
+  plant.motor.omega = 2 * M_PI * 200;  // electrical 200Hz, back-EMF ~10V
+  ctl.setup(plant.motor.R, plant.motor.Ld, plant.motor.Lq, plant.motor.flux,
+            kBandwidth);
+
+  // spinning with no voltage applied before, settles in a few periods
+  plant.run(&ctl, -1.0f, 2.0f, 6, &errorId, &errorIq);
+  EXPECT_NEAR(errorIq, 0.0f, 0.05f);
+  EXPECT_NEAR(errorId, 0.0f, 0.05f);
+  plant.run(&ctl, -1.0f, 2.0f, 200, &errorId, &errorIq);
+  EXPECT_NEAR(errorIq, 0.0f, 0.03f);
+  EXPECT_NEAR(errorId, 0.0f, 0.03f);
+  EXPECT_NEAR(ctl.getVelocity(), 200.0f * 360.0f, 200.0f);
+
+  // a step lands two periods later, d only sees a fraction of it
+  plant.run(&ctl, -1.0f, 4.0f, 2, &errorId, &errorIq);
+  EXPECT_NEAR(errorIq, 0.0f, 0.1f);
+  EXPECT_NEAR(errorId, 0.0f, 0.2f);
+}
+
+/**
+ * @brief worst current error and speed spread over some periods at speed
+ */
+static void quantizedRun(float bandwidth, float* worstIq, float* spread) {
+  Plant plant;
+  DeadbeatController ctl;
+  float errorId, errorIq, lo = 1e9f, hi = -1e9f;
+
+  plant.motor.omega = 2 * M_PI * 200;
+  plant.angleStep = 360.0f * 7 / 4096;  // 1024 lines, 7 pole pairs
+  plant.currentStep = 0.01f;            // 12 bit over +-20A
+  ctl.setup(plant.motor.R, plant.motor.Ld, plant.motor.Lq, plant.motor.flux,
+            bandwidth);
+
+  plant.run(&ctl, -1.0f, 2.0f, 500, &errorId, &errorIq);
+  *worstIq = 0.0f;
+  for (int k = 0; k < 500; k++) {
+    plant.run(&ctl, -1.0f, 2.0f, 1, &errorId, &errorIq);
+    *worstIq = std::max(*worstIq, std::fabs(errorIq));
+    lo = std::min(lo, ctl.getVelocity());
+    hi = std::max(hi, ctl.getVelocity());
+  }
+  *spread = hi - lo;
+}
+
+TEST(DeadbeatController, quantizedAngle) {
+  float worstIq, spread, rawWorstIq, rawSpread;
+
+  quantizedRun(kBandwidth, &worstIq, &spread);
+  quantizedRun(0.0f, &rawWorstIq, &rawSpread);
+
+  // a count of 0.6 degree per 100us is 6000 degree/s of step noise, its
+  // back-EMF alone a fifth of an ampere off in one period
+  EXPECT_GT(rawSpread, 5000.0f);
+  EXPECT_GT(rawWorstIq, 0.1f);
+
+  EXPECT_LT(spread, 0.01f * 200.0f * 360.0f);
+  EXPECT_LT(worstIq, 0.05f);
+  EXPECT_LT(worstIq, 0.5f * rawWorstIq);
+}
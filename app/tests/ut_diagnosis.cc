@@ -64,3 +64,27 @@ TEST(Diagnosis, trigger) {
   EXPECT_EQ(called_matrix[static_cast<int>(DiagDevId::CtlrBoardPsPower)], true);
   EXPECT_EQ(called_matrix[static_cast<int>(DiagDevId::CtrlBoardTemp)], false);
 }
+
+TEST(Diagnosis, inspectOne) {
+  using Diagnosis = coriander::application::Diagnosis;
+  using DiagDevId = coriander::application::Diagnosis::DiagDevId;
+  int called = 0;
+
+  Diagnosis diag;
+
+  diag.setDiagDev(DiagDevId::CtlrBoardPsVoltage,
+                  []() { return Diagnosis::DeviceStatus::Normal; });
+  diag.setDiagDev(DiagDevId::MotorInnerPosSensor,
+                  []() { return Diagnosis::DeviceStatus::Error; });
+
+  diag.addDiagInspector(
+      [&](Diagnosis::DiagDevId id, Diagnosis::DeviceStatus status) {
+        EXPECT_EQ(id, DiagDevId::MotorInnerPosSensor);
+        EXPECT_EQ(status, Diagnosis::DeviceStatus::Error);
+        called++;
+      });
+
+  diag.inspect(DiagDevId::MotorInnerPosSensor);
+  diag.inspect(DiagDevId::MotorInnerPosSensor);
+  EXPECT_EQ(called, 1);
+}
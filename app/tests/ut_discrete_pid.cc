@@ -0,0 +1,121 @@
+/**
+ * @file ut_discrete_pid.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-22
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/discrete_pid.h"
+#include "coriander/motorctl/pid.h"
+
+namespace {
+using coriander::motorctl::DiscretePid;
+using coriander::motorctl::Pid;
+using AntiWindup = DiscretePid::AntiWindup;
+
+/**
+ * @brief peak overshoot of a first-order plant after a saturated step
+ */
+static float overshoot(AntiWindup mode) {
+  const float Ts = 1e-3f, target = 1.0f;
+  DiscretePid pid{2.0f, 4.0f, 0.0f, 0.0f, 1.0f};
+  float y = 0, peak = 0;
+
+  pid.setAntiWindup(mode);
+  for (int i = 0; i < 5000; i++) {
+    float u = pid(target - y, Ts);
+    // dy/dt = (2 * u - y) / 0.5, needs u = 0.5 at steady state
+    y += (2 * u - y) * Ts / 0.5f;
+    peak = std::max(peak, y);
+  }
+  return peak - target;
+}
+}  // namespace
+
+TEST(DiscretePid, sameAsPid) {
+  const float Ts = 1e-3f;
+  Pid pid{0.5f, 100.0f, 1e-3f, 200.0f, 2.0f};
+  DiscretePid discrete{0.5f, 100.0f, 1e-3f, 200.0f, 2.0f};
+  discrete.setAntiWindup(AntiWindup::Clamp);
+
+  for (int i = 0; i < 1000; i++) {
+    float error = std::sin(i * 0.01f) * 3.0f;
+    ASSERT_NEAR(discrete(error, Ts), pid(error, Ts), 1e-4) << "i: " << i;
+  }
+}
+
+TEST(DiscretePid, jitteredTs) {
+  // a measured Ts wobbles around the nominal one, integral and ramp must
+  // still follow it exactly
+  Pid pid{0.5f, 100.0f, 0.0f, 200.0f, 2.0f};
+  DiscretePid discrete{0.5f, 100.0f, 0.0f, 200.0f, 2.0f};
+  discrete.setAntiWindup(AntiWindup::Clamp);
+
+  for (int i = 0; i < 1000; i++) {
+    float Ts = 1e-3f * (1.0f + 0.02f * ((i * 7) % 5 - 2) / 2);
+    float error = std::sin(i * 0.01f) * 3.0f;
+    ASSERT_NEAR(discrete(error, Ts), pid(error, Ts), 1e-4) << "i: " << i;
+  }
+}
+
+TEST(DiscretePid, antiWindup) {
+  float clamp = overshoot(AntiWindup::Clamp);
+  float back = overshoot(AntiWindup::BackCalculation);
+  float conditional = overshoot(AntiWindup::Conditional);
+  EXPECT_LT(back, clamp * 0.5f);
+  EXPECT_LT(conditional, clamp * 0.5f);
+}
+
+TEST(DiscretePid, backCalculate) {
+  const float Ts = 1e-3f;
+  for (auto mode : {AntiWindup::BackCalculation, AntiWindup::Conditional}) {
+    DiscretePid pid{1.0f, 100.0f, 0.0f, 0.0f, 10.0f};
+    pid.setAntiWindup(mode);
+
+    // outer limiter only allows 1.0 for a while
+    for (int i = 0; i < 100; i++) {
+      if (pid(2.0f, Ts) > 1.0f) {
+        pid.backCalculate(1.0f);
+      }
+    }
+    // error reverses, integral does not hold the output up
+    EXPECT_LT(pid(-0.5f, Ts), 0.5f) << "mode: " << static_cast<int>(mode);
+  }
+}
+
+TEST(DiscretePid, feedForwardAndFilter) {
+  const float Ts = 1e-3f;
+  DiscretePid pid{0.0f, 0.0f, 1.0f, 0.0f, 100.0f};
+
+  // feed-forward passes through
+  EXPECT_FLOAT_EQ(pid(0.0f, Ts, 3.0f), 3.0f);
+
+  // unfiltered derivative of a unit step is 1/Ts, filtered one decays with Tf
+  pid.reset();
+  EXPECT_FLOAT_EQ(pid(0.05f, Ts), 50.0f);
+  pid.reset();
+  pid.setDerivativeFilter(9e-3f);
+  float first = pid(0.05f, Ts), second = pid(0.05f, Ts);
+  EXPECT_FLOAT_EQ(first, 5.0f);
+  EXPECT_FLOAT_EQ(second, 4.5f);
+}
+
+TEST(DiscretePid, gainScale) {
+  const float Ts = 1e-3f;
+  DiscretePid scaled{1.0f, 100.0f, 0.0f, 0.0f, 100.0f};
+  DiscretePid reference{2.0f, 50.0f, 0.0f, 0.0f, 100.0f};
+
+  scaled(0.0f, Ts);
+  reference(0.0f, Ts);
+  scaled.setGainScale(2.0f, 0.5f);
+  for (int i = 0; i < 100; i++) {
+    float error = 0.01f * i;
+    ASSERT_NEAR(scaled(error, Ts), reference(error, Ts), 1e-5) << "i: " << i;
+  }
+}
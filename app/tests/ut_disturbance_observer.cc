@@ -0,0 +1,89 @@
+/**
+ * @file ut_disturbance_observer.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-03
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/discrete_pid.h"
+#include "coriander/motorctl/disturbance_observer.h"
+
+using coriander::motorctl::DiscretePid;
+using coriander::motorctl::DisturbanceObserver;
+
+namespace {
+constexpr float Ts = 1e-3f;              // 1kHz velocity loop
+constexpr double kInertia = 1e-4;        // kg*m^2
+constexpr double kTorqueConstant = 0.1;  // Nm/A
+constexpr double kRpm = 60 / (2 * M_PI);
+
+/**
+ * @brief velocity loop on a rigid rotor, ideal current loop, load step at
+ *        0.1s
+ *
+ * @return worst speed drop, RPM
+ */
+float loadStep(DisturbanceObserver* dob, float* load) {
+  // about 50 rad/s
+  DiscretePid pid(0.005f, 0.1f, 0.0f, 1e6f, 10.0f);
+  double omega = 0.0, torque;
+  float iq = 0.0f, worst = 0.0f;
+
+  for (int i = 0; i < 1000; i++) {
+    float velocity = static_cast<float>(omega * kRpm);
+    float compensation = (*dob)(velocity, iq, Ts);
+
+    iq = pid(0.0f - velocity, Ts) + compensation;
+    torque = kTorqueConstant * iq - (i >= 100 ? 0.05 : 0.0);
+    omega += torque / kInertia * Ts;
+    worst = std::max(worst, -velocity);
+  }
+  *load = dob->getLoadTorque();
+  return worst;
+}
+}  // namespace
+
+TEST(DisturbanceObserver, disabled) {
+  DisturbanceObserver dob;
+
+  dob.setup(kInertia, 0.0f, 200.0f);
+  EXPECT_FALSE(dob.enabled());
+  EXPECT_EQ(dob(100.0f, 1.0f, Ts), 0.0f);
+  dob.setup(kInertia, kTorqueConstant, 0.0f);
+  EXPECT_FALSE(dob.enabled());
+  EXPECT_EQ(dob(100.0f, 1.0f, Ts), 0.0f);
+}
+
+TEST(DisturbanceObserver, constantLoad) {
+  DisturbanceObserver dob;
+  double omega = 1000 / kRpm;
+  float iq = 1.0f, compensation = 0.0f;
+
+  // 1A against 0.05Nm, accelerating at 500 rad/s^2
+  dob.setup(kInertia, kTorqueConstant, 200.0f);
+  for (int i = 0; i < 100; i++) {
+    compensation = dob(static_cast<float>(omega * kRpm), iq, Ts);
+    omega += (kTorqueConstant * iq - 0.05) / kInertia * Ts;
+  }
+  EXPECT_NEAR(dob.getLoadTorque(), 0.05f, 1e-3f);
+  EXPECT_NEAR(compensation, 0.5f, 1e-2f);
+}
+
+TEST(DisturbanceObserver, stiffness) {
+  DisturbanceObserver without, with;
+  float loadWithout, loadWith;
+
+  with.setup(kInertia, kTorqueConstant, 200.0f);
+  float dropWithout = loadStep(&without, &loadWithout);
+  float dropWith = loadStep(&with, &loadWith);
+
+  EXPECT_LT(dropWith, dropWithout * 0.3f);
+  EXPECT_NEAR(loadWith, 0.05f, 1e-3f);
+  EXPECT_EQ(loadWithout, 0.0f);
+}
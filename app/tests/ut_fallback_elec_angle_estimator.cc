@@ -0,0 +1,292 @@
+/**
+ * @file ut_fallback_elec_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "coriander/application/diagnosis.h"
+#include "coriander/base/math.h"
+#include "coriander/motorctl/fallback_elec_angle_estimator.h"
+#include "coriander/motorctl/fallback_mech_angle_estimator.h"
+#include "tests/mocks.h"
+#include "tests/pmsm_model.h"
+
+namespace {
+using Property = coriander::base::Property;
+using ParamId = coriander::base::ParamId;
+using Parameter = testing::mock::MockPersistentParameter;
+using Diagnosis = coriander::application::Diagnosis;
+using coriander::motorctl::EncoderElecAngleEstimator;
+using coriander::motorctl::EncoderMechAngleEstimator;
+using coriander::motorctl::FallbackElecAngleEstimator;
+using coriander::motorctl::FallbackMechAngleEstimator;
+using coriander::motorctl::SensorlessElecAngleEstimator;
+using testing::sim::PmsmModel;
+
+constexpr int kPolePair = 4;
+constexpr unsigned kCountPerRound = 4096;
+constexpr uint32_t kTickUs = 50;  // 20kHz current loop
+constexpr float kSupplyVoltage = 24.0f;
+
+struct DummyEncoder : public coriander::motorctl::IEncoder {
+  virtual void enable() { mEnabled = true; }
+  virtual void disable() { mEnabled = false; }
+  virtual bool enabled() { return mEnabled; }
+  virtual bool needCalibrate() { return false; }
+  virtual void calibrate() {}
+  virtual void sync() {}
+  virtual unsigned getEncoderCount() { return mCC; }
+  virtual unsigned getEncoderCountPerRound() { return kCountPerRound; }
+  virtual int getOverflowCount() { return 0; }
+
+  unsigned mCC = 0;
+  bool mEnabled = false;
+};
+
+struct DummyPhaseCurrentEstimator
+    : public coriander::motorctl::IPhaseCurrentEstimator {
+  virtual void enable() { mEnabled = true; }
+  virtual void disable() { mEnabled = false; }
+  virtual bool enabled() { return mEnabled; }
+  virtual bool needCalibrate() { return false; }
+  virtual void calibrate() {}
+  virtual void sync() {}
+  // as the backend returns it, 3/2 of the model current
+  virtual void getPhaseCurrent(float* alpha, float* beta) {
+    *alpha = static_cast<float>(mModel->ialpha) / kAmplitudeScale;
+    *beta = static_cast<float>(mModel->ibeta) / kAmplitudeScale;
+  }
+
+  const PmsmModel* mModel = nullptr;
+  bool mEnabled = false;
+};
+
+struct DummySystick : public coriander::os::ISystick {
+  virtual uint32_t systick_ms() { return us / 1000; }
+  virtual uint32_t systick_us() { return us; }
+  uint32_t us = 0;
+};
+
+/**
+ * @brief motor spun by a stiff load, current loop replaced by the ideal
+ *        voltage for Iq on the angle the estimator reports
+ */
+struct Bench {
+  Bench() {
+    model.omega = 2 * M_PI * 100;  // 1500 RPM
+    model.theta = 30.0 * M_PI / 180;
+    phaseCurrent->mModel = &model;
+
+    param->add(Property{kPolePair, ParamId::MotorCtl_MotorDriver_PolePair});
+    param->add(Property{0, ParamId::Sensor_Encoder_ReverseElecAngle});
+    param->add(
+        Property{0.0f, ParamId::MotorCtl_Calibrate_CaliElecAngleOffset});
+    param->add(Property{kSupplyVoltage,
+                        ParamId::MotorCtl_MotorDriver_SupplyVoltage});
+    param->add(Property{static_cast<float>(model.R),
+                        ParamId::MotorCtl_MotorDriver_Rs});
+    param->add(Property{static_cast<float>(model.L),
+                        ParamId::MotorCtl_MotorDriver_Ld});
+    param->add(Property{static_cast<float>(model.L),
+                        ParamId::MotorCtl_MotorDriver_Lq});
+    param->add(Property{static_cast<float>(model.flux),
+                        ParamId::MotorCtl_MotorDriver_FluxLinkage});
+    param->add(Property{100.0f, ParamId::MotorCtl_Sensorless_ObserverGain});
+    param->add(Property{300.0f, ParamId::MotorCtl_Sensorless_PllBandwidth});
+    param->add(Property{200.0f, ParamId::MotorCtl_Sensorless_MinSpeed});
+    param->add(
+        Property{30.0f, ParamId::MotorCtl_Sensorless_FaultThreshold});
+    param->add(Property{20, ParamId::MotorCtl_Sensorless_FaultCount});
+
+    diagnosis->addDiagInspector(
+        [this](Diagnosis::DiagDevId id, Diagnosis::DeviceStatus status) {
+          if (id == Diagnosis::DiagDevId::MotorInnerPosSensor) {
+            reported = status;
+          }
+        });
+    diagnosis->inspect();
+
+    syncEncoder();
+    estimator.enable();
+  }
+
+  void syncEncoder() {
+    if (mStalled) {
+      return;
+    }
+    double mech = mElecAngle / kPolePair / (2 * M_PI);
+
+    encoder->mCC = static_cast<unsigned>(
+        (mech - std::floor(mech)) * kCountPerRound + mGlitch);
+    encoder->mCC %= kCountPerRound;
+  }
+
+  /**
+   * @return float error of the reported angle, electrical degree
+   */
+  float tick() {
+    float valpha, vbeta;
+
+    model.feedForward(0.0, 2.0, estimator.getElectricalAngle(), &valpha,
+                      &vbeta);
+    estimator.setVoltage(valpha / (kSupplyVoltage * 0.5f),
+                         vbeta / (kSupplyVoltage * 0.5f));
+    model.step(valpha, vbeta, kTickUs * 1e-6);
+    mElecAngle += model.omega * kTickUs * 1e-6;
+    syncEncoder();
+    systick->us += kTickUs;
+    if (estimator.needSync(++mSyncId)) {
+      estimator.sync();
+    }
+    if (mech.enabled() && mech.needSync(mSyncId)) {
+      mech.sync();
+    }
+
+    return coriander::base::math::wrapd180(estimator.getElectricalAngle() -
+                                           model.angle());
+  }
+
+  void glitch(unsigned counts) { mGlitch = counts; }
+  void stall() { mStalled = true; }
+
+  PmsmModel model;
+  std::shared_ptr<DummyEncoder> encoder = std::make_shared<DummyEncoder>();
+  std::shared_ptr<DummyPhaseCurrentEstimator> phaseCurrent =
+      std::make_shared<DummyPhaseCurrentEstimator>();
+  std::shared_ptr<DummySystick> systick = std::make_shared<DummySystick>();
+  std::shared_ptr<Parameter> param = std::make_shared<Parameter>();
+  std::shared_ptr<Diagnosis> diagnosis = std::make_shared<Diagnosis>();
+  std::shared_ptr<testing::mock::MockParamReqValidator> validator =
+      std::make_shared<testing::mock::MockParamReqValidator>();
+  std::shared_ptr<FallbackElecAngleEstimator> fallback =
+      std::make_shared<FallbackElecAngleEstimator>(
+          std::make_shared<EncoderElecAngleEstimator>(
+              encoder, param, std::make_shared<testing::mock::MockLogger>(),
+              validator),
+          std::make_shared<SensorlessElecAngleEstimator>(phaseCurrent, param,
+                                                         systick, validator),
+          diagnosis, param, validator);
+  FallbackElecAngleEstimator& estimator = *fallback;
+  FallbackMechAngleEstimator mech{
+      std::make_shared<EncoderMechAngleEstimator>(encoder, param, validator),
+      fallback, systick, param, validator};
+  Diagnosis::DeviceStatus reported = Diagnosis::DeviceStatus::Unknown;
+
+ private:
+  double mElecAngle = 30.0 * M_PI / 180;  // unwrapped
+  unsigned mGlitch = 0;
+  unsigned mSyncId = 0;
+  bool mStalled = false;
+};
+}  // namespace
+
+TEST(FallbackElecAngleEstimator, followEncoder) {
+  Bench bench;
+  float worst = 0.0f;
+
+  ASSERT_EQ(bench.reported, Diagnosis::DeviceStatus::Normal);
+  for (int i = 0; i < 4000; i++) {
+    worst = std::max(worst, std::abs(bench.tick()));
+  }
+  EXPECT_FALSE(bench.estimator.failed());
+  EXPECT_LT(worst, 1.0f);  // encoder resolution
+  bench.diagnosis->inspect();  // polled by the main loop
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Normal);
+}
+
+TEST(FallbackElecAngleEstimator, rideThroughGlitch) {
+  Bench bench;
+
+  for (int i = 0; i < 4000; i++) {
+    bench.tick();
+  }
+
+  // half an electrical turn for a few ticks, below FaultCount
+  bench.glitch(kCountPerRound / kPolePair / 2);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_LT(std::abs(bench.tick()), 3.0f);
+  }
+  bench.glitch(0);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_LT(std::abs(bench.tick()), 3.0f);
+  }
+  EXPECT_FALSE(bench.estimator.failed());
+  bench.diagnosis->inspect();  // polled by the main loop
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Normal);
+}
+
+TEST(FallbackElecAngleEstimator, failOver) {
+  Bench bench;
+  float worst = 0.0f;
+
+  for (int i = 0; i < 4000; i++) {
+    bench.tick();
+  }
+
+  // encoder slipped by a quarter turn and stays there
+  bench.glitch(kCountPerRound / kPolePair / 4);
+  for (int i = 0; i < 20; i++) {
+    worst = std::max(worst, std::abs(bench.tick()));
+  }
+  EXPECT_TRUE(bench.estimator.failed());
+  bench.diagnosis->inspect();  // polled by the main loop
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Error);
+
+  // the observer keeps the current loop running
+  for (int i = 0; i < 4000; i++) {
+    worst = std::max(worst, std::abs(bench.tick()));
+  }
+  EXPECT_LT(worst, 3.0f);
+
+  // a new enable trusts the encoder again
+  bench.glitch(0);
+  bench.estimator.disable();
+  bench.estimator.enable();
+  EXPECT_FALSE(bench.estimator.failed());
+  bench.diagnosis->inspect();  // polled by the main loop
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Normal);
+}
+
+TEST(FallbackElecAngleEstimator, mechFailOver) {
+  Bench bench;
+  float angle, travel = 0.0f;
+
+  // 1500 RPM, 9000 mechanical degree per second
+  for (int i = 0; i < 4000; i++) {
+    bench.tick();
+  }
+  bench.mech.enable();
+  angle = bench.mech.getMechanicalAngle();
+  for (int i = 0; i < 2000; i++) {
+    bench.tick();
+    travel += coriander::base::math::wrapd180(
+        bench.mech.getMechanicalAngle() - angle);
+    angle = bench.mech.getMechanicalAngle();
+  }
+  EXPECT_NEAR(travel / (2000 * kTickUs * 1e-6f), 9000.0f, 50.0f);
+  EXPECT_FALSE(bench.mech.lost());
+
+  // the encoder stops counting, the angle goes on at the observer speed
+  bench.stall();
+  for (int i = 0; i < 40; i++) {
+    bench.tick();
+  }
+  ASSERT_TRUE(bench.estimator.failed());
+  EXPECT_TRUE(bench.mech.lost());
+  travel = 0.0f;
+  angle = bench.mech.getMechanicalAngle();
+  for (int i = 0; i < 2000; i++) {
+    bench.tick();
+    travel += bench.mech.getMechanicalAngle() - angle;
+    angle = bench.mech.getMechanicalAngle();
+  }
+  EXPECT_NEAR(travel / (2000 * kTickUs * 1e-6f), 9000.0f, 50.0f);
+}
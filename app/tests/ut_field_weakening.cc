@@ -0,0 +1,69 @@
+/**
+ * @file ut_field_weakening.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-25
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/field_weakening.h"
+
+using coriander::motorctl::FieldWeakening;
+
+TEST(FieldWeakening, disabled) {
+  FieldWeakening fw;
+  fw.setGains(1.0f, 100.0f);
+  fw.setLimits(0.9f, 0.0f);
+  EXPECT_FALSE(fw.enabled());
+  EXPECT_EQ(fw(1.0f, 1e-3f), 0.0f);
+}
+
+TEST(FieldWeakening, voltageFeedback) {
+  const float Ts = 1e-3f;
+  FieldWeakening fw;
+  fw.setGains(0.0f, 100.0f);
+  fw.setLimits(0.9f, 5.0f);
+
+  // headroom, no weakening
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(fw(0.5f, Ts), 0.0f);
+  }
+
+  // saturated, Id goes negative and stops at the limit
+  float id = 0;
+  for (int i = 0; i < 1000; i++) {
+    float next = fw(1.0f, Ts);
+    EXPECT_LE(next, id);
+    id = next;
+  }
+  EXPECT_FLOAT_EQ(id, -5.0f);
+
+  // back below the threshold, Id recovers to zero
+  for (int i = 0; i < 1000; i++) {
+    id = fw(0.5f, Ts);
+  }
+  EXPECT_EQ(id, 0.0f);
+}
+
+// back-emf plant: |Udq| grows with speed and shrinks with -Id, the loop
+// settles at the threshold
+TEST(FieldWeakening, settle) {
+  const float Ts = 1e-3f, speed = 1.3f, Ld = 0.1f;
+  FieldWeakening fw;
+  fw.setGains(0.05f, 20.0f);
+  fw.setLimits(0.95f, 5.0f);
+
+  float id = 0, m = 0;
+  for (int i = 0; i < 5000; i++) {
+    m = std::fabs(speed * (1.0f + Ld * id));
+    id = fw(m, Ts);
+  }
+  EXPECT_NEAR(m, 0.95f, 1e-3);
+  EXPECT_LT(id, 0.0f);
+  EXPECT_GT(id, -5.0f);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file ut_fixed_point.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-16
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/base/fixed_point.h"
+#include "coriander/motorctl/foc.h"
+#include "coriander/motorctl/low_pass_filter.h"
+#include "coriander/motorctl/pid.h"
+
+namespace {
+using coriander::base::FloatNumeric;
+using coriander::base::Q15;
+using coriander::base::Q15Numeric;
+using coriander::base::Q16;
+using coriander::base::Q31;
+using coriander::base::Q31Numeric;
+namespace foc = coriander::motorctl::foc;
+namespace motorctl = coriander::motorctl;
+
+constexpr float pi = 3.14159265358979f;
+
+/**
+ * @brief current loop datapath: clarke -> park -> invPark -> svpwm
+ */
+template <typename N>
+static void pipeline(float ia, float ib, float theta, float* du, float* dv,
+                     float* dw) {
+  using V = foc::Value<N>;
+  V alpha, beta, d, q, u, v, w;
+  V s = V(std::sin(theta)), c = V(std::cos(theta));
+  foc::clarke<N>(V(ia), V(ib), V(-ia - ib), &alpha, &beta);
+  foc::park<N>(alpha, beta, s, c, &d, &q);
+  foc::invPark<N>(d, q, s, c, &alpha, &beta);
+  foc::SpaceVectorPwm<N>(alpha, beta, &u, &v, &w);
+  *du = static_cast<float>(u);
+  *dv = static_cast<float>(v);
+  *dw = static_cast<float>(w);
+}
+
+/**
+ * @brief max error of the pipeline against float over the unit circle
+ */
+template <typename N>
+static float pipeline_error(float magnitude) {
+  float err = 0;
+  for (int i = 0; i < 360; i++) {
+    float phase = i * pi / 180;
+    float theta = i * 7 * pi / 180;
+    float ia = magnitude * std::cos(phase);
+    float ib = magnitude * std::cos(phase - 2 * pi / 3);
+    float fu, fv, fw, xu, xv, xw;
+    pipeline<FloatNumeric>(ia, ib, theta, &fu, &fv, &fw);
+    pipeline<N>(ia, ib, theta, &xu, &xv, &xw);
+    err = std::max(err, std::fabs(fu - xu));
+    err = std::max(err, std::fabs(fv - xv));
+    err = std::max(err, std::fabs(fw - xw));
+  }
+  return err;
+}
+
+/**
+ * @brief max error of a pi loop driving a first order plant
+ */
+template <typename N>
+static float pid_error() {
+  using V = typename N::Value;
+  using G = typename N::Gain;
+  // Ts = 1/4096s is exact in Q16
+  const float Ts = 1.0f / 4096;
+  motorctl::Pid ref(0.5f, 50.0f, 0.0f, 100.0f, 0.9f);
+  motorctl::detail::Pid<N> pid(G(0.5f), G(50.0f), G(0.0f), G(100.0f),
+                               V(0.9f));
+  motorctl::LowPassFilter refPlant(0.01f);
+  motorctl::detail::LowPassFilter<N> plant(G(0.01f));
+  float err = 0, yRef = 0, y = 0;
+  for (int i = 0; i < 4096; i++) {
+    float target = i < 2048 ? 0.5f : -0.3f;
+    yRef = refPlant(ref(target - yRef, Ts), Ts);
+    y = static_cast<float>(plant(pid(V(target) - V(y), G(Ts)), G(Ts)));
+    err = std::max(err, std::fabs(y - yRef));
+  }
+  return err;
+}
+}  // namespace
+
+TEST(FixedPoint, conversion) {
+  EXPECT_EQ(Q15(0.5f).raw, 1 << 14);
+  EXPECT_EQ(Q15(-1.0f).raw, -32768);
+  EXPECT_EQ(Q31(0.25f).raw, 1 << 29);
+  EXPECT_EQ(Q16(-2.5f).raw, -(5 << 15));
+  EXPECT_FLOAT_EQ(static_cast<float>(Q16(Q15(0.5f))), 0.5f);
+  EXPECT_NEAR(static_cast<float>(Q15(Q31(0.123456f))), 0.123456f,
+              1.0f / 32768);
+}
+
+TEST(FixedPoint, saturation) {
+  EXPECT_EQ(Q15(1.0f), Q15::max());
+  EXPECT_EQ(Q15(-2.0f), Q15::min());
+  EXPECT_EQ(Q15(0.75f) + Q15(0.75f), Q15::max());
+  EXPECT_EQ(Q15(-0.75f) - Q15(0.75f), Q15::min());
+  EXPECT_EQ(-Q15::min(), Q15::max());
+  EXPECT_EQ(Q31(-1.0f) * Q31(-1.0f), Q31::max());
+  EXPECT_EQ(Q15(0.5f) * Q16(4.0f), Q15::max());
+  EXPECT_EQ(Q15(0.5f) / Q16(0.0f), Q15::max());
+  EXPECT_EQ(Q15(0.5f) / Q16(0.25f), Q15::max());
+  EXPECT_EQ(Q15(Q16(3.0f)), Q15::max());
+}
+
+TEST(FixedPoint, arithmetic) {
+  EXPECT_NEAR(static_cast<float>(Q15(0.3f) * Q15(-0.6f)), -0.18f, 1e-4);
+  EXPECT_NEAR(static_cast<float>(Q31(0.3f) * Q31(-0.6f)), -0.18f, 1e-7);
+  EXPECT_NEAR(static_cast<float>(Q31(0.3f) * Q16(2.5f)), 0.75f, 1e-7);
+  EXPECT_NEAR(static_cast<float>(Q15(0.3f) / Q16(2.0f)), 0.15f, 1e-4);
+  EXPECT_NEAR(static_cast<float>(Q16(100.0f) / Q16(3.0f)), 33.3333f, 1e-4);
+  EXPECT_TRUE(Q15(0.1f) < Q15(0.2f));
+  EXPECT_TRUE(Q15(-0.1f) > Q15(-0.2f));
+}
+
+TEST(FixedPoint, sqrt) {
+  for (float x = 0.0f; x < 2.0f; x += 0.01f) {
+    // reference on the quantized input, error is within 1 LSB
+    float ref = std::sqrt(static_cast<float>(Q16(x)));
+    EXPECT_NEAR(static_cast<float>(sqrt(Q16(x))), ref, 1.6e-5)
+        << "x: " << x;
+  }
+  for (float x = 0.0f; x < 1.0f; x += 0.01f) {
+    float ref = std::sqrt(static_cast<float>(Q31(x)));
+    EXPECT_NEAR(static_cast<float>(sqrt(Q31(x))), ref, 1e-7)
+        << "x: " << x;
+  }
+  EXPECT_EQ(sqrt(Q15(-0.5f)), Q15());
+}
+
+TEST(FixedPoint, pipelineErrorBound) {
+  // including the saturated region, |u| > 1 after clarke
+  for (float magnitude : {0.1f, 0.5f, 0.85f, 1.0f}) {
+    float q15 = pipeline_error<Q15Numeric>(magnitude);
+    float q31 = pipeline_error<Q31Numeric>(magnitude);
+    EXPECT_LT(q15, 3e-4) << "magnitude: " << magnitude;
+    EXPECT_LT(q31, 2e-6) << "magnitude: " << magnitude;
+  }
+}
+
+TEST(FixedPoint, pidErrorBound) {
+  // gains are Q16 for both policies, I*Ts rounding dominates
+  EXPECT_LT(pid_error<Q15Numeric>(), 3e-3);
+  EXPECT_LT(pid_error<Q31Numeric>(), 2e-3);
+}
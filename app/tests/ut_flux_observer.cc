@@ -0,0 +1,70 @@
+/**
+ * @file ut_flux_observer.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-30
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/flux_observer.h"
+#include "tests/pmsm_model.h"
+
+using coriander::motorctl::FluxObserver;
+using testing::sim::PmsmModel;
+
+namespace {
+constexpr float Ts = 50e-6f;
+
+float angleError(float a, float b) {
+  float d = std::remainder(a - b, 360.0f);
+  return std::fabs(d);
+}
+}  // namespace
+
+TEST(FluxObserver, converge) {
+  for (double speed : {2 * M_PI * 100, -2 * M_PI * 100, 2 * M_PI * 50}) {
+    PmsmModel motor;
+    FluxObserver observer;
+    float valpha, vbeta;
+
+    // 10% off on R and L
+    observer.setup(motor.R * 1.1, motor.L * 0.9, motor.flux, 100.0f, 300.0f);
+    observer.reset(90.0f);
+    motor.omega = speed;
+
+    float worst = 0;
+    valpha = vbeta = 0.0f;
+    for (int i = 0; i < 8000; i++) {
+      // current sampled now, voltage of the last period
+      observer(valpha, vbeta, motor.ialpha, motor.ibeta, Ts);
+      if (i > 4000) {
+        worst = std::max(worst, angleError(observer.getAngle(), motor.angle()));
+      }
+      motor.feedForward(0.0, 5.0, motor.angle(), &valpha, &vbeta);
+      motor.step(valpha, vbeta, Ts);
+    }
+
+    EXPECT_LT(worst, 3.0f) << "speed: " << speed;
+    EXPECT_NEAR(observer.getVelocity(), speed * 180 / M_PI,
+                std::fabs(speed * 180 / M_PI) * 0.01f);
+    EXPECT_TRUE(observer.converged(360.0f * 5));
+  }
+}
+
+TEST(FluxObserver, standstill) {
+  PmsmModel motor;
+  FluxObserver observer;
+  observer.setup(motor.R * 1.1, motor.L * 0.9, motor.flux, 100.0f, 300.0f);
+
+  // no back-EMF, nothing to lock on
+  for (int i = 0; i < 2000; i++) {
+    observer(motor.R * 2.0f, 0.0f, motor.ialpha, motor.ibeta, Ts);
+    motor.step(motor.R * 2.0f, 0.0f, Ts);
+  }
+  EXPECT_FALSE(observer.converged(360.0f * 5));
+}
@@ -0,0 +1,323 @@
+/**
+ * @file ut_foc.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-14
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/foc.h"
+
+namespace foc = coriander::motorctl::foc;
+
+TEST(Foc, svpwmFastKeyPoint) {
+  // expected data is generate by python script, run app/tests/svpwm_emulator.py
+  // to generate. same key points as ut_foc_motor_driver.cc
+  const float i[] = {0.8750000000, 0.9068988407, 0.9264342660, 0.9330127019,
+                     0.9264342660, 0.9068988407, 0.8750000000, 0.7565151075,
+                     0.6302361333, 0.5000000000, 0.3697638667, 0.2434848925,
+                     0.1250000000, 0.0931011593, 0.0735657340, 0.0669872981,
+                     0.0735657340, 0.0931011593, 0.1250000000, 0.0931011593,
+                     0.0735657340, 0.0669872981, 0.0735657340, 0.0931011593,
+                     0.1250000000, 0.2434848925, 0.3697638667, 0.5000000000,
+                     0.6302361333, 0.7565151075, 0.8750000000, 0.9068988407,
+                     0.9264342660, 0.9330127019, 0.9264342660, 0.9068988407};
+  const float j[] = {0.1250000000, 0.2434848925, 0.3697638667, 0.5000000000,
+                     0.6302361333, 0.7565151075, 0.8750000000, 0.9068988407,
+                     0.9264342660, 0.9330127019, 0.9264342660, 0.9068988407,
+                     0.8750000000, 0.9068988407, 0.9264342660, 0.9330127019,
+                     0.9264342660, 0.9068988407, 0.8750000000, 0.7565151075,
+                     0.6302361333, 0.5000000000, 0.3697638667, 0.2434848925,
+                     0.1250000000, 0.0931011593, 0.0735657340, 0.0669872981,
+                     0.0735657340, 0.0931011593, 0.1250000000, 0.0931011593,
+                     0.0735657340, 0.0669872981, 0.0735657340, 0.0931011593};
+  const float k[] = {0.1250000000, 0.0931011593, 0.0735657340, 0.0669872981,
+                     0.0735657340, 0.0931011593, 0.1250000000, 0.0931011593,
+                     0.0735657340, 0.0669872981, 0.0735657340, 0.0931011593,
+                     0.1250000000, 0.2434848925, 0.3697638667, 0.5000000000,
+                     0.6302361333, 0.7565151075, 0.8750000000, 0.9068988407,
+                     0.9264342660, 0.9330127019, 0.9264342660, 0.9068988407,
+                     0.8750000000, 0.9068988407, 0.9264342660, 0.9330127019,
+                     0.9264342660, 0.9068988407, 0.8750000000, 0.7565151075,
+                     0.6302361333, 0.5000000000, 0.3697638667, 0.2434848925};
+
+  for (int idx = 0; idx < 36; idx++) {
+    float angle = idx * 3.14159265358979f / 18;
+    float tu, tv, tw;
+    foc::detail::svpwm_fast(std::cos(angle), std::sin(angle), 1, 1, &tu, &tv,
+                            &tw);
+    EXPECT_NEAR(tu, i[idx], 1e-5) << "idx: " << idx;
+    EXPECT_NEAR(tv, j[idx], 1e-5) << "idx: " << idx;
+    EXPECT_NEAR(tw, k[idx], 1e-5) << "idx: " << idx;
+  }
+}
+
+TEST(Foc, svpwmFastDenseGrid) {
+  // alpha/beta in [-1.5, 1.5], covers the saturated region |u| > Udc
+  const int steps = 301;
+  const float Ts = 1.0f, Udc = 1.0f;
+  for (int x = 0; x < steps; x++) {
+    for (int y = 0; y < steps; y++) {
+      float alpha = -1.5f + 3.0f * x / (steps - 1);
+      float beta = -1.5f + 3.0f * y / (steps - 1);
+      float su, sv, sw, fu, fv, fw;
+      foc::detail::svpwm_slow(alpha, beta, Ts, Udc, &su, &sv, &sw);
+      foc::detail::svpwm_fast(alpha, beta, Ts, Udc, &fu, &fv, &fw);
+      ASSERT_NEAR(fu, su, 1e-5) << "alpha: " << alpha << " beta: " << beta;
+      ASSERT_NEAR(fv, sv, 1e-5) << "alpha: " << alpha << " beta: " << beta;
+      ASSERT_NEAR(fw, sw, 1e-5) << "alpha: " << alpha << " beta: " << beta;
+    }
+  }
+}
+
+TEST(Foc, svpwmFastScaled) {
+  // non-normalized period and bus voltage, e.g. 24V bus and 4200 ticks
+  const float Ts = 4200.0f, Udc = 24.0f;
+  for (int idx = 0; idx < 360; idx++) {
+    float angle = idx * 3.14159265358979f / 180;
+    float su, sv, sw, fu, fv, fw;
+    foc::detail::svpwm_slow(12.0f * std::cos(angle), 12.0f * std::sin(angle),
+                            Ts, Udc, &su, &sv, &sw);
+    foc::detail::svpwm_fast(12.0f * std::cos(angle), 12.0f * std::sin(angle),
+                            Ts, Udc, &fu, &fv, &fw);
+    EXPECT_NEAR(fu, su, Ts * 1e-5) << "idx: " << idx;
+    EXPECT_NEAR(fv, sv, Ts * 1e-5) << "idx: " << idx;
+    EXPECT_NEAR(fw, sw, Ts * 1e-5) << "idx: " << idx;
+  }
+}
+
+TEST(Foc, svpwmSectorHexagon) {
+  // the kernel CONFIG_CORIANDER_SVPWM_SECTOR puts behind the modulation
+  // modes, up to the hexagon where the circle limit of svpwm_slow is gone
+  for (float magnitude : {0.5f, 1.1f, 1.3f, 1.5f}) {
+    for (int idx = 0; idx < 360; idx++) {
+      float angle = idx * 3.14159265358979f / 180;
+      float su, sv, sw, du, dv, dw;
+      float alpha = magnitude * std::cos(angle);
+      float beta = magnitude * std::sin(angle);
+      foc::SpaceVectorPwm(foc::Modulation::OverModulationI, alpha, beta, &du,
+                          &dv, &dw);
+      // same vector as clipped by the mode
+      float va = 2 * du - 1, vb = 2 * dv - 1, vc = 2 * dw - 1;
+      alpha = (2.0f / 3) * (va - 0.5f * vb - 0.5f * vc);
+      beta = (vb - vc) / std::sqrt(3.0f);
+      foc::detail::svpwm_sector(alpha, beta, 1, &su, &sv, &sw);
+      EXPECT_NEAR(du, su, 1e-5) << "m: " << magnitude << " idx: " << idx;
+      EXPECT_NEAR(dv, sv, 1e-5) << "m: " << magnitude << " idx: " << idx;
+      EXPECT_NEAR(dw, sw, 1e-5) << "m: " << magnitude << " idx: " << idx;
+    }
+  }
+}
+
+namespace {
+/**
+ * @brief voltage vector realized by duty cycles, common mode removed
+ */
+static void realized_vector(float du, float dv, float dw, float* alpha,
+                            float* beta) {
+  float va = 2 * du - 1, vb = 2 * dv - 1, vc = 2 * dw - 1;
+  *alpha = (2.0f / 3) * (va - 0.5f * vb - 0.5f * vc);
+  *beta = (vb - vc) / std::sqrt(3.0f);
+}
+
+/**
+ * @brief fundamental amplitude over one electrical turn
+ */
+static float fundamental(foc::Modulation mode, float magnitude) {
+  const int steps = 3600;
+  float sum = 0;
+  for (int idx = 0; idx < steps; idx++) {
+    float angle = idx * 2 * 3.14159265358979f / steps;
+    float du, dv, dw, alpha, beta;
+    foc::SpaceVectorPwm(mode, magnitude * std::cos(angle),
+                        magnitude * std::sin(angle), &du, &dv, &dw);
+    realized_vector(du, dv, dw, &alpha, &beta);
+    sum += alpha * std::cos(angle) + beta * std::sin(angle);
+  }
+  return sum / steps;
+}
+}  // namespace
+
+TEST(Foc, modulationLinear) {
+  using foc::Modulation;
+  for (int idx = 0; idx < 360; idx++) {
+    float angle = idx * 3.14159265358979f / 180;
+    float du, dv, dw, alpha, beta;
+    // same as SpaceVectorPwm inside the unit circle
+    float su, sv, sw;
+    foc::SpaceVectorPwm(0.9f * std::cos(angle), 0.9f * std::sin(angle), &su,
+                        &sv, &sw);
+    foc::SpaceVectorPwm(Modulation::Linear, 0.9f * std::cos(angle),
+                        0.9f * std::sin(angle), &du, &dv, &dw);
+    EXPECT_NEAR(du, su, 1e-6);
+    EXPECT_NEAR(dv, sv, 1e-6);
+    EXPECT_NEAR(dw, sw, 1e-6);
+
+    // limited to the inscribed circle, angle is kept
+    foc::SpaceVectorPwm(Modulation::Linear, 2 * std::cos(angle),
+                        2 * std::sin(angle), &du, &dv, &dw);
+    realized_vector(du, dv, dw, &alpha, &beta);
+    EXPECT_NEAR(std::hypot(alpha, beta), 1.1547005f, 1e-5) << "idx: " << idx;
+    EXPECT_NEAR(alpha * std::sin(angle) - beta * std::cos(angle), 0, 1e-5);
+  }
+}
+
+TEST(Foc, modulationHexagon) {
+  using foc::Modulation;
+  const float vertex = 4.0f / 3, apothem = 2.0f / std::sqrt(3.0f);
+  for (int idx = 0; idx < 360; idx++) {
+    float angle = idx * 3.14159265358979f / 180;
+    for (auto mode : {Modulation::Linear, Modulation::OverModulationI,
+                      Modulation::OverModulationII}) {
+      float du, dv, dw, alpha, beta;
+      foc::SpaceVectorPwm(mode, 3 * std::cos(angle), 3 * std::sin(angle), &du,
+                          &dv, &dw);
+      for (float d : {du, dv, dw}) {
+        EXPECT_GE(d, -1e-6f);
+        EXPECT_LE(d, 1 + 1e-6f);
+      }
+      realized_vector(du, dv, dw, &alpha, &beta);
+      float magnitude = std::hypot(alpha, beta);
+      EXPECT_GE(magnitude, apothem - 1e-5);
+      EXPECT_LE(magnitude, vertex + 1e-5);
+    }
+  }
+
+  // overmodulation I keeps the angle on the hexagon
+  float du, dv, dw, alpha, beta;
+  foc::SpaceVectorPwm(Modulation::OverModulationI, 1.25f, 0, &du, &dv, &dw);
+  realized_vector(du, dv, dw, &alpha, &beta);
+  EXPECT_NEAR(alpha, 1.25f, 1e-5);
+  EXPECT_NEAR(beta, 0, 1e-5);
+}
+
+TEST(Foc, modulationFundamental) {
+  using foc::Modulation;
+  const float six_step = 4 / 3.14159265358979f;
+  float linear = fundamental(Modulation::Linear, 2.0f);
+  float om1 = fundamental(Modulation::OverModulationI, 2.0f);
+  float om2 = fundamental(Modulation::OverModulationII, six_step);
+  EXPECT_NEAR(linear, 1.1547f, 1e-3);
+  EXPECT_NEAR(om1, 0.9517f * six_step, 5e-3);
+  EXPECT_NEAR(om2, six_step, 5e-3);
+
+  // fundamental grows with the reference in overmodulation II
+  float last = 0;
+  for (float magnitude = 1.0f; magnitude < 1.28f; magnitude += 0.02f) {
+    float f = fundamental(Modulation::OverModulationII, magnitude);
+    EXPECT_GT(f, last) << "magnitude: " << magnitude;
+    last = f;
+  }
+}
+
+TEST(Foc, limitVoltage) {
+  float d = 0.3f, q = 0.4f;
+  EXPECT_FALSE(foc::limitVoltage(&d, &q, 1.0f));
+  EXPECT_FLOAT_EQ(d, 0.3f);
+  EXPECT_FLOAT_EQ(q, 0.4f);
+
+  // d-axis first, q gets the rest of the circle
+  d = 0.6f, q = -2.0f;
+  EXPECT_TRUE(foc::limitVoltage(&d, &q, 1.0f));
+  EXPECT_FLOAT_EQ(d, 0.6f);
+  EXPECT_FLOAT_EQ(q, -0.8f);
+
+  d = -1.5f, q = 0.5f;
+  EXPECT_TRUE(foc::limitVoltage(&d, &q, 1.0f));
+  EXPECT_FLOAT_EQ(d, -1.0f);
+  EXPECT_FLOAT_EQ(q, 0.0f);
+}
+
+TEST(Foc, compensateDeadTime) {
+  const float deadTime = 0.02f, band = 0.1f;
+  float du, dv, dw;
+
+  // phase u sources 1A, v and w sink 0.5A, fully compensated
+  du = dv = dw = 0.5f;
+  foc::compensateDeadTime(1.0f, 0, deadTime, band, &du, &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 0.5f + deadTime);
+  EXPECT_FLOAT_EQ(dv, 0.5f - deadTime);
+  EXPECT_FLOAT_EQ(dw, 0.5f - deadTime);
+
+  // linear inside the band, smooth around zero crossing
+  du = dv = dw = 0.5f;
+  foc::compensateDeadTime(0.05f, 0, deadTime, band, &du, &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 0.5f + deadTime * 0.5f);
+  EXPECT_FLOAT_EQ(dv, 0.5f - deadTime * 0.25f);
+  EXPECT_FLOAT_EQ(dw, 0.5f - deadTime * 0.25f);
+
+  du = dv = dw = 0.5f;
+  foc::compensateDeadTime(0, 0, deadTime, band, &du, &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 0.5f);
+  EXPECT_FLOAT_EQ(dv, 0.5f);
+  EXPECT_FLOAT_EQ(dw, 0.5f);
+
+  // duty cycles stay inside [0, 1]
+  du = 0.99f, dv = 0.01f, dw = 0.5f;
+  foc::compensateDeadTime(0, 1.0f, deadTime, band, &du, &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 0.99f);
+  EXPECT_FLOAT_EQ(dv, 0.01f + deadTime);
+  EXPECT_FLOAT_EQ(dw, 0.5f - deadTime);
+  du = 0.99f, dv = 0.01f;
+  foc::compensateDeadTime(1.0f, -1.0f, deadTime, band, &du, &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 1.0f);
+
+  // discontinuous pwm clamps a phase, it does not switch, so it stays
+  du = 0.0f, dv = 1.0f - 1e-7f, dw = 0.5f;
+  foc::compensateDeadTime(1.0f, -1.0f, deadTime, band, &du, &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 0.0f);
+  EXPECT_FLOAT_EQ(dv, 1.0f - 1e-7f);
+  EXPECT_GT(dw, 0.5f);
+}
+
+TEST(Foc, discontinuousPwm) {
+  using foc::Modulation;
+  using foc::PwmMode;
+  for (auto pwm : {PwmMode::DpwmMin, PwmMode::DpwmMax, PwmMode::Dpwm60,
+                   PwmMode::Dpwm30}) {
+    int clamped[3] = {0, 0, 0};
+    for (int idx = 0; idx < 360; idx++) {
+      float angle = (idx + 0.5f) * 3.14159265358979f / 180;
+      float alpha = 0.9f * std::cos(angle), beta = 0.9f * std::sin(angle);
+      float d[3], c[3];
+      foc::SpaceVectorPwm(Modulation::Linear, pwm, alpha, beta, &d[0], &d[1],
+                          &d[2]);
+      foc::SpaceVectorPwm(Modulation::Linear, alpha, beta, &c[0], &c[1],
+                          &c[2]);
+
+      // same line voltages, only the common mode moves
+      EXPECT_NEAR(d[0] - d[1], c[0] - c[1], 1e-5) << "idx: " << idx;
+      EXPECT_NEAR(d[1] - d[2], c[1] - c[2], 1e-5) << "idx: " << idx;
+
+      // exactly one phase on a rail
+      int rails = 0;
+      for (int i = 0; i < 3; i++) {
+        EXPECT_GE(d[i], -1e-6f);
+        EXPECT_LE(d[i], 1 + 1e-6f);
+        if (d[i] < 1e-6f || d[i] > 1 - 1e-6f) {
+          rails++;
+          clamped[i]++;
+        }
+      }
+      EXPECT_EQ(rails, 1) << "idx: " << idx;
+    }
+    // every phase rests a third of the turn
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(clamped[i], 120) << "mode: " << static_cast<int>(pwm);
+    }
+  }
+
+  // dpwm60 clamps the phase at its peak, dpwm30 the one away from it
+  float du, dv, dw;
+  foc::SpaceVectorPwm(Modulation::Linear, PwmMode::Dpwm60, 0.9f, 0.05f, &du,
+                      &dv, &dw);
+  EXPECT_FLOAT_EQ(du, 1.0f);
+  foc::SpaceVectorPwm(Modulation::Linear, PwmMode::Dpwm30, 0.9f, 0.05f, &du,
+                      &dv, &dw);
+  EXPECT_FLOAT_EQ(dw, 0.0f);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ut_foc_batch.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-20
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+
+#include "coriander/motorctl/foc.h"
+#include "coriander/motorctl/foc_batch.h"
+#include "tests/foc_batch_fixture.h"
+
+namespace {
+namespace foc = coriander::motorctl::foc;
+namespace batch = coriander::motorctl::foc::batch;
+using testing::foc_batch::BatchAxes;
+using testing::foc_batch::maxAxes;
+using testing::foc_batch::random_float;
+using testing::foc_batch::random_sample;
+using testing::foc_batch::Sample;
+using testing::foc_batch::ScalarAxes;
+}  // namespace
+
+TEST(FocBatch, transforms) {
+  float a[maxAxes], b[maxAxes], s[maxAxes], c[maxAxes];
+  float x[maxAxes], y[maxAxes], u[maxAxes], v[maxAxes], w[maxAxes];
+
+  std::srand(1);
+  for (int n = 1; n <= maxAxes; n++) {
+    for (int i = 0; i < n; i++) {
+      float angle = random_float(3.14159265358979f);
+      a[i] = random_float(1.5f);
+      b[i] = random_float(1.5f);
+      s[i] = std::sin(angle);
+      c[i] = std::cos(angle);
+    }
+
+    batch::clarke(a, b, x, y, n);
+    for (int i = 0; i < n; i++) {
+      float alpha, beta;
+      foc::clarke(a[i], b[i], -a[i] - b[i], &alpha, &beta);
+      EXPECT_NEAR(x[i], alpha, 1e-6) << "n: " << n << " axis: " << i;
+      EXPECT_NEAR(y[i], beta, 1e-6) << "n: " << n << " axis: " << i;
+    }
+
+    batch::park(a, b, s, c, x, y, n);
+    for (int i = 0; i < n; i++) {
+      float d, q;
+      foc::park(a[i], b[i], s[i], c[i], &d, &q);
+      EXPECT_NEAR(x[i], d, 1e-6) << "n: " << n << " axis: " << i;
+      EXPECT_NEAR(y[i], q, 1e-6) << "n: " << n << " axis: " << i;
+    }
+
+    batch::invPark(a, b, s, c, x, y, n);
+    for (int i = 0; i < n; i++) {
+      float alpha, beta;
+      foc::invPark(a[i], b[i], s[i], c[i], &alpha, &beta);
+      EXPECT_NEAR(x[i], alpha, 1e-6) << "n: " << n << " axis: " << i;
+      EXPECT_NEAR(y[i], beta, 1e-6) << "n: " << n << " axis: " << i;
+    }
+
+    // inputs up to 1.5, covers the circle limit
+    batch::SpaceVectorPwm(a, b, u, v, w, n);
+    for (int i = 0; i < n; i++) {
+      float du, dv, dw;
+      foc::detail::svpwm_fast(a[i], b[i], 1, 1, &du, &dv, &dw);
+      EXPECT_NEAR(u[i], du, 1e-6) << "n: " << n << " axis: " << i;
+      EXPECT_NEAR(v[i], dv, 1e-6) << "n: " << n << " axis: " << i;
+      EXPECT_NEAR(w[i], dw, 1e-6) << "n: " << n << " axis: " << i;
+    }
+  }
+}
+
+TEST(FocBatch, sameAsScalar) {
+  const float Ts = 1e-4f;
+  Sample sample;
+
+  std::srand(2);
+  for (int n = 1; n <= maxAxes; n++) {
+    ScalarAxes scalar(n);
+    BatchAxes batched(n);
+    for (int tick = 0; tick < 200; tick++) {
+      random_sample(&sample);
+      scalar(sample.alpha, sample.beta, sample.s, sample.c, sample.targetD,
+             sample.targetQ, Ts);
+      batched(sample.alpha, sample.beta, sample.s, sample.c, sample.targetD,
+              sample.targetQ, Ts);
+      for (int i = 0; i < n; i++) {
+        ASSERT_NEAR(batched.du[i], scalar.du[i], 1e-5)
+            << "n: " << n << " tick: " << tick << " axis: " << i;
+        ASSERT_NEAR(batched.dv[i], scalar.dv[i], 1e-5)
+            << "n: " << n << " tick: " << tick << " axis: " << i;
+        ASSERT_NEAR(batched.dw[i], scalar.dw[i], 1e-5)
+            << "n: " << n << " tick: " << tick << " axis: " << i;
+      }
+    }
+  }
+}
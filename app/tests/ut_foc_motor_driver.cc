@@ -174,3 +174,76 @@ idx: 35, angle: 350, alpha: 0.98, beta: -0.17, i: 0.9068988407, j: 0.0931011593,
     t->setVoltage(1.0f, 0);
   }
 }
+
+TEST(FocMotorDriver, busVoltage) {
+  using coriander::motorctl::foc::Modulation;
+  using coriander::motorctl::foc::PwmMode;
+  using coriander::motorctl::foc::SpaceVectorPwm;
+  auto c = createInjector();
+  auto t = c.create<std::shared_ptr<MockFocMotor>>();
+  float vu, vv, vw, alpha, beta;
+  auto expect = [&t, &vu, &vv, &vw]() {
+    t->expected_u = static_cast<uint16_t>(vu * UINT16_MAX);
+    t->expected_v = static_cast<uint16_t>(vv * UINT16_MAX);
+    t->expected_w = static_cast<uint16_t>(vw * UINT16_MAX);
+  };
+
+  // doubled bus, half of the duty
+  t->setSupplyVoltage(24.0f);
+  t->setBusVoltage(48.0f);
+  SpaceVectorPwm(Modulation::Linear, PwmMode::Continuous, 0.4f, 0.2f, &vu,
+                 &vv, &vw);
+  expect();
+  t->setVoltageNoSensor(0.8f, 0.4f, 0.0f);
+
+  // observers see the voltage in units of the supply
+  t->getVoltage(&alpha, &beta);
+  EXPECT_NEAR(alpha, 0.8f, 1e-3f);
+  EXPECT_NEAR(beta, 0.4f, 1e-3f);
+
+  // collapsing bus, at most twice the duty
+  t->setBusVoltage(6.0f);
+  expect();
+  t->setVoltageNoSensor(0.2f, 0.1f, 0.0f);
+
+  // no measurement
+  t->setBusVoltage(0.0f);
+  expect();
+  t->setVoltageNoSensor(0.4f, 0.2f, 0.0f);
+}
+
+TEST(FocMotorDriver, deadTimeFreshCurrent) {
+  using coriander::motorctl::foc::compensateDeadTime;
+  using coriander::motorctl::foc::Modulation;
+  using coriander::motorctl::foc::PwmMode;
+  using coriander::motorctl::foc::SpaceVectorPwm;
+  auto c = createInjector();
+  auto t = c.create<std::shared_ptr<MockFocMotor>>();
+  float vu, vv, vw;
+  auto expect = [&t, &vu, &vv, &vw]() {
+    t->expected_u = static_cast<uint16_t>(vu * UINT16_MAX);
+    t->expected_v = static_cast<uint16_t>(vv * UINT16_MAX);
+    t->expected_w = static_cast<uint16_t>(vw * UINT16_MAX);
+  };
+
+  // compensated on the current of this period, the band is per phase
+  t->setDeadTime(0.02f, 0.1f);
+  t->setPhaseCurrent(1.5f, 0.0f);
+  SpaceVectorPwm(Modulation::Linear, PwmMode::Continuous, 0.2f, 0.1f, &vu,
+                 &vv, &vw);
+  compensateDeadTime(1.0f, 0.0f, 0.02f, 0.1f, &vu, &vv, &vw);
+  expect();
+  t->setVoltageNoSensor(0.2f, 0.1f, 0.0f);
+
+  // no current since, as the open loop drives
+  SpaceVectorPwm(Modulation::Linear, PwmMode::Continuous, 0.2f, 0.1f, &vu,
+                 &vv, &vw);
+  expect();
+  t->setVoltageNoSensor(0.2f, 0.1f, 0.0f);
+
+  // dropped on mode change
+  t->setPhaseCurrent(1.5f, 0.0f);
+  t->resetPhaseCurrent();
+  expect();
+  t->setVoltageNoSensor(0.2f, 0.1f, 0.0f);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file ut_gain_schedule.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-27
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "coriander/motorctl/gain_schedule.h"
+
+using coriander::motorctl::GainSchedule;
+
+TEST(GainSchedule, empty) {
+  GainSchedule schedule;
+  float P, I;
+  schedule(100.0f, &P, &I);
+  EXPECT_EQ(P, 1.0f);
+  EXPECT_EQ(I, 1.0f);
+}
+
+TEST(GainSchedule, interpolate) {
+  GainSchedule schedule;
+  const GainSchedule::Point points[] = {
+      {0.0f, 2.0f, 4.0f},
+      {100.0f, 1.0f, 1.0f},
+      {1000.0f, 0.5f, 1.0f},
+      {0.0f, 9.0f, 9.0f},  // not increasing, ends the table
+  };
+  float P, I;
+
+  schedule.setup(points, 4);
+  EXPECT_EQ(schedule.size(), 3);
+
+  schedule(50.0f, &P, &I);
+  EXPECT_FLOAT_EQ(P, 1.5f);
+  EXPECT_FLOAT_EQ(I, 2.5f);
+
+  // |x|, and the segment cache works in both directions
+  schedule(-550.0f, &P, &I);
+  EXPECT_FLOAT_EQ(P, 0.75f);
+  EXPECT_FLOAT_EQ(I, 1.0f);
+  schedule(10.0f, &P, &I);
+  EXPECT_FLOAT_EQ(P, 1.9f);
+  EXPECT_FLOAT_EQ(I, 3.7f);
+
+  // held outside the table
+  schedule(5000.0f, &P, &I);
+  EXPECT_FLOAT_EQ(P, 0.5f);
+  EXPECT_FLOAT_EQ(I, 1.0f);
+}
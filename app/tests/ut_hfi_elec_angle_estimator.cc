@@ -0,0 +1,177 @@
+/**
+ * @file ut_hfi_elec_angle_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-02
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "coriander/base/math.h"
+#include "coriander/motorctl/hfi_elec_angle_estimator.h"
+#include "tests/mocks.h"
+#include "tests/pmsm_model.h"
+
+namespace {
+using Property = coriander::base::Property;
+using ParamId = coriander::base::ParamId;
+using Parameter = testing::mock::MockPersistentParameter;
+using coriander::motorctl::HfiElecAngleEstimator;
+using coriander::motorctl::SensorlessElecAngleEstimator;
+using testing::sim::SalientPmsmModel;
+
+constexpr int kPolePair = 4;
+constexpr uint32_t kTickUs = 50;  // 20kHz current loop
+constexpr float kSupplyVoltage = 24.0f;
+constexpr float kBlendSpeed = 100.0f;  // RPM, 6.7Hz electrical
+
+struct DummyPhaseCurrentEstimator
+    : public coriander::motorctl::IPhaseCurrentEstimator {
+  virtual void enable() { mEnabled = true; }
+  virtual void disable() { mEnabled = false; }
+  virtual bool enabled() { return mEnabled; }
+  virtual bool needCalibrate() { return false; }
+  virtual void calibrate() {}
+  virtual void sync() {}
+  // as the backend returns it, 3/2 of the model current
+  virtual void getPhaseCurrent(float* alpha, float* beta) {
+    *alpha = static_cast<float>(mModel->ialpha()) / kAmplitudeScale;
+    *beta = static_cast<float>(mModel->ibeta()) / kAmplitudeScale;
+  }
+
+  const SalientPmsmModel* mModel = nullptr;
+  bool mEnabled = false;
+};
+
+struct DummySystick : public coriander::os::ISystick {
+  virtual uint32_t systick_ms() { return us / 1000; }
+  virtual uint32_t systick_us() { return us; }
+  uint32_t us = 0;
+};
+
+/**
+ * @brief motor turned by a stiff load, current loop replaced by the back-EMF
+ *        feed-forward on the estimated angle, as FocMotorDriver adds the
+ *        injection
+ */
+struct Bench {
+  explicit Bench(float angle) {
+    model.theta = angle * M_PI / 180;
+    phaseCurrent->mModel = &model;
+
+    param->add(Property{kPolePair, ParamId::MotorCtl_MotorDriver_PolePair});
+    param->add(Property{kSupplyVoltage,
+                        ParamId::MotorCtl_MotorDriver_SupplyVoltage});
+    param->add(Property{static_cast<float>(model.R),
+                        ParamId::MotorCtl_MotorDriver_Rs});
+    param->add(Property{static_cast<float>(model.Ld),
+                        ParamId::MotorCtl_MotorDriver_Ld});
+    param->add(Property{static_cast<float>(model.Lq),
+                        ParamId::MotorCtl_MotorDriver_Lq});
+    param->add(Property{static_cast<float>(model.flux),
+                        ParamId::MotorCtl_MotorDriver_FluxLinkage});
+    param->add(Property{100.0f, ParamId::MotorCtl_Sensorless_ObserverGain});
+    param->add(Property{300.0f, ParamId::MotorCtl_Sensorless_PllBandwidth});
+    param->add(Property{200.0f, ParamId::MotorCtl_Sensorless_MinSpeed});
+    param->add(Property{2.0f, ParamId::MotorCtl_Hfi_Voltage});
+    param->add(Property{200.0f, ParamId::MotorCtl_Hfi_PllBandwidth});
+    param->add(Property{4.0f, ParamId::MotorCtl_Hfi_PulseVoltage});
+    param->add(Property{500, ParamId::MotorCtl_Hfi_PulseDuration});
+    param->add(Property{kBlendSpeed, ParamId::MotorCtl_Hfi_BlendSpeed});
+
+    estimator.enable();
+  }
+
+  /**
+   * @return float error of the reported angle, electrical degree
+   */
+  float tick() {
+    double vd, vq, rad, valpha, vbeta;
+    float amplitude, injection;
+
+    systick->us += kTickUs;
+    if (estimator.needSync(++mSyncId)) {
+      estimator.sync();
+    }
+
+    // the current loop keeps the bound free, the injection stays inside
+    amplitude = estimator.getInjectionAmplitude();
+    injection = estimator.nextInjection();
+    EXPECT_LE(std::abs(injection), amplitude * (1.0f + 1e-6f));
+    vd = injection * kSupplyVoltage * 0.5;
+    vq = model.omega * model.flux;
+    rad = estimator.getElectricalAngle() * M_PI / 180;
+    valpha = vd * std::cos(rad) - vq * std::sin(rad);
+    vbeta = vd * std::sin(rad) + vq * std::cos(rad);
+    estimator.setVoltage(valpha / (kSupplyVoltage * 0.5),
+                         vbeta / (kSupplyVoltage * 0.5));
+    model.step(valpha, vbeta, kTickUs * 1e-6);
+
+    return std::abs(coriander::base::math::wrapd180(
+        estimator.getElectricalAngle() - model.angle()));
+  }
+
+  SalientPmsmModel model;
+  std::shared_ptr<DummyPhaseCurrentEstimator> phaseCurrent =
+      std::make_shared<DummyPhaseCurrentEstimator>();
+  std::shared_ptr<DummySystick> systick = std::make_shared<DummySystick>();
+  std::shared_ptr<Parameter> param = std::make_shared<Parameter>();
+  std::shared_ptr<testing::mock::MockParamReqValidator> validator =
+      std::make_shared<testing::mock::MockParamReqValidator>();
+  HfiElecAngleEstimator estimator{
+      phaseCurrent,
+      std::make_shared<SensorlessElecAngleEstimator>(phaseCurrent, param,
+                                                     systick, validator),
+      param, systick, validator};
+
+ private:
+  unsigned mSyncId = 0;
+};
+}  // namespace
+
+TEST(HfiElecAngleEstimator, findAngleAtStandstill) {
+  for (float angle : {30.0f, 200.0f}) {
+    Bench bench(angle);
+
+    for (int i = 0; i < 4000 && !bench.estimator.ready(); i++) {
+      bench.tick();
+    }
+    ASSERT_TRUE(bench.estimator.ready());
+    EXPECT_LT(bench.tick(), 3.0f) << "angle: " << angle;
+  }
+}
+
+TEST(HfiElecAngleEstimator, handOverToBackEmf) {
+  // electrical rad/s, twice the blend speed is 13.3Hz
+  const double topSpeed = 2 * M_PI * 30;
+  const double blendSpeed = kBlendSpeed / 60 * kPolePair * 2 * M_PI;
+  Bench bench(120.0f);
+  float worst = 0.0f;
+  bool stopped = false;
+
+  for (int i = 0; i < 4000; i++) {
+    bench.tick();
+  }
+  ASSERT_TRUE(bench.estimator.ready());
+
+  // up to the top speed in 0.5s, hold, back down to standstill
+  for (int i = 0; i < 40000; i++) {
+    double t = i * kTickUs * 1e-6;
+    double ramp = t < 0.5 ? t / 0.5 : (t < 1.0 ? 1.0 : (1.5 - t) / 0.5);
+
+    bench.model.omega = topSpeed * (ramp > 0.0 ? ramp : 0.0);
+    worst = std::max(worst, bench.tick());
+    if (bench.model.omega > 2.2 * blendSpeed) {
+      stopped = stopped || !bench.estimator.injecting();
+    }
+  }
+  EXPECT_LT(worst, 3.0f);
+  EXPECT_TRUE(stopped);
+  // injecting again at standstill
+  EXPECT_TRUE(bench.estimator.injecting());
+}
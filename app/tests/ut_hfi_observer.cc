@@ -0,0 +1,108 @@
+/**
+ * @file ut_hfi_observer.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-02
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/hfi_observer.h"
+#include "tests/pmsm_model.h"
+
+using coriander::motorctl::HfiObserver;
+using testing::sim::SalientPmsmModel;
+
+namespace {
+constexpr float Ts = 50e-6f;
+
+float angleError(float a, float b) {
+  float d = std::remainder(a - b, 360.0f);
+  return std::fabs(d);
+}
+
+/**
+ * @brief apply the injection on the estimated d-axis for one period
+ */
+void tick(SalientPmsmModel* motor, HfiObserver* observer) {
+  double rad = observer->getAngle() * M_PI / 180.0;
+  double v = observer->getInjection();
+
+  motor->step(v * std::cos(rad), v * std::sin(rad), Ts);
+  (*observer)(static_cast<float>(motor->ialpha()),
+              static_cast<float>(motor->ibeta()), Ts);
+}
+}  // namespace
+
+TEST(HfiObserver, standstill) {
+  // both sides of every 90 degree, half of them lock 180 degree off
+  for (float angle = 10.0f; angle < 360.0f; angle += 45.0f) {
+    SalientPmsmModel motor;
+    HfiObserver observer;
+
+    // 10% off on the inductance
+    observer.setup(motor.Ld * 1.1, motor.Lq * 0.9, 2.0f, 200.0f, 4.0f,
+                   0.5e-3f);
+    motor.theta = angle * M_PI / 180.0;
+
+    for (int i = 0; i < 2000 && !observer.ready(); i++) {
+      tick(&motor, &observer);
+    }
+    ASSERT_TRUE(observer.ready()) << "angle: " << angle;
+    for (int i = 0; i < 200; i++) {
+      tick(&motor, &observer);
+    }
+    EXPECT_LT(angleError(observer.getAngle(), motor.angle()), 3.0f)
+        << "angle: " << angle;
+  }
+}
+
+TEST(HfiObserver, lowSpeed) {
+  SalientPmsmModel motor;
+  HfiObserver observer;
+  float worst = 0.0f;
+
+  observer.setup(motor.Ld, motor.Lq, 2.0f, 200.0f, 4.0f, 0.5e-3f);
+  motor.theta = 1.0;
+  for (int i = 0; i < 2000; i++) {
+    tick(&motor, &observer);
+  }
+  ASSERT_TRUE(observer.ready());
+
+  // 5Hz electrical, a ramp the loop follows without static error
+  motor.omega = 2 * M_PI * 5;
+  for (int i = 0; i < 20000; i++) {
+    tick(&motor, &observer);
+    if (i > 4000) {
+      worst = std::max(worst, angleError(observer.getAngle(), motor.angle()));
+    }
+  }
+  EXPECT_LT(worst, 3.0f);
+  EXPECT_NEAR(observer.getVelocity(), 360.0f * 5, 360.0f * 5 * 0.05f);
+}
+
+TEST(HfiObserver, trackAndResume) {
+  SalientPmsmModel motor;
+  HfiObserver observer;
+
+  observer.setup(motor.Ld, motor.Lq, 2.0f, 200.0f, 4.0f, 0.5e-3f);
+  observer.track(100.0f, 0.0f);
+  EXPECT_TRUE(observer.tracking());
+  EXPECT_TRUE(observer.ready());
+  EXPECT_FLOAT_EQ(observer.getInjection(), 0.0f);
+  EXPECT_FLOAT_EQ(observer.getInjectionAmplitude(), 0.0f);
+
+  // no polarity detection from a known angle
+  motor.theta = 110.0 * M_PI / 180.0;
+  observer.resume();
+  // the current loop keeps room for the pulses as well
+  EXPECT_FLOAT_EQ(observer.getInjectionAmplitude(), 4.0f);
+  for (int i = 0; i < 2000; i++) {
+    tick(&motor, &observer);
+  }
+  EXPECT_LT(angleError(observer.getAngle(), motor.angle()), 3.0f);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ut_kalman_velocity_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-29
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "coriander/motorctl/kalman_velocity_estimator.h"
+#include "coriander/motorctl/pll_velocity_estimator.h"
+#include "coriander/parameters.h"
+#include "tests/mocks.h"
+
+namespace {
+struct DummyMechAngleEstimator
+    : public coriander::motorctl::IMechAngleEstimator {
+  virtual void enable() {}
+  virtual void disable() {}
+  virtual bool enabled() { return true; }
+  virtual void sync() {}
+  virtual bool needSync(uint32_t syncId) { return false; }
+  virtual bool needCalibrate() { return false; }
+  virtual void calibrate() {}
+  virtual float getMechanicalAngle() noexcept { return mMechAngle; }
+
+  float mMechAngle = 0.0f;
+};
+
+struct DummySystick : public coriander::os::ISystick {
+  virtual uint32_t systick_ms() { return us / 1000; }
+  virtual uint32_t systick_us() { return us; }
+  uint32_t us = 0;
+};
+
+using Property = coriander::base::Property;
+using ParamId = coriander::base::ParamId;
+using Parameter = testing::mock::MockPersistentParameter;
+using coriander::motorctl::KalmanVelocityEstimator;
+using coriander::motorctl::PllVelocityEstimator;
+
+constexpr uint32_t kTickUs = 50;         // 20kHz current loop
+constexpr uint32_t kReadUs = 2000;       // 500Hz velocity loop
+constexpr float kCount = 360.0f / 1024;  // low resolution encoder, degree
+constexpr double kInertia = 1e-4;        // kg*m^2
+constexpr double kTorqueConstant = 0.1;  // Nm/A
+
+struct Bench {
+  Bench() {
+    param->add(Property{static_cast<float>(kTorqueConstant),
+                        ParamId::MotorCtl_MotorDriver_TorqueConstant});
+    param->add(Property{static_cast<float>(kInertia),
+                        ParamId::MotorCtl_MotorDriver_Inertia});
+    param->add(Property{kCount / std::sqrt(12.0f),
+                        ParamId::MotorCtl_SpeedEstimator_KalmanPositionNoise});
+    param->add(Property{
+        10.0f, ParamId::MotorCtl_SpeedEstimator_KalmanAccelerationNoise});
+    param->add(
+        Property{0.01f, ParamId::MotorCtl_SpeedEstimator_KalmanLoadNoise});
+    param->add(
+        Property{300.0f, ParamId::MotorCtl_SpeedEstimator_PllBandwidth});
+  }
+
+  /**
+   * @brief step the rigid rotor one tick and publish the encoder angle
+   *
+   * @param iq q current(A) applied over the tick
+   * @param load load torque(Nm) over the tick
+   */
+  void step(double iq, double load) {
+    double dt = kTickUs * 1e-6;
+    double acceleration = (kTorqueConstant * iq - load) / kInertia;
+    angle += velocity * dt + 0.5 * acceleration * dt * dt;
+    velocity += acceleration * dt;
+    systick->us += kTickUs;
+    angleEstimator->mMechAngle =
+        static_cast<float>(std::floor(angle * 180.0 / M_PI / kCount) * kCount);
+  }
+
+  float rpm() const { return static_cast<float>(velocity * 30.0 / M_PI); }
+
+  std::shared_ptr<DummyMechAngleEstimator> angleEstimator =
+      std::make_shared<DummyMechAngleEstimator>();
+  std::shared_ptr<DummySystick> systick = std::make_shared<DummySystick>();
+  std::shared_ptr<Parameter> param = std::make_shared<Parameter>();
+  std::shared_ptr<testing::mock::MockParamReqValidator> paramReqValidator =
+      std::make_shared<testing::mock::MockParamReqValidator>();
+  double angle = 0.0;     // rad
+  double velocity = 0.0;  // rad/s
+};
+}  // namespace
+
+TEST(ISensor, KalmanVelocityEstimator) {
+  Bench bench;
+  KalmanVelocityEstimator kalman{bench.angleEstimator, bench.param,
+                                 bench.systick, bench.paramReqValidator};
+  PllVelocityEstimator pll{bench.angleEstimator, bench.param, bench.systick,
+                           bench.paramReqValidator};
+  double kalmanSum = 0.0, pllSum = 0.0;
+  float commanded = 0.0f;
+  int n = 0;
+
+  kalman.enable();
+  pll.enable();
+
+  // +-1A square wave at 25Hz, a 0.02Nm load from 0.3s
+  for (uint32_t t = kTickUs; t <= 600000; t += kTickUs) {
+    float iq = (t / 20000) % 2 ? -1.0f : 1.0f;
+    float load = t > 300000 ? 0.02f : 0.0f;
+    if (t % kReadUs == 0) {
+      commanded = iq;  // the velocity loop pushes its output
+      kalman.setTorqueCurrent(commanded);
+    }
+    bench.step(commanded, load);
+    kalman.sync();
+    pll.sync();
+
+    if (t % kReadUs == 0 && t > 100000) {
+      float kalmanErr = kalman.getVelocity() - bench.rpm();
+      float pllErr = pll.getVelocity() - bench.rpm();
+      kalmanSum += kalmanErr * kalmanErr;
+      pllSum += pllErr * pllErr;
+      n++;
+    }
+  }
+
+  // the model knows the current steps, the tracking loop has to wait for
+  // the angle to move
+  float kalmanRms = std::sqrt(kalmanSum / n);
+  float pllRms = std::sqrt(pllSum / n);
+  EXPECT_LT(kalmanRms, pllRms / 2);
+  EXPECT_LT(kalmanRms, 5.0f);
+
+  EXPECT_NEAR(kalman.getLoadTorque(), 0.02f, 0.002f);
+  EXPECT_NEAR(kalman.getPosition(),
+              static_cast<float>(bench.angle * 180.0 / M_PI), kCount);
+  // 1A against the load over inertia, rad/s^2 to RPM/s
+  EXPECT_NEAR(kalman.getAcceleration(),
+              (0.1f - 0.02f) / 1e-4f * 30.0f / M_PI, 100.0f);
+}
+
+TEST(ISensor, KalmanVelocityEstimatorNoModel) {
+  Bench bench;
+  bench.param->setValue(ParamId::MotorCtl_MotorDriver_TorqueConstant, 0.0f);
+  KalmanVelocityEstimator kalman{bench.angleEstimator, bench.param,
+                                 bench.systick, bench.paramReqValidator};
+
+  // without the current the load carries the acceleration
+  kalman.enable();
+  for (uint32_t t = kTickUs; t <= 500000; t += kTickUs) {
+    bench.step(1.0, 0.0);
+    kalman.sync();
+  }
+  EXPECT_NEAR(kalman.getVelocity(), bench.rpm(), 0.01f * bench.rpm());
+  EXPECT_NEAR(kalman.getLoadTorque(), -0.1f, 0.005f);
+
+  kalman.disable();
+  EXPECT_EQ(kalman.getVelocity(), 0.0f);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file ut_math.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-21
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "coriander/base/math.h"
+
+namespace {
+using coriander::base::math;
+}  // namespace
+
+TEST(Math, atan2f) {
+  double err = 0;
+  for (int i = 0; i < 100000; i++) {
+    double angle = -M_PI + 2 * M_PI * i / 100000;
+    for (float r : {1e-3f, 1.0f, 3e3f}) {
+      float x = r * std::cos(angle), y = r * std::sin(angle);
+      err = std::max(err, std::fabs(double(math::atan2f(y, x)) -
+                                     std::atan2(double(y), double(x))));
+    }
+  }
+  EXPECT_LT(err, 2e-6);
+
+  EXPECT_EQ(math::atan2f(0, 0), 0.0f);
+  EXPECT_NEAR(math::atan2f(0, -1), M_PI, 1e-6);
+  EXPECT_NEAR(math::atan2f(-1, 0), -M_PI / 2, 1e-6);
+}
+
+TEST(Math, sqrtf) {
+  double err = 0;
+  for (float x = 1e-6f; x < 1e6f; x *= 1.001f) {
+    EXPECT_EQ(math::sqrtf(x), std::sqrt(x));
+    err = std::max(err, std::fabs(math::rsqrtf(x) * std::sqrt(x) - 1.0));
+  }
+  EXPECT_LT(err, 5e-6);
+  EXPECT_EQ(math::sqrtf(-1.0f), 0.0f);
+}
+
+TEST(Math, wrap) {
+  for (float deg = -1000.0f; deg < 1000.0f; deg += 0.37f) {
+    float w = math::wrapd(deg);
+    EXPECT_GE(w, 0.0f) << "deg: " << deg;
+    EXPECT_LT(w, 360.0f) << "deg: " << deg;
+    EXPECT_NEAR(std::remainder(w - deg, 360.0f), 0, 1e-3) << "deg: " << deg;
+
+    float d = math::wrapd180(deg);
+    EXPECT_GE(d, -180.0f) << "deg: " << deg;
+    EXPECT_LT(d, 180.0f) << "deg: " << deg;
+    EXPECT_NEAR(std::remainder(d - deg, 360.0f), 0, 1e-3) << "deg: " << deg;
+  }
+  EXPECT_EQ(math::wrapd(360.0f), 0.0f);
+  EXPECT_EQ(math::wrapd(-360.0f), 0.0f);
+  EXPECT_EQ(math::wrapd180(180.0f), -180.0f);
+}
+
+TEST(Math, saturate) {
+  EXPECT_EQ(math::sat_add(INT32_MAX, 1), INT32_MAX);
+  EXPECT_EQ(math::sat_add(INT32_MIN, -1), INT32_MIN);
+  EXPECT_EQ(math::sat_add(5, -7), -2);
+  EXPECT_EQ(math::sat_sub(INT32_MIN, 1), INT32_MIN);
+  EXPECT_EQ(math::sat_sub(INT32_MAX, -1), INT32_MAX);
+  EXPECT_EQ(math::sat_sub(5, 7), -2);
+  EXPECT_EQ(math::constrain(2.0f, -1.0f, 1.0f), 1.0f);
+  EXPECT_EQ(math::constrain(-2.0f, -1.0f, 1.0f), -1.0f);
+  EXPECT_EQ(math::constrain(0.5f, -1.0f, 1.0f), 0.5f);
+}
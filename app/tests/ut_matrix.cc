@@ -0,0 +1,46 @@
+/**
+ * @file ut_matrix.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-29
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "coriander/base/matrix.h"
+
+using coriander::base::Matrix;
+using coriander::base::Vector;
+
+TEST(Matrix, basic) {
+  constexpr auto I = Matrix<3, 3>::identity();
+  static_assert(I(0, 0) == 1.0f && I(0, 1) == 0.0f && I(2, 2) == 1.0f);
+
+  Matrix<2, 3> a{{{1, 2, 3}, {4, 5, 6}}};
+  Matrix<3, 2> b = a.transpose();
+  EXPECT_EQ(b(2, 0), 3.0f);
+  EXPECT_EQ(b(0, 1), 4.0f);
+
+  // (2x3) * (3x2)
+  Matrix<2, 2> c = a * b;
+  EXPECT_EQ(c(0, 0), 14.0f);
+  EXPECT_EQ(c(0, 1), 32.0f);
+  EXPECT_EQ(c(1, 0), 32.0f);
+  EXPECT_EQ(c(1, 1), 77.0f);
+
+  Matrix<2, 3> d = a * I;
+  Matrix<2, 3> e = (d + a) * 0.5f - a;
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_EQ(d(i, j), a(i, j));
+      EXPECT_EQ(e(i, j), 0.0f);
+    }
+  }
+
+  Vector<3> x{{{1}, {1}, {1}}};
+  Vector<2> y = a * x;
+  EXPECT_EQ(y(0, 0), 6.0f);
+  EXPECT_EQ(y(1, 0), 15.0f);
+}
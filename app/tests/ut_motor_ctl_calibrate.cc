@@ -58,6 +58,8 @@ static auto createInjector() {
       bind<IMotorCtl>().to<MotorCtlCalibrate>(),
       bind<coriander::motorctl::IPhaseCurrentEstimator>()
           .to<testing::mock::MockPhaseCurrentEstimator>(),
+      bind<coriander::motorctl::IBusVoltageEstimator>()
+          .to<testing::mock::MockBusVoltageEstimator>(),
       bind<IParamReqValidator>().to<testing::mock::MockParamReqValidator>());
 }
 
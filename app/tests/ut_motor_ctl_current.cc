@@ -9,6 +9,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include "boost/di.hpp"
 #include "coriander/motorctl/iphase_current_estimator.h"
 #include "coriander/motorctl/motor_ctl_current.h"
@@ -30,6 +32,8 @@ auto& createInjector() {
       bind<coriander::os::ISystick>.to<MockSystick>(),
       bind<coriander::motorctl::FocMotorDriver>.to<Mfmd>(),
       bind<coriander::motorctl::IPhaseCurrentEstimator>.to<Mpce>(),
+      bind<coriander::motorctl::IBusVoltageEstimator>.to<
+          testing::mock::MockBusVoltageEstimator>(),
       bind<coriander::Parameter>.to<testing::mock::MockPersistentParameter>(),
       bind<coriander::motorctl::IElecAngleEstimator>.to<Meae>());
   return injector;
@@ -82,10 +86,230 @@ TEST(MotorCtlCurrent, targetMode) {
       .WillByDefault(testing::DoAll(testing::SetArgPointee<0>(0.0f),
                                     testing::SetArgPointee<1>(0.0f)));
   EXPECT_CALL(*systick, systick_us()).WillRepeatedly(testing::Return(2000));
-  EXPECT_CALL(*motor, setVoltage(_, _)).Times(1);
+  EXPECT_CALL(*motor, setVoltage(_, _, _, _)).Times(1);
   motorCtl->loop();
 
   EXPECT_CALL(*currentSensor, disable()).Times(1);
   EXPECT_CALL(*motor, disable()).Times(1);
   motorCtl->stop();
 }
+
+TEST(MotorCtlCurrent, invalidModulation) {
+  using ID = coriander::base::ParamId;
+  using coriander::base::Property;
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+
+  param->add(Property{1.0f, ID::MotorCtl_CurrCtl_PidP});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidI});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidD});
+  param->add(Property(1e3f, ID::MotorCtl_CurrCtl_PidOutputRamp));
+  param->add(Property{1e3f, ID::MotorCtl_CurrCtl_PidLimit});
+  param->add(Property{1000, ID::MotorCtl_CurrCtl_Freq});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentD_RT});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentQ_RT});
+  param->add(Property{1000.0f, ID::MotorCtl_CurrCtl_Lpf_TimeConstant});
+
+  auto motorCtl =
+      injector.create<std::shared_ptr<coriander::motorctl::MotorCtlCurrent>>();
+
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(testing::Return(0));
+  EXPECT_CALL(*currentSensor, enable()).Times(2);
+  EXPECT_CALL(*motor, enable()).Times(2);
+  EXPECT_CALL(*motor, disable()).Times(2);
+
+  // past the last mode, it would run as the hexagon clip
+  param->add(Property{3, ID::MotorCtl_CurrCtl_Modulation});
+  motorCtl->start();
+  EXPECT_TRUE(motorCtl->fatalError());
+  motorCtl->stop();
+
+  param->add(Property{2, ID::MotorCtl_CurrCtl_Modulation});
+  motorCtl->start();
+  EXPECT_FALSE(motorCtl->fatalError());
+  motorCtl->stop();
+  param->remove(ID::MotorCtl_CurrCtl_Modulation);
+}
+
+TEST(MotorCtlCurrent, invalidPwmMode) {
+  using ID = coriander::base::ParamId;
+  using coriander::base::Property;
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+
+  param->add(Property{1.0f, ID::MotorCtl_CurrCtl_PidP});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidI});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidD});
+  param->add(Property(1e3f, ID::MotorCtl_CurrCtl_PidOutputRamp));
+  param->add(Property{1e3f, ID::MotorCtl_CurrCtl_PidLimit});
+  param->add(Property{1000, ID::MotorCtl_CurrCtl_Freq});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentD_RT});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentQ_RT});
+  param->add(Property{1000.0f, ID::MotorCtl_CurrCtl_Lpf_TimeConstant});
+  param->add(Property{0.8f, ID::MotorCtl_CurrCtl_PwmModeThreshold});
+
+  auto motorCtl =
+      injector.create<std::shared_ptr<coriander::motorctl::MotorCtlCurrent>>();
+
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(testing::Return(0));
+  EXPECT_CALL(*currentSensor, enable()).Times(2);
+  EXPECT_CALL(*motor, enable()).Times(2);
+  EXPECT_CALL(*motor, disable()).Times(2);
+
+  // past the last mode, the driver stays continuous
+  param->add(Property{5, ID::MotorCtl_CurrCtl_PwmMode});
+  motorCtl->start();
+  EXPECT_TRUE(motorCtl->fatalError());
+  EXPECT_EQ(motor->getPwmMode(), coriander::motorctl::foc::PwmMode::Continuous);
+  motorCtl->stop();
+
+  param->add(Property{4, ID::MotorCtl_CurrCtl_PwmMode});
+  motorCtl->start();
+  EXPECT_FALSE(motorCtl->fatalError());
+  EXPECT_EQ(motor->getPwmMode(), coriander::motorctl::foc::PwmMode::Dpwm30);
+  motorCtl->stop();
+  param->remove(ID::MotorCtl_CurrCtl_PwmMode);
+}
+
+TEST(MotorCtlCurrent, busSag) {
+  using ID = coriander::base::ParamId;
+  using coriander::base::Property;
+  using testing::_;
+  using testing::Return;
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+  auto busVoltage =
+      injector
+          .create<std::shared_ptr<testing::mock::MockBusVoltageEstimator>>();
+  float ud = 0.0f, uq = 0.0f;
+
+  // far more q current than the voltage can drive, the output saturates
+  param->add(Property{1e3f, ID::MotorCtl_CurrCtl_PidP});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidI});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidD});
+  param->add(Property(0.0f, ID::MotorCtl_CurrCtl_PidOutputRamp));
+  param->add(Property{1e3f, ID::MotorCtl_CurrCtl_PidLimit});
+  param->add(Property{1000, ID::MotorCtl_CurrCtl_Freq});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentD_RT});
+  param->add(Property{10.0f, ID::MotorCtl_General_TargetCurrentQ_RT});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_Lpf_TimeConstant});
+  param->add(Property{24.0f, ID::MotorCtl_MotorDriver_SupplyVoltage});
+
+  auto motorCtl =
+      injector.create<std::shared_ptr<coriander::motorctl::MotorCtlCurrent>>();
+
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*currentSensor, enable()).Times(1);
+  EXPECT_CALL(*motor, enable()).Times(1);
+  motorCtl->start();
+
+  // the bus sagged to half the supply, the driver doubles the duty cycles
+  EXPECT_CALL(*currentSensor, sync()).Times(testing::AnyNumber());
+  ON_CALL(*busVoltage, enabled()).WillByDefault(Return(true));
+  ON_CALL(*busVoltage, getBusVoltage()).WillByDefault(Return(12.0f));
+  ON_CALL(*busVoltage, getTemperature()).WillByDefault(Return(25.0f));
+  ON_CALL(*currentSensor, getPhaseCurrent(_, _))
+      .WillByDefault(testing::DoAll(testing::SetArgPointee<0>(0.0f),
+                                    testing::SetArgPointee<1>(0.0f)));
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(Return(2000));
+  EXPECT_CALL(*motor, setVoltage(_, _, _, _))
+      .WillOnce(testing::DoAll(testing::SaveArg<0>(&ud),
+                               testing::SaveArg<1>(&uq)));
+  motorCtl->loop();
+
+  // what reaches the bridge stays on the linear limit
+  EXPECT_FLOAT_EQ(motor->getBusScale(), 2.0f);
+  EXPECT_NEAR(std::sqrt(ud * ud + uq * uq) * motor->getBusScale(),
+              2.0f / std::sqrt(3.0f), 1e-4f);
+  EXPECT_FLOAT_EQ(motorCtl->getModulationIndex(), 1.0f);
+
+  EXPECT_CALL(*motor, disable()).Times(1);
+  motorCtl->stop();
+  param->remove(ID::MotorCtl_MotorDriver_SupplyVoltage);
+  testing::Mock::VerifyAndClear(busVoltage.get());
+}
+
+TEST(MotorCtlCurrent, busFirstSample) {
+  using ID = coriander::base::ParamId;
+  using coriander::base::Property;
+  using testing::_;
+  using testing::Return;
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+  auto busVoltage =
+      injector
+          .create<std::shared_ptr<testing::mock::MockBusVoltageEstimator>>();
+  uint32_t us = 0;
+
+  param->add(Property{1.0f, ID::MotorCtl_CurrCtl_PidP});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidI});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidD});
+  param->add(Property(0.0f, ID::MotorCtl_CurrCtl_PidOutputRamp));
+  param->add(Property{1.0f, ID::MotorCtl_CurrCtl_PidLimit});
+  param->add(Property{1000, ID::MotorCtl_CurrCtl_Freq});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentD_RT});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentQ_RT});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_Lpf_TimeConstant});
+  param->add(Property{24.0f, ID::MotorCtl_MotorDriver_SupplyVoltage});
+  param->add(Property{1e-3f, ID::MotorCtl_MotorDriver_BusLpf_TimeConstant});
+
+  auto motorCtl =
+      injector.create<std::shared_ptr<coriander::motorctl::MotorCtlCurrent>>();
+
+  EXPECT_CALL(*systick, systick_us())
+      .WillRepeatedly(testing::ReturnPointee(&us));
+  EXPECT_CALL(*currentSensor, enable()).Times(1);
+  EXPECT_CALL(*motor, enable()).Times(1);
+  motorCtl->start();
+
+  EXPECT_CALL(*currentSensor, sync()).Times(testing::AnyNumber());
+  EXPECT_CALL(*motor, setVoltage(_, _, _, _)).Times(testing::AnyNumber());
+  ON_CALL(*busVoltage, enabled()).WillByDefault(Return(true));
+  ON_CALL(*busVoltage, getTemperature()).WillByDefault(Return(25.0f));
+  ON_CALL(*currentSensor, getPhaseCurrent(_, _))
+      .WillByDefault(testing::DoAll(testing::SetArgPointee<0>(0.0f),
+                                    testing::SetArgPointee<1>(0.0f)));
+
+  // nothing converted yet, the data register reads below the offset
+  ON_CALL(*busVoltage, getBusVoltage()).WillByDefault(Return(-3.0f));
+  us += 1001;
+  motorCtl->loop();
+  EXPECT_FLOAT_EQ(motor->getBusScale(), 1.0f);
+
+  // 12V, filtered from the supply voltage, not from the first sample: a
+  // period over a 1ms time constant leaves half of 24V
+  ON_CALL(*busVoltage, getBusVoltage()).WillByDefault(Return(12.0f));
+  us += 1001;
+  motorCtl->loop();
+  EXPECT_FLOAT_EQ(motor->getBusScale(), 24.0f / 18.0f);
+
+  EXPECT_CALL(*motor, disable()).Times(1);
+  motorCtl->stop();
+  param->remove(ID::MotorCtl_MotorDriver_SupplyVoltage);
+  param->remove(ID::MotorCtl_MotorDriver_BusLpf_TimeConstant);
+  testing::Mock::VerifyAndClear(busVoltage.get());
+}
@@ -0,0 +1,223 @@
+/**
+ * @file ut_motor_ctl_dual_position.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-10-10
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "coriander/application/diagnosis.h"
+#include "coriander/motorctl/load_mech_angle_estimator.h"
+#include "coriander/motorctl/motor_ctl_dual_position.h"
+#include "coriander/parameters.h"
+#include "tests/mocks.h"
+
+namespace {
+
+using coriander::Parameter;
+using coriander::application::Diagnosis;
+using coriander::base::ParamId;
+using coriander::base::Property;
+using coriander::motorctl::ILoadEncoder;
+using coriander::motorctl::IMechAngleEstimator;
+using coriander::motorctl::LoadMechAngleEstimator;
+using coriander::motorctl::MotorCtlDualPosition;
+using coriander::motorctl::MotorCtlVelocity;
+
+constexpr unsigned kCountPerRound = 4000;
+constexpr float kGearRatio = 10.0f;
+constexpr uint32_t kPeriodUs = 2000;  // MotorCtl_PosCtl_Freq
+
+struct DummySystick : public coriander::os::ISystick {
+  virtual uint32_t systick_ms() { return us / 1000; }
+  virtual uint32_t systick_us() { return us; }
+  uint32_t us = 0;
+};
+
+/**
+ * @brief motor shaft, in front of the gear
+ */
+struct DummyMechAngleEstimator : public IMechAngleEstimator {
+  void enable() override { mEnabled = true; }
+  void disable() override { mEnabled = false; }
+  bool enabled() override { return mEnabled; }
+  void sync() override {}
+  void calibrate() override {}
+  bool needCalibrate() override { return false; }
+  float getMechanicalAngle() noexcept override { return angle; }
+
+  float angle = 0.0f;  //!< motor degree
+
+ private:
+  bool mEnabled = false;
+};
+
+/**
+ * @brief quadrature counter behind the gear, never enabled when absent
+ */
+struct DummyLoadEncoder : public ILoadEncoder {
+  unsigned getEncoderCount() override {
+    int count = mCount % static_cast<int>(kCountPerRound);
+    return count < 0 ? count + kCountPerRound : count;
+  }
+  unsigned getEncoderCountPerRound() override { return kCountPerRound; }
+  int getOverflowCount() override {
+    return (mCount - static_cast<int>(getEncoderCount())) /
+           static_cast<int>(kCountPerRound);
+  }
+  void enable() override { mEnabled = present; }
+  void disable() override { mEnabled = false; }
+  bool enabled() override { return mEnabled; }
+  void sync() override {
+    mCount = std::lround(angle / 360.0f * kCountPerRound);
+  }
+  void calibrate() override {}
+  bool needCalibrate() override { return false; }
+
+  float angle = 0.0f;  //!< load degree, quantized at sync
+  bool present = true;
+
+ private:
+  int mCount = 0;
+  bool mEnabled = false;
+};
+
+/**
+ * @brief the velocity loop below, keeps the target in the parameter only
+ */
+struct DummyMotorCtlVelocity : public MotorCtlVelocity {
+  DummyMotorCtlVelocity(std::shared_ptr<Parameter> param,
+                        std::shared_ptr<coriander::IParamReqValidator> v)
+      : MotorCtlVelocity(nullptr, param, nullptr, nullptr, nullptr, v) {}
+
+  void start() override {}
+  void stop() override {}
+  void loop() override {}
+  void emergencyStop() override {}
+  bool fatalError() override { return false; }
+};
+
+struct Bench {
+  Bench() {
+    param->add(Property{0.3f, ParamId::MotorCtl_PosCtl_PidP});
+    param->add(Property{0.0f, ParamId::MotorCtl_PosCtl_PidI});
+    param->add(Property{0.0f, ParamId::MotorCtl_PosCtl_PidD});
+    param->add(Property{1e6f, ParamId::MotorCtl_PosCtl_PidOutputRamp});
+    param->add(Property{960.0f, ParamId::MotorCtl_PosCtl_PidLimit});
+    param->add(Property{500, ParamId::MotorCtl_PosCtl_Freq});
+    param->add(Property{90.0f, ParamId::MotorCtl_General_TargetPosition_RT});
+    param->add(Property{0.0f, ParamId::MotorCtl_General_TargetVelocity_RT});
+    param->add(Property{kGearRatio, ParamId::MotorCtl_DualPosCtl_GearRatio});
+    param->add(
+        Property{100e-3f, ParamId::MotorCtl_DualPosCtl_Lpf_TimeConstant});
+    param->add(Property{0.3f, ParamId::MotorCtl_DualPosCtl_EngageCurrent});
+    param->add(Property{0.999f, ParamId::MotorCtl_DualPosCtl_Forgetting});
+    param->add(Property{0.0f, ParamId::MotorCtl_DualPosCtl_Backlash});
+    param->add(Property{0.0f, ParamId::MotorCtl_DualPosCtl_Compliance});
+    param->add(Property{5.0f, ParamId::MotorCtl_DualPosCtl_MaxDeviation});
+    param->add(
+        Property{0.0f, ParamId::MotorCtl_Calibrate_CaliLoadAngleOffset});
+
+    diagnosis->addDiagInspector(
+        [this](Diagnosis::DiagDevId id, Diagnosis::DeviceStatus status) {
+          if (id == Diagnosis::DiagDevId::MotorOuterPosSensor) {
+            reported = status;
+          }
+        });
+  }
+
+  /**
+   * @brief one position period, the shaft and the load moved to the given
+   *        angles meanwhile
+   */
+  void tick(float motorAngle, float loadAngle) {
+    mechAngle->angle = motorAngle;
+    loadEncoder->angle = loadAngle;
+    systick->us += kPeriodUs + 1;
+    motorCtl.loop();
+  }
+
+  float targetVelocity() {
+    return param->getValue<float>(ParamId::MotorCtl_General_TargetVelocity_RT);
+  }
+
+  std::shared_ptr<DummySystick> systick = std::make_shared<DummySystick>();
+  std::shared_ptr<Parameter> param =
+      std::make_shared<testing::mock::MockPersistentParameter>();
+  std::shared_ptr<Diagnosis> diagnosis = std::make_shared<Diagnosis>();
+  std::shared_ptr<testing::mock::MockParamReqValidator> validator =
+      std::make_shared<testing::mock::MockParamReqValidator>();
+  std::shared_ptr<DummyMechAngleEstimator> mechAngle =
+      std::make_shared<DummyMechAngleEstimator>();
+  std::shared_ptr<DummyLoadEncoder> loadEncoder =
+      std::make_shared<DummyLoadEncoder>();
+  MotorCtlDualPosition motorCtl{
+      std::make_shared<DummyMotorCtlVelocity>(param, validator),
+      mechAngle,
+      std::make_shared<LoadMechAngleEstimator>(loadEncoder, param, validator),
+      diagnosis,
+      std::make_unique<MotorCtlDualPosition::Duration>(systick),
+      std::make_unique<MotorCtlDualPosition::DurationTimeout>(systick),
+      param,
+      validator};
+  Diagnosis::DeviceStatus reported = Diagnosis::DeviceStatus::Unknown;
+};
+
+}  // namespace
+
+TEST(MotorCtlDualPosition, followLoad) {
+  Bench bench;
+
+  bench.motorCtl.start();
+  EXPECT_FALSE(bench.motorCtl.fatalError());
+
+  // a stiff gear, the load where the shaft says
+  for (int i = 0; i < 100; i++) {
+    float load = i * 0.1f;
+    bench.tick(load * kGearRatio, load);
+  }
+  EXPECT_FALSE(bench.motorCtl.fatalError());
+  // 0.3 RPM per motor degree towards 90 load degrees
+  EXPECT_NEAR(bench.targetVelocity(), 0.3f * (90.0f - 9.9f) * kGearRatio,
+              0.3f * kGearRatio * 0.2f);
+
+  bench.diagnosis->inspect();  // polled by the main loop
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Normal);
+  bench.motorCtl.stop();
+}
+
+TEST(MotorCtlDualPosition, noLoadEncoder) {
+  Bench bench;
+
+  bench.loadEncoder->present = false;
+  bench.motorCtl.start();
+  EXPECT_TRUE(bench.motorCtl.fatalError());
+
+  bench.diagnosis->inspect();
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Lost);
+  bench.motorCtl.stop();
+}
+
+TEST(MotorCtlDualPosition, slippedCoupling) {
+  Bench bench;
+
+  bench.motorCtl.start();
+  bench.tick(0.0f, 0.0f);
+  EXPECT_FALSE(bench.motorCtl.fatalError());
+
+  // the shaft turns 20 load degrees on, the load stays
+  for (int i = 0; i < 100; i++) {
+    bench.tick(20.0f * kGearRatio, 0.0f);
+  }
+  EXPECT_TRUE(bench.motorCtl.fatalError());
+
+  bench.diagnosis->inspect();
+  EXPECT_EQ(bench.reported, Diagnosis::DeviceStatus::Error);
+  bench.motorCtl.stop();
+}
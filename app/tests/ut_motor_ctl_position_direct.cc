@@ -0,0 +1,192 @@
+/**
+ * @file ut_motor_ctl_position_direct.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-24
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "boost/di.hpp"
+#include "coriander/motorctl/motor_ctl_position_direct.h"
+#include "coriander/parameters.h"
+#include "tests/mocks.h"
+
+namespace {
+using ID = coriander::base::ParamId;
+using coriander::base::Property;
+using coriander::motorctl::MotorCtlPositionDirect;
+using testing::_;
+using testing::Return;
+using testing::ReturnPointee;
+
+constexpr uint32_t kPeriodUs = 101;  // a current period, just past its timeout
+constexpr float Ts = kPeriodUs * 1e-6f;
+
+auto& createInjector() {
+  using boost::di::bind;
+  using testing::mock::MockMechAngleEstimator;
+  using testing::mock::MockParamReqValidator;
+  using testing::mock::MockSystick;
+  using Mfmd = testing::mock::MockFocMotorDriver;
+  using Mpce = testing::mock::MockPhaseCurrentEstimator;
+  using Meae = testing::mock::MockElecAngleEstimator;
+  static auto injector = boost::di::make_injector(
+      bind<coriander::IParamReqValidator>.to<MockParamReqValidator>(),
+      bind<coriander::os::ISystick>.to<MockSystick>(),
+      bind<coriander::motorctl::FocMotorDriver>.to<Mfmd>(),
+      bind<coriander::motorctl::IPhaseCurrentEstimator>.to<Mpce>(),
+      bind<coriander::motorctl::IBusVoltageEstimator>.to<
+          testing::mock::MockBusVoltageEstimator>(),
+      bind<coriander::Parameter>.to<testing::mock::MockPersistentParameter>(),
+      bind<coriander::motorctl::IElecAngleEstimator>.to<Meae>(),
+      bind<coriander::motorctl::IMechAngleEstimator>.to<
+          MockMechAngleEstimator>());
+  return injector;
+}
+
+/**
+ * @brief 10kHz current loop, the position loop every 4th period, no phase
+ *        current
+ */
+void setup(std::shared_ptr<coriander::Parameter> param,
+           std::shared_ptr<testing::mock::MockPhaseCurrentEstimator> sensor) {
+  param->add(Property{1.0f, ID::MotorCtl_CurrCtl_PidP});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidI});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_PidD});
+  param->add(Property(0.0f, ID::MotorCtl_CurrCtl_PidOutputRamp));
+  param->add(Property{1.0f, ID::MotorCtl_CurrCtl_PidLimit});
+  param->add(Property{10000, ID::MotorCtl_CurrCtl_Freq});
+  param->add(Property{0.0f, ID::MotorCtl_CurrCtl_Lpf_TimeConstant});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentD_RT});
+  param->add(Property{0.0f, ID::MotorCtl_General_TargetCurrentQ_RT});
+
+  param->add(Property{1.0f, ID::MotorCtl_PosDirectCtl_PosP});
+  param->add(Property{0.01f, ID::MotorCtl_PosDirectCtl_VelP});
+  param->add(Property{0.0f, ID::MotorCtl_PosDirectCtl_VelI});
+  param->add(Property{50.0f, ID::MotorCtl_PosDirectCtl_VelLimit});
+  param->add(Property{0.5f, ID::MotorCtl_PosDirectCtl_CurrLimit});
+  param->add(Property{4, ID::MotorCtl_PosDirectCtl_Divider});
+  param->add(Property{0.0f, ID::MotorCtl_PosDirectCtl_Lpf_TimeConstant});
+  param->add(Property{90.0f, ID::MotorCtl_General_TargetPosition_RT});
+
+  ON_CALL(*sensor, getPhaseCurrent(_, _))
+      .WillByDefault(testing::DoAll(testing::SetArgPointee<0>(0.0f),
+                                    testing::SetArgPointee<1>(0.0f)));
+}
+}  // namespace
+
+TEST(MotorCtlPositionDirect, divider) {
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+  auto mechAngle =
+      injector.create<std::shared_ptr<testing::mock::MockMechAngleEstimator>>();
+  uint32_t us = 0;
+
+  setup(param, currentSensor);
+  auto motorCtl = injector.create<std::shared_ptr<MotorCtlPositionDirect>>();
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(ReturnPointee(&us));
+  EXPECT_CALL(*motor, enable()).Times(1);
+  motorCtl->start();
+
+  // the current loop every period, the position loop every 4th one, far
+  // from the target the q current is at its limit
+  EXPECT_CALL(*mechAngle, getMechanicalAngle())
+      .Times(2)
+      .WillRepeatedly(Return(0.0f));
+  EXPECT_CALL(*motor, setVoltage(_, _, _, _)).Times(8);
+  for (int k = 0; k < 8; k++) {
+    us += kPeriodUs;
+    motorCtl->loop();
+  }
+  EXPECT_FLOAT_EQ(
+      param->getValue<float>(ID::MotorCtl_General_TargetCurrentQ_RT), 0.5f);
+
+  EXPECT_CALL(*motor, disable()).Times(1);
+  motorCtl->stop();
+}
+
+TEST(MotorCtlPositionDirect, velocityLimit) {
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+  auto mechAngle =
+      injector.create<std::shared_ptr<testing::mock::MockMechAngleEstimator>>();
+  uint32_t us = 0;
+  float angle = 0.0f;
+
+  setup(param, currentSensor);
+  auto motorCtl = injector.create<std::shared_ptr<MotorCtlPositionDirect>>();
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(ReturnPointee(&us));
+  EXPECT_CALL(*motor, enable()).Times(1);
+  motorCtl->start();
+
+  // far from the target and turning at the velocity limit, 50 RPM, nothing
+  // left to accelerate
+  EXPECT_CALL(*mechAngle, getMechanicalAngle())
+      .WillRepeatedly(ReturnPointee(&angle));
+  EXPECT_CALL(*motor, setVoltage(_, _, _, _)).Times(testing::AnyNumber());
+  for (int k = 0; k < 40; k++) {
+    us += kPeriodUs;
+    angle += 50.0f * 6.0f * Ts;
+    motorCtl->loop();
+  }
+  EXPECT_NEAR(param->getValue<float>(ID::MotorCtl_General_TargetCurrentQ_RT),
+              0.0f, 1e-3f);
+
+  EXPECT_CALL(*motor, disable()).Times(1);
+  motorCtl->stop();
+}
+
+TEST(MotorCtlPositionDirect, settles) {
+  auto& injector = createInjector();
+  auto param = injector.create<std::shared_ptr<coriander::Parameter>>();
+  auto systick = injector.create<std::shared_ptr<testing::mock::MockSystick>>();
+  auto motor =
+      injector.create<std::shared_ptr<testing::mock::MockFocMotorDriver>>();
+  auto currentSensor =
+      injector
+          .create<std::shared_ptr<testing::mock::MockPhaseCurrentEstimator>>();
+  auto mechAngle =
+      injector.create<std::shared_ptr<testing::mock::MockMechAngleEstimator>>();
+  uint32_t us = 0;
+  float angle = 0.0f, velocity = 0.0f;
+
+  setup(param, currentSensor);
+  auto motorCtl = injector.create<std::shared_ptr<MotorCtlPositionDirect>>();
+  EXPECT_CALL(*systick, systick_us()).WillRepeatedly(ReturnPointee(&us));
+  EXPECT_CALL(*motor, enable()).Times(1);
+  motorCtl->start();
+
+  // rigid load, 6000 RPM/s per ampere, the current loop assumed ideal
+  EXPECT_CALL(*mechAngle, getMechanicalAngle())
+      .WillRepeatedly(ReturnPointee(&angle));
+  EXPECT_CALL(*motor, setVoltage(_, _, _, _)).Times(testing::AnyNumber());
+  for (int k = 0; k < 20000; k++) {
+    float iq = param->getValue<float>(ID::MotorCtl_General_TargetCurrentQ_RT);
+    us += kPeriodUs;
+    velocity += 6000.0f * iq * Ts;
+    angle += velocity * 6.0f * Ts;
+    motorCtl->loop();
+  }
+  EXPECT_NEAR(angle, 90.0f, 0.5f);
+  EXPECT_NEAR(velocity, 0.0f, 1.0f);
+
+  EXPECT_CALL(*motor, disable()).Times(1);
+  motorCtl->stop();
+}
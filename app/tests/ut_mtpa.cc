@@ -0,0 +1,75 @@
+/**
+ * @file ut_mtpa.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-26
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/mtpa.h"
+
+namespace {
+using coriander::motorctl::Mtpa;
+
+const float Ld = 0.2e-3f, Lq = 0.5e-3f, flux = 8e-3f;
+
+static float torque(float id, float iq) {
+  return flux * iq + (Ld - Lq) * id * iq;
+}
+
+// smallest |Is| producing the torque, brute force over the current angle
+static float minCurrent(float t) {
+  float best = 1e9f;
+  for (float angle = 0; angle < M_PI / 2; angle += 1e-4f) {
+    float unit = torque(-std::sin(angle), std::cos(angle));
+    // torque(s*id, s*iq) = s*a + s^2*b, solve for s
+    float a = flux * std::cos(angle);
+    float b = unit - a;
+    float s = b == 0 ? t / a : (-a + std::sqrt(a * a + 4 * b * t)) / (2 * b);
+    best = std::min(best, s);
+  }
+  return best;
+}
+}  // namespace
+
+TEST(Mtpa, noSaliency) {
+  Mtpa mtpa;
+  float id, iq;
+  mtpa.setup(0.3e-3f, 0.3e-3f, flux, 20.0f);
+  EXPECT_FALSE(mtpa.enabled());
+  mtpa(5.0f, &id, &iq);
+  EXPECT_EQ(id, 0.0f);
+  EXPECT_EQ(iq, 5.0f);
+}
+
+TEST(Mtpa, split) {
+  Mtpa mtpa;
+  float id, iq;
+  mtpa.setup(Ld, Lq, flux, 40.0f);
+  ASSERT_TRUE(mtpa.enabled());
+
+  for (float demand = 0.5f; demand < 40.0f; demand += 0.5f) {
+    mtpa(demand, &id, &iq);
+    float t = flux * demand;
+    float is = std::sqrt(id * id + iq * iq);
+    EXPECT_LE(id, 0.0f);
+    // same torque, table interpolation error only
+    EXPECT_NEAR(torque(id, iq), t, t * 5e-3f) << "demand: " << demand;
+    // less current than Id = 0, close to the optimum
+    EXPECT_LT(is, demand) << "demand: " << demand;
+    EXPECT_NEAR(is, minCurrent(t), minCurrent(t) * 5e-3f)
+        << "demand: " << demand;
+  }
+
+  // negative torque mirrors Iq
+  float id2, iq2;
+  mtpa(10.0f, &id, &iq);
+  mtpa(-10.0f, &id2, &iq2);
+  EXPECT_EQ(id2, id);
+  EXPECT_EQ(iq2, -iq);
+}
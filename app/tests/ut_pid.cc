@@ -0,0 +1,35 @@
+/**
+ * @file ut_pid.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-19
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "coriander/motorctl/pid.h"
+
+using coriander::motorctl::Pid;
+
+TEST(Pid, backCalculate) {
+  const float Ts = 1e-3f;
+  Pid windup{1.0f, 100.0f, 0.0f, 0.0f, 10.0f};
+  Pid pid{1.0f, 100.0f, 0.0f, 0.0f, 10.0f};
+
+  // outer limiter only allows 1.0 for a while
+  for (int i = 0; i < 100; i++) {
+    windup(2.0f, Ts);
+    float output = pid(2.0f, Ts);
+    if (output > 1.0f) {
+      pid.backCalculate(1.0f);
+    }
+  }
+
+  // error reverses, the integral of the fed back pid does not hold it
+  float a = windup(-0.5f, Ts);
+  float b = pid(-0.5f, Ts);
+  EXPECT_GT(a, 10.0f - 1.0f);
+  EXPECT_LT(b, 0.5f);
+}
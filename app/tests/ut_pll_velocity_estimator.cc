@@ -0,0 +1,165 @@
+/**
+ * @file ut_pll_velocity_estimator.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-28
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+
+#include "coriander/motorctl/pll_velocity_estimator.h"
+#include "coriander/motorctl/velocity_estimator.h"
+#include "coriander/parameters.h"
+#include "tests/mocks.h"
+
+namespace {
+struct DummyMechAngleEstimator
+    : public coriander::motorctl::IMechAngleEstimator {
+  virtual void enable() {}
+  virtual void disable() {}
+  virtual bool enabled() { return true; }
+  virtual void sync() {}
+  virtual bool needSync(uint32_t syncId) { return false; }
+  virtual bool needCalibrate() { return false; }
+  virtual void calibrate() {}
+  virtual float getMechanicalAngle() noexcept { return mMechAngle; }
+
+  float mMechAngle = 0.0f;
+};
+
+struct DummySystick : public coriander::os::ISystick {
+  virtual uint32_t systick_ms() { return us / 1000; }
+  virtual uint32_t systick_us() { return us; }
+  uint32_t us = 0;
+};
+
+using Property = coriander::base::Property;
+using ParamId = coriander::base::ParamId;
+using Parameter = testing::mock::MockPersistentParameter;
+using coriander::motorctl::PllVelocityEstimator;
+using coriander::motorctl::VelocityEstimator;
+
+constexpr uint32_t kTickUs = 50;         // 20kHz current loop
+constexpr uint32_t kReadUs = 2000;       // 500Hz velocity loop
+constexpr float kCount = 360.0f / 4096;  // encoder resolution, degree
+
+struct Result {
+  float pllRms;
+  float windowRms;
+  float pllPositionMax;
+};
+
+/**
+ * @brief drive both estimators with a quantized encoder following profile
+ *
+ * @param profile true velocity(RPM) at time t(s)
+ * @param settle errors are collected after it(s)
+ */
+Result simulate(std::function<float(float)> profile, float duration,
+                float settle) {
+  auto angleEstimator = std::make_shared<DummyMechAngleEstimator>();
+  auto systick = std::make_shared<DummySystick>();
+  auto param = std::make_shared<Parameter>();
+  auto paramReqValidator =
+      std::make_shared<testing::mock::MockParamReqValidator>();
+
+  param->add(Property{16, ParamId::MotorCtl_SpeedEstimator_WindowSize});
+  param->add(Property{1000, ParamId::MotorCtl_SpeedEstimator_MinDuration});
+  param->add(Property{10, ParamId::MotorCtl_SpeedEstimator_SampleInterval});
+  param->add(Property{300.0f, ParamId::MotorCtl_SpeedEstimator_PllBandwidth});
+
+  PllVelocityEstimator pll{angleEstimator, param, systick, paramReqValidator};
+  VelocityEstimator window{angleEstimator, param, systick, paramReqValidator};
+
+  double angle = 0.0;
+  double pllSum = 0.0, windowSum = 0.0;
+  float positionMax = 0.0f;
+  int n = 0;
+
+  systick->us = 1000;
+  pll.enable();
+  window.enable();
+  for (uint32_t t = kTickUs; t < duration * 1e6f; t += kTickUs) {
+    float velocity = profile(t * 1e-6f);
+    angle += velocity * 6.0 * kTickUs * 1e-6;
+    systick->us = 1000 + t;
+    angleEstimator->mMechAngle =
+        static_cast<float>(std::floor(angle / kCount) * kCount);
+
+    pll.sync();
+    window.sync();
+
+    if (t % kReadUs == 0 && t * 1e-6f >= settle) {
+      float pllErr = pll.getVelocity() - velocity;
+      float windowErr = window.getVelocity() - velocity;
+      pllSum += pllErr * pllErr;
+      windowSum += windowErr * windowErr;
+      float positionErr = pll.getPosition() - static_cast<float>(angle);
+      positionMax = std::max(positionMax, std::fabs(positionErr));
+      n++;
+    }
+  }
+
+  return {static_cast<float>(std::sqrt(pllSum / n)),
+          static_cast<float>(std::sqrt(windowSum / n)), positionMax};
+}
+}  // namespace
+
+TEST(ISensor, PllVelocityEstimatorConstant) {
+  auto result = simulate([](float) { return 600.0f; }, 1.0f, 0.2f);
+
+  // quantization noise only, both are close
+  EXPECT_LT(result.pllRms, 1.0f);
+  EXPECT_LT(result.windowRms, 1.0f);
+  EXPECT_LT(result.pllPositionMax, 2 * kCount);
+}
+
+TEST(ISensor, PllVelocityEstimatorRamp) {
+  // 0 -> 1000RPM at 5000RPM/s, a 100Hz speed ripple on top
+  auto result = simulate(
+      [](float t) {
+        return std::min(t, 0.2f) * 5000.0f +
+               20.0f * std::sin(2.0f * static_cast<float>(M_PI) * 100.0f * t);
+      },
+      0.4f, 0.05f);
+
+  // the window lags 75ms and averages the ripple away, the loop lags
+  // 2 * a / bandwidth = 33RPM and follows the ripple
+  EXPECT_LT(result.pllRms, result.windowRms / 4);
+  EXPECT_LT(result.pllRms, 40.0f);
+  EXPECT_LT(result.pllPositionMax, 1.0f);
+}
+
+TEST(ISensor, PllVelocityEstimatorStall) {
+  auto angleEstimator = std::make_shared<DummyMechAngleEstimator>();
+  auto systick = std::make_shared<DummySystick>();
+  auto param = std::make_shared<Parameter>();
+  auto paramReqValidator =
+      std::make_shared<testing::mock::MockParamReqValidator>();
+  param->add(Property{300.0f, ParamId::MotorCtl_SpeedEstimator_PllBandwidth});
+
+  PllVelocityEstimator pll{angleEstimator, param, systick, paramReqValidator};
+  pll.enable();
+  ASSERT_NEAR(pll.getVelocity(), 0.0f, 1e-6);
+
+  // same timestamp, no update
+  angleEstimator->mMechAngle = 10.0f;
+  pll.sync();
+  ASSERT_NEAR(pll.getVelocity(), 0.0f, 1e-6);
+  ASSERT_NEAR(pll.getPosition(), 0.0f, 1e-6);
+
+  // a 100ms gap re-locks on the measurement
+  systick->us += 100000;
+  pll.sync();
+  ASSERT_NEAR(pll.getPosition(), 10.0f, 1e-6);
+  ASSERT_NEAR(pll.getVelocity(), (10.0f / 360) / (0.1f / 60), 1e-3);
+
+  pll.disable();
+  ASSERT_NEAR(pll.getVelocity(), 0.0f, 1e-6);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file ut_sin_table.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-17
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/base/math.h"
+#include "coriander/base/sin_table.h"
+
+namespace {
+using coriander::base::sincos_table;
+
+// table is generated at compile time
+static_assert(coriander::base::detail::kSinTable<256>.v[0] == 0.0f);
+static_assert(coriander::base::detail::kSinTable<256>.v[64] == 1.0f);
+static_assert(coriander::base::detail::kSinTable<256>.v[192] == -1.0f);
+
+template <std::size_t N>
+static double max_error() {
+  double err = 0;
+  for (float deg = -720.0f; deg < 720.0f; deg += 0.1f) {
+    float s, c;
+    double rad = deg / 180.0 * M_PI;
+    sincos_table<N>(deg, &s, &c);
+    err = std::max(err, std::fabs(s - std::sin(rad)));
+    err = std::max(err, std::fabs(c - std::cos(rad)));
+  }
+  return err;
+}
+}  // namespace
+
+TEST(SinTable, accuracy) {
+  // 4.93 / N^2 plus float rounding
+  EXPECT_LT(max_error<256>(), 8e-5);
+  EXPECT_LT(max_error<512>(), 2.1e-5);
+  EXPECT_LT(max_error<1024>(), 6e-6);
+}
+
+TEST(SinTable, keyPoint) {
+  for (float deg : {0.0f, 90.0f, 180.0f, 270.0f, 360.0f, -90.0f, 450.0f}) {
+    float s, c;
+    double rad = deg / 180.0 * M_PI;
+    sincos_table<512>(deg, &s, &c);
+    EXPECT_NEAR(s, std::sin(rad), 1e-6) << "deg: " << deg;
+    EXPECT_NEAR(c, std::cos(rad), 1e-6) << "deg: " << deg;
+  }
+}
+
+TEST(SinTable, defaultProvider) {
+  for (float deg = 0.0f; deg < 360.0f; deg += 1.3f) {
+    float s, c;
+    double rad = deg / 180.0 * M_PI;
+    coriander::base::math::sincosd(deg, &s, &c);
+    EXPECT_NEAR(s, std::sin(rad), 2.1e-5) << "deg: " << deg;
+    EXPECT_NEAR(c, std::cos(rad), 2.1e-5) << "deg: " << deg;
+  }
+}
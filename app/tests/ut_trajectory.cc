@@ -0,0 +1,121 @@
+/**
+ * @file ut_trajectory.cc
+ * @author Savent Gate (savent_gate@outlook.com)
+ * @brief
+ * @date 2023-09-23
+ *
+ * Copyright 2023 savent_gate
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "coriander/motorctl/trajectory.h"
+
+namespace {
+using coriander::motorctl::Trajectory;
+
+struct Profile {
+  int steps;        //!< steps until done
+  float overshoot;  //!< past the target, in the direction of the move
+  float velocity;   //!< peak |velocity|
+  float acceleration;
+  float jerk;
+};
+
+static Profile run(Trajectory* t, float target, float Ts) {
+  Profile p{-1, 0, 0, 0, 0};
+  float direction = target < t->getPosition() ? -1.0f : 1.0f;
+  float a = t->getAcceleration();
+
+  for (int i = 0; i < 100000 && p.steps < 0; i++) {
+    (*t)(target, Ts);
+    p.overshoot =
+        std::max(p.overshoot, (t->getPosition() - target) * direction);
+    p.velocity = std::max(p.velocity, std::fabs(t->getVelocity()));
+    p.acceleration = std::max(p.acceleration, std::fabs(t->getAcceleration()));
+    p.jerk = std::max(p.jerk, std::fabs(t->getAcceleration() - a) / Ts);
+    a = t->getAcceleration();
+    if (t->done()) {
+      p.steps = i + 1;
+    }
+  }
+  return p;
+}
+}  // namespace
+
+TEST(Trajectory, trapezoidal) {
+  const float Ts = 1e-3f;
+  Trajectory t;
+  t.setLimits(1000.0f, 10000.0f, 0.0f);
+
+  for (float target : {3600.0f, -720.0f, 10.0f, 0.5f}) {
+    t.reset(0.0f);
+    Profile p = run(&t, target, Ts);
+    ASSERT_GT(p.steps, 0) << "target: " << target;
+    EXPECT_FLOAT_EQ(t.getPosition(), target);
+    // float rounding of the last steps only
+    EXPECT_LE(p.overshoot, 1e-6f * std::fabs(target)) << "target: " << target;
+    EXPECT_LE(p.velocity, 1000.0f * 1.0001f);
+    EXPECT_LE(p.acceleration, 10000.0f * 1.0001f);
+  }
+
+  // 3600 at 1000/s with 0.1s ramps: 3.7s, a few steps of discretization
+  t.reset(0.0f);
+  EXPECT_NEAR(run(&t, 3600.0f, Ts).steps, 3700, 5);
+}
+
+TEST(Trajectory, scurve) {
+  const float Ts = 1e-3f;
+  Trajectory t;
+  t.setLimits(1000.0f, 10000.0f, 200000.0f);
+
+  for (float target : {3600.0f, -720.0f, 10.0f, 0.5f}) {
+    t.reset(0.0f);
+    Profile p = run(&t, target, Ts);
+    ASSERT_GT(p.steps, 0) << "target: " << target;
+    EXPECT_FLOAT_EQ(t.getPosition(), target);
+    // float rounding of the last steps only
+    EXPECT_LE(p.overshoot, 1e-6f * std::fabs(target)) << "target: " << target;
+    EXPECT_LE(p.velocity, 1000.0f * 1.0001f);
+    EXPECT_LE(p.acceleration, 10000.0f * 1.0001f);
+    EXPECT_LE(p.jerk, 200000.0f * 1.0001f) << "target: " << target;
+  }
+
+  // trapezoid plus one jerk phase of A/J = 50ms
+  t.reset(0.0f);
+  EXPECT_NEAR(run(&t, 3600.0f, Ts).steps, 3750, 10);
+}
+
+TEST(Trajectory, retarget) {
+  const float Ts = 1e-3f;
+  Trajectory t;
+  t.setLimits(1000.0f, 10000.0f, 200000.0f);
+  t.reset(0.0f);
+
+  // cruising forward, then the target jumps behind
+  for (int i = 0; i < 500; i++) {
+    t(3600.0f, Ts);
+  }
+  ASSERT_NEAR(t.getVelocity(), 1000.0f, 1e-2);
+
+  float v = t.getVelocity(), a = t.getAcceleration();
+  for (int i = 0; i < 100000 && !t.done(); i++) {
+    t(0.0f, Ts);
+    EXPECT_LE(std::fabs(t.getVelocity() - v), 10000.0f * Ts * 1.0001f);
+    EXPECT_LE(std::fabs(t.getAcceleration() - a), 200000.0f * Ts * 1.0001f);
+    v = t.getVelocity();
+    a = t.getAcceleration();
+  }
+  EXPECT_TRUE(t.done());
+  EXPECT_FLOAT_EQ(t.getPosition(), 0.0f);
+}
+
+TEST(Trajectory, disabled) {
+  Trajectory t;
+  t.reset(5.0f);
+  t(100.0f, 1e-3f);
+  EXPECT_EQ(t.getPosition(), 5.0f);
+  EXPECT_EQ(t.getVelocity(), 0.0f);
+}